@@ -9,16 +9,35 @@
 
 // Bibliotecas do pico SDK de hardware
 #include "hardware/i2c.h"
+#include "hardware/uart.h"
 #include "hardware/pio.h"
 #include "hardware/adc.h"
 #include "hardware/pwm.h"
 #include "hardware/timer.h"
 #include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "pico/multicore.h"
+#include "pico/stdio_usb.h"
 
 #include "inc/ssd1306.h" // Header para controle do display OLED
 #include "inc/font.h"    // Header com as fontes para o display
+#include "inc/ui.h"      // Header com os widgets retidos da tela
+#include "inc/sampler.h" // Header da amostragem contínua do ADC por DMA
+#include "inc/filter.h"  // Header dos filtros das leituras do ADC
+#include "inc/calib.h"   // Header das curvas de calibração dos eixos
+#include "inc/calibrator.h" // Header da máquina de estados da calibração
+#include "inc/sched.h"   // Header do escalonador de tarefas periódicas
+#include "inc/seqlock.h" // Header da publicação do estado do sistema e do estado mostrado
+#include "inc/input.h"   // Header dos eventos dos botões
+#include "inc/buzzer.h"  // Header do sequenciador dos buzzers
+#include "inc/actuator.h" // Header do controle do ventilador e do umidificador
+#include "inc/prof.h"    // Header da medição de tempo dos estágios do laço
+#include "inc/trace.h"   // Header do registro binário de eventos
+#include "inc/telemetry.h" // Header da telemetria binária
+#include "inc/usb_cdc.h"  // Header da escrita na USB sem esperar o computador
 
 #include "ws2812.pio.h"  // Header para controle dos LEDs WS2812
+#include "sprites.h"     // Header gerado com os desenhos do display (sprites.txt)
 
 // ---------------- Bibliotecas - Fim ----------------
 
@@ -26,6 +45,21 @@
 
 // ---------------- Definições - Início ----------------
 
+// Com DUAL_CORE = 1 (opção DUAL_CORE do CMake) o núcleo 1 cuida do display e da matriz de LEDs
+// e o núcleo 0 fica só com a amostragem e o controle
+#ifndef DUAL_CORE
+#define DUAL_CORE 0
+#endif
+
+// Telemetria: TELEMETRY_UART = 1 envia pela UART em vez da USB e TELEMETRY_PERIOD_MS define o ritmo
+// dos quadros (opções de mesmo nome no CMake)
+#ifndef TELEMETRY_UART
+#define TELEMETRY_UART 0
+#endif
+#ifndef TELEMETRY_PERIOD_MS
+#define TELEMETRY_PERIOD_MS 1000
+#endif
+
 // Configurações do I2C para comunicação com o display OLED
 #define I2C_PORT i2c1 // Porta I2C
 #define I2C_SDA 14    // Pino de dados
@@ -35,33 +69,121 @@
 // Definições da matriz de LEDs
 #define LED_COUNT 25  // Número total de LEDs na matriz
 #define MATRIX_PIN 7  // Pino da matriz de LEDs
-struct pixel_t {   // Estrutura para armazenar as cores de um LED WS2812
-  uint8_t G, R, B; // Componentes de cor (verde, vermelho e azul)
-};
-typedef struct pixel_t pixel_t;
-typedef pixel_t npLED_t;
-npLED_t leds[LED_COUNT];
+#define NP_FRAME_US (LED_COUNT * 24 * 5 / 4 + 100 + 10) // Duração de um quadro: 1,25 us por bit + 100 us de reset (com folga)
+// Cada LED é uma palavra de 24 bits G | R << 8 | B << 16, enviada bit a bit do menos significativo pelo PIO
+#define NP_GRB(r, g, b) ((uint32_t)(g) | ((uint32_t)(r) << 8) | ((uint32_t)(b) << 16))
+static volatile bool np_busy = false; // Indica que um quadro ainda está sendo enviado ou no tempo de reset
+static int np_dma_chan;              // Canal de DMA que alimenta a FIFO do PIO
 PIO np_pio; // Instância do PIO
 uint sm;    // State machine para controle dos LEDs
 
+// Cores usadas nos desenhos da matriz
+#define NP_OFF NP_GRB(0, 0, 0)
+#define NP_RED NP_GRB(1, 0, 0)
+#define NP_GRN NP_GRB(0, 1, 0)
+#define NP_BLU NP_GRB(0, 0, 1)
+#define NP_YEL NP_GRB(1, 1, 0)
+
+// A matriz é ligada em zigue-zague a partir do canto inferior direito: as linhas são escritas
+// de baixo para cima, alternando a ordem das colunas
+#define NP_ROW_FWD(a, b, c, d, e) a, b, c, d, e
+#define NP_ROW_REV(a, b, c, d, e) e, d, c, b, a
+// Monta um quadro a partir das 5 linhas na ordem em que aparecem na matriz (de cima para baixo)
+#define NP_FRAME(r0, r1, r2, r3, r4) { NP_ROW_REV r4, NP_ROW_FWD r3, NP_ROW_REV r2, NP_ROW_FWD r1, NP_ROW_REV r0 }
+
+// Desenhos da matriz de LEDs
+typedef enum {
+    FRAME_CLEAR,       // Matriz apagada
+    FRAME_LOW_WATER,   // Umidificador com pouca água
+    FRAME_TEMPERATURE, // Tela de configuração das temperaturas
+    FRAME_HUMIDITY,    // Tela de configuração da umidade
+    FRAME_CALIBRATION, // Tela de calibração do joystick
+    FRAME_UP,          // Setas e meio usados durante a calibração
+    FRAME_DOWN,
+    FRAME_LEFT,
+    FRAME_RIGHT,
+    FRAME_MIDDLE,
+    FRAME_COUNT
+} np_frame_t;
+
 //  Configurações do PWM para os LEDs
 #define WRAP_VALUE 4095 // Valor do WRAP
 #define DIV_VALUE 1.0   // Valor do divisor de clock
 #define RED_LED 13      // Pino do LED vermelho
 #define BLUE_LED 12     // Pino do LED azul
+#define LED_RAMP_PER_MS 8 // Rampa dos LEDs: do apagado ao máximo em cerca de 0,5 s
+
+// Controle do ventilador (LED vermelho) e do umidificador (LED azul)
+#define FAN_HYSTERESIS 1          // °C abaixo do limite para o ventilador descer de nível
+#define FAN_MIN_DWELL_MS 2000     // Tempo mínimo do ventilador em cada nível
+#define HUMIDIFIER_HYSTERESIS 2   // % acima do limite para o umidificador desligar
+#define HUMIDIFIER_MIN_DWELL_MS 5000 // Tempo mínimo do umidificador ligado ou desligado
 
 // Configuração do joystick
 #define JSK_SEL 22 // Pino do botão do joystick
 #define JSK_Y 26   // Pino do eixo Y do joystick
 #define JSK_X 27   // Pino do eixo X do joystick
+#define ADC_Y 0    // Entrada do ADC do eixo Y (GPIO 26)
+#define ADC_X 1    // Entrada do ADC do eixo X (GPIO 27)
+
+// Configuração da amostragem do ADC
+#define SAMPLE_RATE_HZ 8000 // Conversões por segundo, divididas entre os dois eixos
+
+// Faixas simuladas pelos eixos do joystick
+#define TEMP_MIN -15    // Temperatura com o eixo Y embaixo
+#define TEMP_MAX 50     // Temperatura com o eixo Y em cima
+#define HUMIDITY_MIN 0  // Umidade com o eixo X na esquerda
+#define HUMIDITY_MAX 100 // Umidade com o eixo X na direita
+
+// Configuração da calibração do joystick
+#define CAL_SETTLE_MS 2000  // Tempo para o usuário posicionar o joystick depois de cada aviso
+#define CAL_SAMPLES 300     // Amostras coletadas em cada posição
+#define CAL_INTERVAL_MS 10  // Intervalo entre as amostras
+#define CAL_MAX_STDDEV 40   // Desvio padrão (códigos do ADC) acima do qual o passo é repetido: joystick mexendo
+
+// Períodos e orçamentos das tarefas do laço principal (em us)
+#define SCHED_TICK_US 1000       // Tick do alarme que acorda o laço principal
+#define SAMPLE_PERIOD_US 1000    // Filtros dos eixos a 1 kHz
+#define SAMPLE_BUDGET_US 50
+#define CONTROL_PERIOD_US 10000  // Telas, controle e botões a 100 Hz
+#define CONTROL_BUDGET_US 2000
+#define DISPLAY_PERIOD_US 50000  // Envio do display a 20 Hz
+#define DISPLAY_BUDGET_US 1000
+#define RENDER_PERIOD_US 50000   // Renderização e envio do display no núcleo 1 (modo DUAL_CORE)
+#define CONSOLE_PERIOD_US 100000 // Comandos do perfil pela USB/UART (modo PROFILE)
+#define CONSOLE_BUDGET_US 5000
+#define TRACE_PERIOD_US 10000    // Envio do registro de eventos pela USB (modo TRACE)
+#define TRACE_BUDGET_US 500
+#define TELEMETRY_FLUSH_US 10000 // Montagem e envio dos quadros de telemetria
+#define TELEMETRY_BUDGET_US 500
 
 // Configuração dos botões
 #define BUTTON_A 5 // Pino do botão A
 #define BUTTON_B 6 // Pino do botão B
+#define DEBOUNCE_MS 50     // Debounce de cada botão
+#define LONG_PRESS_MS 1000 // Tempo segurando para um toque longo
+#define DOUBLE_PRESS_MS 400 // Janela do toque duplo
+
+// Estágios medidos pelo perfil (opção PROFILE do CMake); "render" inclui "matrix". Com DUAL_CORE,
+// "render", "flush" e "matrix" são medidos no núcleo 1 e aparecem na tabela dele
+enum {PROF_SAMPLE, PROF_SCALE, PROF_CONTROL, PROF_RENDER, PROF_FLUSH, PROF_MATRIX, PROF_BUZZER, PROF_STAGE_COUNT};
+
+// Telemetria (tools/telemetry_parse.py precisa da mesma lista de campos para cada versão)
+#define TELEMETRY_SCHEMA 1          // Versão da lista de campos abaixo
+#define TELEMETRY_KEYFRAME_EVERY 10 // Quadro completo a cada 10 períodos, mesmo sem mudanças
+enum {
+    TM_SCREEN, TM_TEMPERATURE, TM_HUMIDITY, TM_Y_RAW, TM_X_RAW, TM_FAN, TM_HUMIDIFIER, TM_LOW_WATER,
+    TM_FAN_LOW, TM_FAN_MEDIUM, TM_FAN_HIGH, TM_HUMIDIFIER_ON, TM_FIELD_COUNT,
+};
+
+// Telas
+#define SCREEN_COUNT 4 // Principal, temperaturas, umidade e calibração
 
 // Configuração dos buzzers
 #define BUZZER_A 21 // Pino do buzzer A
 #define BUZZER_B 10 // Pino do buzzer B
+#define BEEP_CONFIRM_MS 30 // Duração de cada nota do bip de confirmação
+#define BEEP_ALERT_MS 100  // Duração de cada nota do alerta de falta de água
 
 // ---------------- Definições - Fim ----------------
 
@@ -69,36 +191,152 @@ uint sm;    // State machine para controle dos LEDs
 
 // ---------------- Variáveis - Início ----------------
 
-// Variáveis para controle de interrupções
-static volatile uint32_t last_time = 0; // Armazena o último tempo registrado nas interrupções dos botões
-static volatile bool flag_b = false;    // Flag de controle para o botão B
-static volatile bool switch_b = true;   // Estado do botão B (Representa o sinal que está sendo recebido do sensor de nível do umidificador)
+// Botões: todos geram eventos por interrupção de borda (índices da tabela input_buttons)
+enum { INPUT_JSK, INPUT_A, INPUT_B };
+static const input_config_t input_buttons[] = {
+    [INPUT_JSK] = {JSK_SEL, DEBOUNCE_MS, LONG_PRESS_MS, DOUBLE_PRESS_MS},
+    [INPUT_A] = {BUTTON_A, DEBOUNCE_MS, LONG_PRESS_MS, DOUBLE_PRESS_MS},
+    [INPUT_B] = {BUTTON_B, DEBOUNCE_MS, LONG_PRESS_MS, DOUBLE_PRESS_MS},
+};
+// Buzzers: os sons alternam uma nota grave no buzzer A e uma aguda no buzzer B
+enum { BUZZER_LOW, BUZZER_HIGH };
+static const uint buzzer_pins[] = { [BUZZER_LOW] = BUZZER_A, [BUZZER_HIGH] = BUZZER_B };
+static const buzzer_step_t tone_confirm[] = { // Confirmação de um valor ou início/fim da calibração
+    {BUZZER_LOW, NOTE_C4, 128, BEEP_CONFIRM_MS}, {BUZZER_HIGH, NOTE_B4, 128, BEEP_CONFIRM_MS},
+    {BUZZER_LOW, NOTE_C4, 128, BEEP_CONFIRM_MS}, {BUZZER_HIGH, NOTE_B4, 128, BEEP_CONFIRM_MS},
+};
+static const buzzer_step_t tone_alert[] = { // Umidificador com pouca água ou passo da calibração repetido
+    {BUZZER_LOW, NOTE_C4, 128, BEEP_ALERT_MS}, {BUZZER_HIGH, NOTE_B4, 128, BEEP_ALERT_MS},
+    {BUZZER_LOW, NOTE_C4, 128, BEEP_ALERT_MS}, {BUZZER_HIGH, NOTE_B4, 128, BEEP_ALERT_MS},
+};
+
+// Toca um dos sons (o custo de enfileirar é medido no estágio "buzzer" do perfil)
+#define play_tone(tone) do { PROF_BEGIN(PROF_BUZZER); buzzer_play_pattern(tone); PROF_END(PROF_BUZZER); } while (0)
+
+static bool switch_b = true;   // Estado do botão B (Representa o sinal que está sendo recebido do sensor de nível do umidificador)
 
 // Variáveis para o display
-static volatile uint8_t screen_state = 0;            // Estado atual da tela
-static volatile char string1[] = "T:000C*\0";;       // String da temperatura
-static volatile char string2[] = "U:000%\0";         // String da umidade
-static volatile char string3[] = "fan:medium\0";     // String do ventilador
-static volatile char string4[] = "humidifier:off\0"; // String do umidificador
+static uint8_t screen_state = 0; // Estado atual da tela
+
+// Widgets do display (guardam o último valor desenhado para só redesenhar o que mudou)
+static ui_number_t ui_temperature = UI_NUMBER(6, 7, "T:", 3, "C*"); // Temperatura
+static ui_number_t ui_humidity = UI_NUMBER(6, 20, "U:", 3, "%");    // Umidade
+static ui_label_t ui_fan = UI_LABEL(6, 37);                        // Estado do ventilador
+static ui_label_t ui_humidifier = UI_LABEL(6, 50);                 // Estado do umidificador
+static ui_icon_t ui_face = UI_ICON(84, 6);                         // Rostinho
+
+// Textos fixos dos estados mostrados no display (indexados pelo nível do ventilador e pelo estado do umidificador)
+enum { FAN_OFF, FAN_LOW, FAN_MEDIUM, FAN_HIGH, FAN_BLANK };
+static const char *const fan_labels[] = {"fan:off   ", "fan:low   ", "fan:medium", "fan:high  ", "fan:      "};
+enum { HUMIDIFIER_OFF, HUMIDIFIER_ON, HUMIDIFIER_BLANK };
+static const char *const humidifier_labels[] = {"humidifier:off", "humidifier:on ", "humidifier:   "};
+
+// Estado mostrado no display e na matriz: montado pelo controle e desenhado pela renderização
+typedef struct {
+    int16_t temperature;   // Valor do campo "T:"
+    int16_t humidity;      // Valor do campo "U:"
+    bool show_temperature; // false apaga o número, mantendo o prefixo
+    bool show_humidity;
+    uint8_t fan;           // Índice em fan_labels
+    uint8_t humidifier;    // Índice em humidifier_labels
+    const sprite_t *face;  // Rostinho
+    np_frame_t frame;      // Desenho da matriz de LEDs
+} view_t;
+
+static view_t view = {0, 0, true, true, FAN_OFF, HUMIDIFIER_OFF, &face_happy, FRAME_CLEAR}; // Montado pelo controle
+// Controle -> renderização: só o instantâneo mais recente importa, então o controle (100 Hz) sobrescreve
+// o anterior e a renderização (20 Hz) lê o último publicado, sem fila para encher
+static view_t published_view;
+static seqlock_t view_lock = SEQLOCK_INIT;
+
+static ssd1306_t display; // Display OLED (do núcleo 1 depois da entrega pela FIFO, no modo DUAL_CORE)
+
+// Bordas e divisórias fixas do display, desenhadas uma única vez
+static const ui_frame_t ui_frames[] = {
+    {0, 0, 128, 64, false}, // Borda externa
+    {2, 2, 124, 60, false}, // Borda interna
+    {3, 63, 2, 28, true},   // divisória dupla vertical (x = 63 e 64)
+    {31, 3, 122, 2, true},  // divisória dupla horizontal (y = 31 e 32)
+};
 
 // Variáveis de controle do display
-static volatile int fan_low = 26;             // Limite para ativar a velocidade mínima do ventilador
-static volatile int fan_medium = 30;          // Limite para ativar a velocidade média do ventilador
-static volatile int fan_high = 34;            // Limite para ativar a velocidade máxima do ventilador
-static volatile int humidifier_on = 60;       // Limite para ativação do umidificador
-static volatile bool face_humidifier = false; // Flag do umidificador para controlar qual rosto deve aparecer no display
-static volatile bool face_fan = false;        // Flag do ventilador para controlar qual rosto deve aparecer no display
-static volatile bool change_screen = false;   // Flag para indicar se o desenho na matriz de LEDs deve ser alterada
+static int fan_low = 26;             // Limite para ativar a velocidade mínima do ventilador
+static int fan_medium = 30;          // Limite para ativar a velocidade média do ventilador
+static int fan_high = 34;            // Limite para ativar a velocidade máxima do ventilador
+static int humidifier_on = 60;       // Limite para ativação do umidificador
+
+// Atuadores: o nível do ventilador é o índice em fan_labels e o do umidificador em humidifier_labels
+static const actuator_config_t fan_config = {
+    RED_LED, 3, false, FAN_HYSTERESIS, FAN_MIN_DWELL_MS, FAN_MIN_DWELL_MS, LED_RAMP_PER_MS,
+    {0, 1365, 2730, 4095}, // Desligado e 1/3, 2/3 e 3/3 do wrap para baixa, média e alta
+};
+static const actuator_config_t humidifier_config = {
+    BLUE_LED, 1, true, HUMIDIFIER_HYSTERESIS, HUMIDIFIER_MIN_DWELL_MS, HUMIDIFIER_MIN_DWELL_MS, LED_RAMP_PER_MS,
+    {0, 1365}, // Liga quando a umidade cai até o limite
+};
+static actuator_t fan, humidifier;
+
+// Rostinho [ventilador no máximo][umidificador ligado]: feliz com os dois desligados, triste com os
+// dois ligados (muito quente e seco) e neutro nos outros casos
+static const sprite_t *const faces[2][2] = {
+    {&face_happy, &face_neutral},
+    {&face_neutral, &face_sad},
+};
 
 // Variáveis para o joystick
-static volatile uint16_t y_high=4095, y_low=0, y_middle_high=2047, y_middle_low=2047; // Limites do eixo Y (Calibração)
-static volatile uint16_t x_high=4095, x_low=0, x_middle_high=2047, x_middle_low=2047; // Limites do eixo X (Calibração)
-static volatile uint16_t x_value=2047, y_value=2047; // Valores capturados pelo joystick
-static volatile int x_scaled = 0, y_scaled = 0;      // Valores do joystick convertidos para valores de temperatura e umidade
+static uint16_t y_high=4095, y_low=0, y_middle_high=2047, y_middle_low=2047; // Limites do eixo Y (Calibração)
+static uint16_t x_high=4095, x_low=0, x_middle_high=2047, x_middle_low=2047; // Limites do eixo X (Calibração)
+static uint16_t x_value=2047, y_value=2047; // Valores capturados pelo joystick
+static int x_scaled = 0, y_scaled = 0;      // Valores do joystick convertidos para valores de temperatura e umidade
+static calib_t y_calib, x_calib;                     // Curvas de conversão recalculadas a cada calibração
+
+// Sequência da calibração: aviso na matriz, eixo lido, se guarda o menor ou o maior valor e onde guardar
+static const calibrator_step_t jsk_cal_steps[] = {
+    {FRAME_UP,     ADC_Y, CALIBRATOR_KEEP_MIN, &y_high},        // Menor valor com o joystick para cima
+    {FRAME_MIDDLE, ADC_Y, CALIBRATOR_KEEP_MAX, &y_middle_high}, // Maior valor no meio
+    {FRAME_DOWN,   ADC_Y, CALIBRATOR_KEEP_MAX, &y_low},         // Maior valor com o joystick para baixo
+    {FRAME_MIDDLE, ADC_Y, CALIBRATOR_KEEP_MIN, &y_middle_low},  // Menor valor no meio
+    {FRAME_RIGHT,  ADC_X, CALIBRATOR_KEEP_MIN, &x_high},        // Menor valor com o joystick para a direita
+    {FRAME_MIDDLE, ADC_X, CALIBRATOR_KEEP_MAX, &x_middle_high}, // Maior valor no meio
+    {FRAME_LEFT,   ADC_X, CALIBRATOR_KEEP_MAX, &x_low},         // Maior valor com o joystick para a esquerda
+    {FRAME_MIDDLE, ADC_X, CALIBRATOR_KEEP_MIN, &x_middle_low},  // Menor valor no meio
+};
+static calibrator_t jsk_calibrator; // Estado da calibração em andamento
+
+// Filtros dos eixos: média de 16 amostras (2 bits a mais), mediana de 3 leituras contra picos e EMA com alfa = 1/4
+static const filter_config_t jsk_filter = {2, 3, 2};
+static filter_t y_filter, x_filter;
 
 // Variáveis de contrle para as telas
-static volatile uint32_t t_last_time = 0; // Último tempo registrado para debouncing
-static volatile uint8_t contador = 0;     // Contador para alterar os limites de velocidade do ventilador
+static uint8_t contador = 0;     // Contador para alterar os limites de velocidade do ventilador
+
+// Estado do sistema publicado pelo controle a cada ciclo; outros contextos (núcleo 1, diagnóstico)
+// leem uma cópia consistente com state_read, sem travar o controle
+typedef struct {
+    uint8_t screen;             // Tela atual
+    int16_t temperature;        // Temperatura simulada (eixo Y convertido)
+    int16_t humidity;           // Umidade simulada (eixo X convertido)
+    uint16_t y_raw, x_raw;      // Leituras filtradas do ADC
+    uint8_t fan;                // Nível do ventilador (0 desligado, 1 a 3 velocidades)
+    uint8_t humidifier;         // Nível do umidificador (0 desligado, 1 ligado)
+    bool low_water;             // Aviso de pouca água ativo
+    int16_t fan_low, fan_medium, fan_high, humidifier_on; // Limites configurados
+} system_state_t;
+static system_state_t shared_state;
+static seqlock_t shared_state_lock = SEQLOCK_INIT;
+
+// Telemetria do estado publicado
+uint32_t telemetry_write(const uint8_t *data, uint32_t len);
+uint32_t telemetry_available(void);
+static const telemetry_config_t telemetry_config = {
+    TELEMETRY_SCHEMA, TM_FIELD_COUNT, TELEMETRY_PERIOD_MS, TELEMETRY_KEYFRAME_EVERY, telemetry_write,
+#if TELEMETRY_UART
+    NULL, // A UART é só da telemetria: o quadro pode sair aos pedaços
+#else
+    telemetry_available, // A USB também leva o registro de eventos: só quadros inteiros
+#endif
+};
+static telemetry_t telemetry;
 
 // ---------------- Variáveis - Fim ----------------
 
@@ -121,8 +359,9 @@ void init_display(ssd1306_t *ssd) {
     ssd1306_config(ssd);
     ssd1306_send_data(ssd);
     
-    // Limpa o display
+    // Limpa o display e desenha as bordas fixas
     ssd1306_fill(ssd, false);
+    ui_frames_draw(ssd, ui_frames, sizeof(ui_frames) / sizeof(ui_frames[0]));
     ssd1306_send_data(ssd);
 }
 
@@ -148,23 +387,8 @@ void init_rgb() {
 
 // Inicializa os buzzers com PWM
 void init_buzzers() {
-    uint slice;
-
-    // Configuração do Buzzer A
-    gpio_set_function(BUZZER_A, GPIO_FUNC_PWM);
-    slice = pwm_gpio_to_slice_num(BUZZER_A);
-    pwm_set_clkdiv(BUZZER_A, 125);
-    pwm_set_wrap(BUZZER_A, 3822);
-    pwm_set_gpio_level(BUZZER_A, 0);
-    pwm_set_enabled(slice, true);
-
-    // Configuração do Buzzer B
-    gpio_set_function(BUZZER_B, GPIO_FUNC_PWM);
-    slice = pwm_gpio_to_slice_num(BUZZER_B);
-    pwm_set_clkdiv(BUZZER_B, 125);
-    pwm_set_wrap(BUZZER_B, 2024);
-    pwm_set_gpio_level(BUZZER_B, 0);
-    pwm_set_enabled(slice, true);
+    // Cada buzzer em seu slice de PWM, desligado até a primeira sequência
+    buzzer_init(buzzer_pins, sizeof(buzzer_pins) / sizeof(buzzer_pins[0]));
 }
 
 // Inicializa o joystick
@@ -179,6 +403,11 @@ void init_joystick() {
     adc_init();
     adc_gpio_init(JSK_Y);
     adc_gpio_init(JSK_X);
+
+    // Os dois eixos passam a ser convertidos continuamente e copiados pela DMA, sem ocupar a CPU
+    sampler_init((1u << ADC_Y) | (1u << ADC_X), SAMPLE_RATE_HZ);
+    filter_init(&y_filter, &jsk_filter, ADC_Y);
+    filter_init(&x_filter, &jsk_filter, ADC_X);
 }
 
 // Inicializa os botões A e B
@@ -210,48 +439,34 @@ void npInit(uint pin) {
     // Inicializa a máquina de estado com o WS2812.pio
     ws2812_program_init(np_pio, sm, offset, pin, 800000.f);
 
-    // Limpa o buffer de pixels
-    for (uint i = 0; i < LED_COUNT; ++i) {
-        leds[i].R = 0;
-        leds[i].G = 0;
-        leds[i].B = 0;
-    }
-}
-
-// Atribui uma cor RGB a um LED específico na matriz
-void npSetLED(const uint index, const uint8_t r, const uint8_t g, const uint8_t b) {
-    leds[index].R = r;
-    leds[index].G = g;
-    leds[index].B = b;
+    // Configura a DMA para enviar uma palavra por LED para a FIFO de transmissão do PIO
+    np_dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(np_dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(np_pio, sm, true));
+    dma_channel_configure(np_dma_chan, &c, &np_pio->txf[sm], NULL, LED_COUNT, false);
 }
 
-// Limpa todos os LEDs na matriz
-void npClear() {
-    for (uint i = 0; i < LED_COUNT; ++i) {
-        npSetLED(i, 0, 0, 0);
-    }
+// Alarme que marca o fim do quadro enviado (transmissão + tempo de reset dos LEDs)
+int64_t np_latch_done(alarm_id_t id, void *user_data) {
+    np_busy = false;
+    return 0; // Não repete o alarme
 }
 
-// Escreve os dados do buffer para os LEDs
-void npWrite() {
-    // Escreve cada dado de 8 bits dos pixels em sequência no buffer da máquina PIO
-    for (uint i = 0; i < LED_COUNT; ++i) {
-        pio_sm_put_blocking(np_pio, sm, leds[i].G);
-        pio_sm_put_blocking(np_pio, sm, leds[i].R);
-        pio_sm_put_blocking(np_pio, sm, leds[i].B);
+// Envia um quadro de LED_COUNT palavras por DMA e retorna logo; o quadro precisa continuar válido durante o envio
+void npWrite(const uint32_t *frame) {
+    // Espera o quadro anterior terminar, incluindo o reset
+    while (np_busy) {
+        tight_loop_contents();
     }
-    sleep_us(100); // Espera 100us para o reset
-}
 
-// Função para facilitar o desenho na matriz utilizando 3 matrizes cos os valores RGB
-void npDraw(uint8_t vetorR[5][5], uint8_t vetorG[5][5], uint8_t vetorB[5][5]) {
-  int i, j,idx,col;
-    for (i = 0; i < 5; i++) {
-        idx = (4 - i) * 5; // Calcula o índice base para a linha
-        for (j = 0; j < 5; j++) {
-            col = (i % 2 == 0) ? (4 - j) : j; // Inverte a ordem das colunas nas linhas pares
-            npSetLED(idx + col, vetorR[i][j], vetorG[i][j], vetorB[i][j]); // Preenche o buffer com os valores das matrizes
-        }
+    np_busy = true;
+    dma_channel_transfer_from_buffer_now(np_dma_chan, frame, LED_COUNT);
+    if (add_alarm_in_us(NP_FRAME_US, np_latch_done, NULL, true) < 0) { // Libera o próximo envio depois do reset
+        busy_wait_us(NP_FRAME_US); // Sem alarme disponível: espera o quadro aqui mesmo
+        np_busy = false;
     }
 }
 
@@ -263,320 +478,92 @@ void npDraw(uint8_t vetorR[5][5], uint8_t vetorG[5][5], uint8_t vetorB[5][5]) {
 
 // ---------------- Desenhos - Início ----------------
 
-// -------- Display - Início --------
-
-// Função para desenhar uma cara feliz no display
-void draw_happy(ssd1306_t *ssd,uint8_t x0,uint8_t y0) {
-    uint8_t max_y = y0+22;
-    uint8_t max_x = x0+22;
-    uint8_t face[22][22] = { // Matriz que representa a cara feliz (1 = pixel aceso, 0 = pixel apagado)
-        {0,0,0,0,0,0,0,0,1,1,1,1,1,1,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,1,1,1,1,1,1,1,1,1,1,0,0,0,0,0,0},
-        {0,0,0,0,1,1,1,1,0,0,0,0,0,0,1,1,1,1,0,0,0,0},
-        {0,0,0,1,1,1,0,0,0,0,0,0,0,0,0,0,1,1,1,0,0,0},
-        {0,0,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,0,0},
-        {0,0,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,0,0},
-        {0,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,0},
-        {0,1,1,0,0,0,0,1,1,0,0,0,0,1,1,0,0,0,0,1,1,0},
-        {1,1,0,0,0,0,0,1,1,0,0,0,0,1,1,0,0,0,0,0,1,1},
-        {1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1},
-        {1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1},
-        {1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1},
-        {1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1},
-        {1,1,0,0,0,0,1,1,0,0,0,0,0,0,1,1,0,0,0,0,1,1},
-        {0,1,1,0,0,0,0,1,1,0,0,0,0,1,1,0,0,0,0,1,1,0},
-        {0,1,1,0,0,0,0,0,1,1,1,1,1,1,0,0,0,0,0,1,1,0},
-        {0,0,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,0,0},
-        {0,0,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,0,0},
-        {0,0,0,1,1,1,0,0,0,0,0,0,0,0,0,0,1,1,1,0,0,0},
-        {0,0,0,0,1,1,1,1,0,0,0,0,0,0,1,1,1,1,0,0,0,0},
-        {0,0,0,0,0,0,1,1,1,1,1,1,1,1,1,1,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,1,1,1,1,1,1,0,0,0,0,0,0,0,0}
-    };
-    for (uint8_t y = y0; y < max_y; y++) { // Percorre a matriz e desenha os pixels correspondentes no display
-        for (uint8_t x = x0; x < max_x; x++) {
-            ssd1306_pixel(ssd, x, y, face[y-y0][x-x0]);
-        }
-    }
-}
-
-// Função para desenhar uma cara neutra no display
-void draw_neutral(ssd1306_t *ssd,uint8_t x0,uint8_t y0) {
-    uint8_t max_y = y0+22;
-    uint8_t max_x = x0+22;
-    uint8_t face[22][22] = { // Matriz que representa a cara neutra (1 = pixel aceso, 0 = pixel apagado)
-        {0,0,0,0,0,0,0,0,1,1,1,1,1,1,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,1,1,1,1,1,1,1,1,1,1,0,0,0,0,0,0},
-        {0,0,0,0,1,1,1,1,0,0,0,0,0,0,1,1,1,1,0,0,0,0},
-        {0,0,0,1,1,1,0,0,0,0,0,0,0,0,0,0,1,1,1,0,0,0},
-        {0,0,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,0,0},
-        {0,0,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,0,0},
-        {0,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,0},
-        {0,1,1,0,0,0,0,1,1,0,0,0,0,1,1,0,0,0,0,1,1,0},
-        {1,1,0,0,0,0,0,1,1,0,0,0,0,1,1,0,0,0,0,0,1,1},
-        {1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1},
-        {1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1},
-        {1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1},
-        {1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1},
-        {1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1},
-        {0,1,1,0,0,0,0,0,1,1,1,1,1,1,0,0,0,0,0,1,1,0},
-        {0,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,0},
-        {0,0,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,0,0},
-        {0,0,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,0,0},
-        {0,0,0,1,1,1,0,0,0,0,0,0,0,0,0,0,1,1,1,0,0,0},
-        {0,0,0,0,1,1,1,1,0,0,0,0,0,0,1,1,1,1,0,0,0,0},
-        {0,0,0,0,0,0,1,1,1,1,1,1,1,1,1,1,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,1,1,1,1,1,1,0,0,0,0,0,0,0,0}
-    };
-    for (uint8_t y = y0; y < max_y; y++) { // Percorre a matriz e desenha os pixels correspondentes no display
-        for (uint8_t x = x0; x < max_x; x++) {
-            ssd1306_pixel(ssd, x, y, face[y-y0][x-x0]);
-        }
-    }
-}
-
-// Função para desenhar uma cara triste no display
-void draw_sad(ssd1306_t *ssd,uint8_t x0,uint8_t y0) {
-    uint8_t max_y = y0+22;
-    uint8_t max_x = x0+22;
-    uint8_t face[22][22] = { // Matriz que representa a face triste (1 = pixel aceso, 0 = pixel apagado)
-        {0,0,0,0,0,0,0,0,1,1,1,1,1,1,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,1,1,1,1,1,1,1,1,1,1,0,0,0,0,0,0},
-        {0,0,0,0,1,1,1,1,0,0,0,0,0,0,1,1,1,1,0,0,0,0},
-        {0,0,0,1,1,1,0,0,0,0,0,0,0,0,0,0,1,1,1,0,0,0},
-        {0,0,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,0,0},
-        {0,0,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,0,0},
-        {0,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,0},
-        {0,1,1,0,0,0,0,1,1,0,0,0,0,1,1,0,0,0,0,1,1,0},
-        {1,1,0,0,0,0,0,1,1,0,0,0,0,1,1,0,0,0,0,0,1,1},
-        {1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1},
-        {1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1},
-        {1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1},
-        {1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1},
-        {1,1,0,0,0,0,0,0,1,1,1,1,1,1,0,0,0,0,0,0,1,1},
-        {0,1,1,0,0,0,0,1,1,0,0,0,0,1,1,0,0,0,0,1,1,0},
-        {0,1,1,0,0,0,1,1,0,0,0,0,0,0,1,1,0,0,0,1,1,0},
-        {0,0,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,0,0},
-        {0,0,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,0,0},
-        {0,0,0,1,1,1,0,0,0,0,0,0,0,0,0,0,1,1,1,0,0,0},
-        {0,0,0,0,1,1,1,1,0,0,0,0,0,0,1,1,1,1,0,0,0,0},
-        {0,0,0,0,0,0,1,1,1,1,1,1,1,1,1,1,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,1,1,1,1,1,1,0,0,0,0,0,0,0,0}
-    };
-    for (uint8_t y = y0; y < max_y; y++) { // Percorre a matriz e desenha os pixels correspondentes no display
-        for (uint8_t x = x0; x < max_x; x++) {
-            ssd1306_pixel(ssd, x, y, face[y-y0][x-x0]);
-        }
-    }
-}
-
-// -------- Display - Fim --------
+// Os rostinhos do display ficam em sprites.txt e são gerados em tempo de compilação (sprites.h)
 
 // -------- Matriz - Início --------
 
-// Função para exibir na matriz de LEDs o símbolo indicando que a água do umidificador está acabando
-void humidifier_matrix() {
-    // Matrizes que representam os LEDs vermelhos, verdes e azuis
-    uint8_t vetorR[5][5] = {
-        {  1  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  1  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  1  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  1  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  1  }
-    };
-      uint8_t vetorG[5][5] = {
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  }
-    };
-    uint8_t vetorB[5][5] = {
-        {  0  ,  0  ,  1  ,  0  ,  0  },
-        {  0  ,  0  ,  1  ,  1  ,  0  },
-        {  1  ,  1  ,  0  ,  1  ,  1  },
-        {  1  ,  1  ,  1  ,  0  ,  1  },
-        {  0  ,  1  ,  1  ,  1  ,  0  }
-    };
-    npDraw(vetorR,vetorG,vetorB); // Carrega os buffers
-    npWrite();                    // Escreve na matriz de LEDs
-    npClear();                    // Limpa os buffers (não necessário, mas por garantia)
-}
-
-// Função para exibir o símbolo indicando a tela de mudança de temperaturas do ventilador na matriz de LEDs
-void temperature_screen() {
-    // Matrizes que representam os LEDs vermelhos, verdes e azuis
-    uint8_t vetorR[5][5] = {
-        {  1  ,  1  ,  1  ,  1  ,  1  },
-        {  1  ,  0  ,  1  ,  0  ,  1  },
-        {  0  ,  0  ,  1  ,  0  ,  0  },
-        {  0  ,  0  ,  1  ,  0  ,  0  },
-        {  0  ,  1  ,  1  ,  1  ,  0  }
-    };
-      uint8_t vetorGB[5][5] = {
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  }
-    };
-    npDraw(vetorR,vetorGB,vetorGB); // Carrega os buffers
-    npWrite();                      // Escreve na matriz de LEDs
-    npClear();                      // Limpa os buffers (não necessário, mas por garantia)
-}
-
-// Função para exibir o símbolo indicando a tela de mudança de umidade mínima do umidificador na matriz de LEDs
-void humidifier_screen() {
-    // Matrizes que representam os LEDs vermelhos, verdes e azuis
-    uint8_t vetorRG[5][5] = {
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  }
-    };
-      uint8_t vetorB[5][5] = {
-        {  1  ,  0  ,  0  ,  0  ,  1  },
-        {  1  ,  0  ,  0  ,  0  ,  1  },
-        {  1  ,  0  ,  0  ,  0  ,  1  },
-        {  1  ,  0  ,  0  ,  0  ,  1  },
-        {  1  ,  1  ,  1  ,  1  ,  1  }
-    };
-    npDraw(vetorRG,vetorRG,vetorB); // Carrega os buffers
-    npWrite();                      // Escreve na matriz de LEDs
-    npClear();                      // Limpa os buffers (não necessário, mas por garantia)
-}
-
-// Função para exibir o símbolo indicando a tela de calibração do joystick ("sensores") na matriz de LEDs
-void calibration_screen() {
-    // Matrizes que representam os LEDs vermelhos, verdes e azuis
-    uint8_t vetorB[5][5] = {
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  }
-    };
-      uint8_t vetorRG[5][5] = {
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  1  ,  1  ,  1  ,  0  },
-        {  0  ,  1  ,  0  ,  1  ,  0  },
-        {  0  ,  1  ,  1  ,  1  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  }
-    };
-    npDraw(vetorRG,vetorRG,vetorB); // Carrega os buffers
-    npWrite();                      // Escreve na matriz de LEDs
-    npClear();                      // Limpa os buffers (não necessário, mas por garantia)
-}
-
-// Função para exibir o símbolo de seta para cima na matriz de LEDs para a calibração
-void seta_cima() {
-    // Matrizes que representam os LEDs vermelhos, verdes e azuis
-    uint8_t vetorG[5][5] = {
-        {  0  ,  0  ,  1  ,  0  ,  0  },
-        {  0  ,  1  ,  1  ,  1  ,  0  },
-        {  1  ,  0  ,  1  ,  0  ,  1  },
-        {  0  ,  0  ,  1  ,  0  ,  0  },
-        {  0  ,  0  ,  1  ,  0  ,  0  }
-    };
-      uint8_t vetorRB[5][5] = {
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  }
-    };
-    npDraw(vetorRB,vetorG,vetorRB); // Carrega os buffers
-    npWrite();                      // Escreve na matriz de LEDs
-    npClear();                      // Limpa os buffers (não necessário, mas por garantia)
-}
-
-// Função para exibir o símbolo de seta para baixo na matriz de LEDs para a calibração
-void seta_baixo() {
-    // Matrizes que representam os LEDs vermelhos, verdes e azuis
-    uint8_t vetorG[5][5] = {
-        {  0  ,  0  ,  1  ,  0  ,  0  },
-        {  0  ,  0  ,  1  ,  0  ,  0  },
-        {  1  ,  0  ,  1  ,  0  ,  1  },
-        {  0  ,  1  ,  1  ,  1  ,  0  },
-        {  0  ,  0  ,  1  ,  0  ,  0  }
-    };
-      uint8_t vetorRB[5][5] = {
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  }
-    };
-    npDraw(vetorRB,vetorG,vetorRB); // Carrega os buffers
-    npWrite();                      // Escreve na matriz de LEDs
-    npClear();                      // Limpa os buffers (não necessário, mas por garantia)
-}
-
-// Função para exibir o símbolo de seta para a esquerda na matriz de LEDs para a calibração
-void seta_esquerda() {
-    // Matrizes que representam os LEDs vermelhos, verdes e azuis
-    uint8_t vetorG[5][5] = {
-        {  0  ,  0  ,  1  ,  0  ,  0  },
-        {  0  ,  1  ,  0  ,  0  ,  0  },
-        {  1  ,  1  ,  1  ,  1  ,  1  },
-        {  0  ,  1  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  1  ,  0  ,  0  }
-    };
-      uint8_t vetorRB[5][5] = {
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  }
-    };
-    npDraw(vetorRB,vetorG,vetorRB); // Carrega os buffers
-    npWrite();                      // Escreve na matriz de LEDs
-    npClear();                      // Limpa os buffers (não necessário, mas por garantia)
-}
-
-// Função para exibir o símbolo de seta para a direita na matriz de LEDs para a calibração
-void seta_direita() {
-    // Matrizes que representam os LEDs vermelhos, verdes e azuis
-    uint8_t vetorG[5][5] = {
-        {  0  ,  0  ,  1  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  1  ,  0  },
-        {  1  ,  1  ,  1  ,  1  ,  1  },
-        {  0  ,  0  ,  0  ,  1  ,  0  },
-        {  0  ,  0  ,  1  ,  0  ,  0  }
-    };
-      uint8_t vetorRB[5][5] = {
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  }
-    };
-    npDraw(vetorRB,vetorG,vetorRB); // Carrega os buffers
-    npWrite();                      // Escreve na matriz de LEDs
-    npClear();                      // Limpa os buffers (não necessário, mas por garantia)
-}
+// Quadros já em zigue-zague e com as cores empacotadas, montados em tempo de compilação e guardados na flash
+static const uint32_t np_frames[FRAME_COUNT][LED_COUNT] = {
+    [FRAME_CLEAR] = {0},
+    // Aviso de pouca água no umidificador
+    [FRAME_LOW_WATER] = NP_FRAME(
+        (NP_RED, NP_OFF, NP_BLU, NP_OFF, NP_OFF),
+        (NP_OFF, NP_RED, NP_BLU, NP_BLU, NP_OFF),
+        (NP_BLU, NP_BLU, NP_RED, NP_BLU, NP_BLU),
+        (NP_BLU, NP_BLU, NP_BLU, NP_RED, NP_BLU),
+        (NP_OFF, NP_BLU, NP_BLU, NP_BLU, NP_RED)
+    ),
+    // Tela de mudança das temperaturas do ventilador
+    [FRAME_TEMPERATURE] = NP_FRAME(
+        (NP_RED, NP_RED, NP_RED, NP_RED, NP_RED),
+        (NP_RED, NP_OFF, NP_RED, NP_OFF, NP_RED),
+        (NP_OFF, NP_OFF, NP_RED, NP_OFF, NP_OFF),
+        (NP_OFF, NP_OFF, NP_RED, NP_OFF, NP_OFF),
+        (NP_OFF, NP_RED, NP_RED, NP_RED, NP_OFF)
+    ),
+    // Tela de mudança da umidade mínima do umidificador
+    [FRAME_HUMIDITY] = NP_FRAME(
+        (NP_BLU, NP_OFF, NP_OFF, NP_OFF, NP_BLU),
+        (NP_BLU, NP_OFF, NP_OFF, NP_OFF, NP_BLU),
+        (NP_BLU, NP_OFF, NP_OFF, NP_OFF, NP_BLU),
+        (NP_BLU, NP_OFF, NP_OFF, NP_OFF, NP_BLU),
+        (NP_BLU, NP_BLU, NP_BLU, NP_BLU, NP_BLU)
+    ),
+    // Tela de calibração do joystick ("sensores")
+    [FRAME_CALIBRATION] = NP_FRAME(
+        (NP_OFF, NP_OFF, NP_OFF, NP_OFF, NP_OFF),
+        (NP_OFF, NP_YEL, NP_YEL, NP_YEL, NP_OFF),
+        (NP_OFF, NP_YEL, NP_OFF, NP_YEL, NP_OFF),
+        (NP_OFF, NP_YEL, NP_YEL, NP_YEL, NP_OFF),
+        (NP_OFF, NP_OFF, NP_OFF, NP_OFF, NP_OFF)
+    ),
+    // Seta para cima (calibração)
+    [FRAME_UP] = NP_FRAME(
+        (NP_OFF, NP_OFF, NP_GRN, NP_OFF, NP_OFF),
+        (NP_OFF, NP_GRN, NP_GRN, NP_GRN, NP_OFF),
+        (NP_GRN, NP_OFF, NP_GRN, NP_OFF, NP_GRN),
+        (NP_OFF, NP_OFF, NP_GRN, NP_OFF, NP_OFF),
+        (NP_OFF, NP_OFF, NP_GRN, NP_OFF, NP_OFF)
+    ),
+    // Seta para baixo (calibração)
+    [FRAME_DOWN] = NP_FRAME(
+        (NP_OFF, NP_OFF, NP_GRN, NP_OFF, NP_OFF),
+        (NP_OFF, NP_OFF, NP_GRN, NP_OFF, NP_OFF),
+        (NP_GRN, NP_OFF, NP_GRN, NP_OFF, NP_GRN),
+        (NP_OFF, NP_GRN, NP_GRN, NP_GRN, NP_OFF),
+        (NP_OFF, NP_OFF, NP_GRN, NP_OFF, NP_OFF)
+    ),
+    // Seta para a esquerda (calibração)
+    [FRAME_LEFT] = NP_FRAME(
+        (NP_OFF, NP_OFF, NP_GRN, NP_OFF, NP_OFF),
+        (NP_OFF, NP_GRN, NP_OFF, NP_OFF, NP_OFF),
+        (NP_GRN, NP_GRN, NP_GRN, NP_GRN, NP_GRN),
+        (NP_OFF, NP_GRN, NP_OFF, NP_OFF, NP_OFF),
+        (NP_OFF, NP_OFF, NP_GRN, NP_OFF, NP_OFF)
+    ),
+    // Seta para a direita (calibração)
+    [FRAME_RIGHT] = NP_FRAME(
+        (NP_OFF, NP_OFF, NP_GRN, NP_OFF, NP_OFF),
+        (NP_OFF, NP_OFF, NP_OFF, NP_GRN, NP_OFF),
+        (NP_GRN, NP_GRN, NP_GRN, NP_GRN, NP_GRN),
+        (NP_OFF, NP_OFF, NP_OFF, NP_GRN, NP_OFF),
+        (NP_OFF, NP_OFF, NP_GRN, NP_OFF, NP_OFF)
+    ),
+    // Joystick no meio (calibração)
+    [FRAME_MIDDLE] = NP_FRAME(
+        (NP_OFF, NP_OFF, NP_OFF, NP_OFF, NP_OFF),
+        (NP_OFF, NP_GRN, NP_GRN, NP_GRN, NP_OFF),
+        (NP_OFF, NP_GRN, NP_OFF, NP_GRN, NP_OFF),
+        (NP_OFF, NP_GRN, NP_GRN, NP_GRN, NP_OFF),
+        (NP_OFF, NP_OFF, NP_OFF, NP_OFF, NP_OFF)
+    ),
+};
 
-// Função para exibir o símbolo que representa o meio na matriz de LEDs para a calibração
-void meio() {
-    // Matrizes que representam os LEDs vermelhos, verdes e azuis
-    uint8_t vetorG[5][5] = {
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  1  ,  1  ,  1  ,  0  },
-        {  0  ,  1  ,  0  ,  1  ,  0  },
-        {  0  ,  1  ,  1  ,  1  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  }
-    };
-      uint8_t vetorRB[5][5] = {
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  },
-        {  0  ,  0  ,  0  ,  0  ,  0  }
-    };
-    npDraw(vetorRB,vetorG,vetorRB); // Carrega os buffers
-    npWrite();                      // Escreve na matriz de LEDs
-    npClear();                      // Limpa os buffers (não necessário, mas por garantia)
+// Exibe na matriz de LEDs um dos quadros prontos, enviando-o direto da flash
+void npShowFrame(np_frame_t frame) {
+    PROF_BEGIN(PROF_MATRIX);
+    npWrite(np_frames[frame]);
+    PROF_END(PROF_MATRIX);
 }
 
 // -------- Matriz - Fim --------
@@ -589,558 +576,568 @@ void meio() {
 
 // -------- Joystick - Início --------
 
-// Leitura do eixo y do joystick
-uint16_t read_y() {
-    adc_select_input(0);
-    return adc_read();
+// Recalcula as curvas de temperatura e umidade com os limites atuais da calibração (inclusive o centro)
+void update_calibration() {
+    calib_set(&y_calib, y_low, y_middle_low, y_middle_high, y_high, TEMP_MIN, TEMP_MAX);
+    calib_set(&x_calib, x_low, x_middle_low, x_middle_high, x_high, HUMIDITY_MIN, HUMIDITY_MAX);
 }
 
-// Leitura do eixo x do joystick
-uint16_t read_x() {
-    adc_select_input(1);
-    return adc_read();
+// Leitura filtrada do eixo y do joystick (última saída do filtro, atualizado pela tarefa de amostragem)
+uint16_t read_y() {
+    return filter_value(&y_filter);
 }
 
-// Leitura para converter escalas (Transformar os valores do joystick em valores de temperatura e umidade)
-int scale(int min1, int max1, int min2, int max2,int x1) {
-    return ( (((x1-min1)*(max2-min2))/(max1-min1))+min2 );
+// Leitura filtrada do eixo x do joystick (última saída do filtro, atualizado pela tarefa de amostragem)
+uint16_t read_x() {
+    return filter_value(&x_filter);
 }
 
-// Função para calibrar o eixo y do joystick
-void calibrate_jsk_y_values() {
-    uint16_t value, temp;
-    int i;
-    adc_select_input(0);
-
-    // Indica ao usuário através da matriz de LEDs para colocar o joystick para cima e espera 2 segundos
-    seta_cima();
-    sleep_ms(2000);
-
-    // Lê repetidamente o valor do eixo y e guarda o menor valor registrado no topo
-    value = 4095;
-    for(i=0;i<300;i++) {
-        temp = adc_read();
-        if(temp < value) {
-            value = temp;
-        }
-        sleep_ms(10);
-    }
-    y_high = value;
-
-    // Indica ao usuário através da matriz de LEDs para colocar o joystick para o meio e espera 2 segundos
-    meio();
-    sleep_ms(2000);
-
-    // Lê repetidamente o valor do eixo y e guarda o maior valor registrado no meio
-    value = 0;
-    for(i=0;i<300;i++) {
-        temp = adc_read();
-        if(temp > value) {
-            value = temp;
-        }
-        sleep_ms(10);
-    }
-    y_middle_high = value;
-
-    // Indica ao usuário através da matriz de LEDs para colocar o joystick para baixo e espera 2 segundos
-    seta_baixo();
-    sleep_ms(2000);
-
-    // Lê repetidamente o valor do eixo y e guarda o maior valor registrado na base
-    value = 0;
-    for(i=0;i<300;i++) {
-        temp = adc_read();
-        if(temp > value) {
-            value = temp;
-        }
-        sleep_ms(10);
-    }
-    y_low = value;
-
-    // Indica ao usuário através da matriz de LEDs para colocar o joystick para o meio e espera 2 segundos
-    meio();
-    sleep_ms(2000);
-
-    // Lê repetidamente o valor do eixo y e guarda o menor valor registrado no meio
-    value = 4095;
-    for(i=0;i<300;i++) {
-        temp = adc_read();
-        if(temp < value) {
-            value = temp;
-        }
-        sleep_ms(10);
-    }
-    y_middle_low = value;
-}
-
-// Função para calibrar o eixo x do joystick
-void calibrate_jsk_x_values() {
-    uint16_t value, temp;
-    int i;
-    adc_select_input(1);
-
-    // Indica ao usuário através da matriz de LEDs para colocar o joystick para a direita e espera 2 segundos
-    seta_direita();
-    sleep_ms(2000);
-
-    // Lê repetidamente o valor do eixo x e guarda o menor valor registrado na direita
-    value = 4095;
-    for(i=0;i<300;i++) {
-        temp = adc_read();
-        if(temp < value) {
-            value = temp;
-        }
-        sleep_ms(10);
-    }
-    x_high = value;
-
-    // Indica ao usuário através da matriz de LEDs para colocar o joystick para o meio e espera 2 segundos
-    meio();
-    sleep_ms(2000);
-
-    // Lê repetidamente o valor do eixo x e guarda o maior valor registrado no meio
-    value = 0;
-    for(i=0;i<300;i++) {
-        temp = adc_read();
-        if(temp > value) {
-            value = temp;
-        }
-        sleep_ms(10);
-    }
-    x_middle_high = value;
-
-    // Indica ao usuário através da matriz de LEDs para colocar o joystick para a esquerda e espera 2 segundos
-    seta_esquerda();
-    sleep_ms(2000);
-
-    // Lê repetidamente o valor do eixo x e guarda o maior valor registrado na esquerda
-    value = 0;
-    for(i=0;i<300;i++) {
-        temp = adc_read();
-        if(temp > value) {
-            value = temp;
-        }
-        sleep_ms(10);
-    }
-    x_low = value;
-
-    // Indica ao usuário através da matriz de LEDs para colocar o joystick para o meio e espera 2 segundos
-    meio();
-    sleep_ms(2000);
-
-    // Lê repetidamente o valor do eixo x e guarda o menor valor registrado no meio
-    value = 4095;
-    for(i=0;i<300;i++) {
-        temp = adc_read();
-        if(temp < value) {
-            value = temp;
-        }
-        sleep_ms(10);
-    }
-    x_middle_low = value;
+// Leitura filtrada de um dos eixos (usada pela calibração)
+uint16_t read_axis(uint8_t input) {
+    return input == ADC_Y ? read_y() : read_x();
 }
 
 // -------- Joystick - Fim --------
 
-// -------- Buzzers - Início --------
-
-// Emite um som alternando entre dois buzzers por um tempo determinado
-void beep(uint tempo) {
-    // Ativa o BUZZER A
-    pwm_set_gpio_level(BUZZER_A, 1911);
-    sleep_ms(tempo/4);
-
-    // Desativa o BUZZER A e ativa o BUZZER B
-    pwm_set_gpio_level(BUZZER_A, 0);
-    pwm_set_gpio_level(BUZZER_B, 1012);
-    sleep_ms(tempo/4);
-
-    // Ativa o BUZZER A e desativa o BUZZER B
-    pwm_set_gpio_level(BUZZER_B, 0);
-    pwm_set_gpio_level(BUZZER_A, 1911);
-    sleep_ms(tempo/4);
-
-    // Desativa o BUZZER A e ativa o BUZZER B
-    pwm_set_gpio_level(BUZZER_A, 0);
-    pwm_set_gpio_level(BUZZER_B, 1012);
-    sleep_ms(tempo/4);
-
-    // Desativa o BUZZER B
-    pwm_set_gpio_level(BUZZER_B, 0);
-}
-
-// -------- Buzzers - Fim --------
-
-// -------- Callback - Início --------
-
-// Callback para tratar as interrupções do botão do joystick e do botão B
-void gpio_irq_callback(uint gpio, uint32_t events) {
-    uint32_t current_time = to_ms_since_boot(get_absolute_time()); // Obtém o tempo atual em ms
-
-    // Debounce de 200 ms
-    if( (current_time - last_time) > 200 ) {
-        last_time = current_time;
-
-        if(gpio == JSK_SEL) { // Verifica se foi o botão do joystick
-            if(screen_state < 4) {
-                screen_state++;   // Avança para a próxima tela
-            }else {
-                screen_state = 0; // Retorna à primeira tela
-            }
-            change_screen = true;
-        }else
-        if(gpio == BUTTON_B) { // Verifica se foi o botão B
-            flag_b = true; // Simula o "sinal" do sensor de nível do umidificador, indicando que mudou
-        }
-
-    }
-}
-
-// -------- Callback - Fim --------
-
 // -------- Seleção de telas - Início --------
 
 // Função que representa a tela inicial, atualizando os valores de temperatura e umidade, estado do ventilador, do umidificador e do rostinho
-void tela_inicial(ssd1306_t *ssd) {
+void tela_inicial(view_t *v) {
 
     // Lê os valores analógicos do joystick
     y_value = read_y();
     x_value = read_x();
 
-    // Escala os valores do joystick para representar temperatura e umidade
-    y_scaled = scale(y_low,y_high,-15,50,y_value);
-    x_scaled = scale(x_low,x_high,0,100,x_value);
-
-    // Limita os valores escalados dentro dos intervalos desejados
-    if(y_scaled > 50) {
-        y_scaled = 50;
-    }else
-    if(y_scaled < -15) {
-        y_scaled = -15;
-    }
-    if(x_scaled > 100) {
-        x_scaled = 100;
-    }else
-    if(x_scaled < 0) {
-        x_scaled = 0;
-    }
-
-    // Atualiza as strings de temperatura e umidade com os valores lidos
-    sprintf((char *)&string1[2],"%3dC*\0",y_scaled); // Atualiza o final da string1 (temperatura) "000C°" com o valor convertido do eixo Y
-    sprintf((char *)&string2[2],"%3d%%\0",x_scaled); // Atualiza o final da string2 (umidade) "000%" com o valor convertido do eixo X
-
-    // Determina o estado do ventilador com base na temperatura
-    if(y_scaled < fan_low) { // Ventilador desligado
-        sprintf((char *)&string3[4],"off   \0"); // Atualiza a string3 (estado do ventilador) para mostrar "off   "
-        pwm_set_gpio_level(RED_LED, 0);          // Define o LED vermelho como desligado para representar o "off"
-        face_fan = true;                         // Flag para definir se o estado do rostinho
-    }else
-    if(y_scaled < fan_medium) { // Velocidade baixa
-        sprintf((char *)&string3[4],"low   \0"); // Atualiza a string3 (estado do ventilador) para mostrar "low   "
-        pwm_set_gpio_level(RED_LED, 1365);       // Define o LED vermelho com uma luz baixa (1/3 do wrap) para representar o "low"
-        face_fan = true;                         // Flag para definir se o estado do rostinho
-    }else
-    if(y_scaled < fan_high) { // Velocidade média
-        sprintf((char *)&string3[4],"medium\0"); // Atualiza a string3 (estado do ventilador) para mostrar "medium"
-        pwm_set_gpio_level(RED_LED, 2730);       // Define o LED vermelho com uma luz média (2/3 do wrap) para representar o "medium"
-        face_fan = true;                         // Flag para definir se o estado do rostinho
-    }else { // Velocidade alta
-        sprintf((char *)&string3[4],"high  \0"); // Atualiza a string3 (estado do ventilador) para mostrar "high  "
-        pwm_set_gpio_level(RED_LED, 4095);       // Define o LED vermelho com uma luz alta (3/3 do wrap) para representar o "high"
-        face_fan = false;                        // Flag para definir se o estado do rostinho
-    }
-
-    // Determina o estado do umidificador com base na umidade (eixo X)
-    if(x_scaled > humidifier_on) { // Umidificador desligado
-        sprintf((char *)&string4[11],"off\0"); // Atualiza a string4 (estado do umidificador) para mostrar "off"
-        face_humidifier = true;                // Flag para definir se o estado do rostinho
-        pwm_set_gpio_level(BLUE_LED, 0);       // Desliga o LED azul para representar o umidificador desligado
-    }else { // Umidificador ligado
-        sprintf((char *)&string4[11],"on \0"); // Atualiza a string4 (estado do umidificador) para mostrar "on "
-        face_humidifier = false;               // Flag para definir se o estado do rostinho
-        pwm_set_gpio_level(BLUE_LED, 1365);    // Liga o LED azul para representar o umidificador ligado
-    }
+    // Converte os valores do joystick em temperatura e umidade (já limitados às faixas)
+    PROF_BEGIN(PROF_SCALE);
+    y_scaled = calib_apply(&y_calib, y_value);
+    x_scaled = calib_apply(&x_calib, x_value);
+    PROF_END(PROF_SCALE);
+
+    // Atualiza os campos de temperatura e umidade
+    v->temperature = y_scaled; // "T:000C*" com o valor convertido do eixo Y
+    v->humidity = x_scaled;    // "U:000%" com o valor convertido do eixo X
+    v->show_temperature = true;
+    v->show_humidity = true;
+
+    // Determina os níveis do ventilador e do umidificador com histerese e tempo mínimo em cada nível
+    const int16_t fan_limits[] = {fan_low, fan_medium, fan_high};
+    const int16_t humidifier_limits[] = {humidifier_on};
+    uint32_t now = to_ms_since_boot(get_absolute_time());
+    v->fan = actuator_update(&fan, y_scaled, fan_limits, now);
+    v->humidifier = actuator_update(&humidifier, x_scaled, humidifier_limits, now);
 
     // Define a expressão do rostinho com base no estado do ventilador e do umidificador
-    if(face_fan && face_humidifier) {
-        draw_happy(ssd,84,6);   // Feliz se ambos estiverem desligados
-    }else
-    if(!face_fan && !face_humidifier) {
-        draw_sad(ssd,84,6);     // Triste se ambos estiverem ligados (Muito quente e seco)
-    }else {
-        draw_neutral(ssd,84,6); // Neutro caso um ligado e outro desligado (Muito quente ou seco)
-    }
-
-    // Manda para o buffer do display os elementos que devem ser desenhados
-    ssd1306_rect(ssd, 0, 0, 128, 64, true, false); // Borda externa
-    ssd1306_rect(ssd, 2, 2, 124, 60, true, false); // Borda interna
-    ssd1306_vline(ssd,63,3,30,true); // divisória dupla vertical (meio esquerda x = 63)
-    ssd1306_vline(ssd,64,3,30,true); // divisória dupla vertical (meio direta x = 64)
-    ssd1306_hline(ssd,3,124,31,true); // divisória dupla horizontal (meio cima y = 31)
-    ssd1306_hline(ssd,3,124,32,true); // divisória dupla horizontal (meio baixo y = 32)
-
-    // Manda para o buffer do display as strings que devem ser desenhadas
-    ssd1306_draw_string(ssd,(char *)string1,6,7);  // string da temperatura (string1)
-    ssd1306_draw_string(ssd,(char *)string2,6,20); // string da umidade (string2)
-    ssd1306_draw_string(ssd,(char *)string3,6,37); // string do estado do ventilador (string3)
-    ssd1306_draw_string(ssd,(char *)string4,6,50); // string do estado do umidificador (string4)
-
-    // Envia os dados do buffer para atualizar o display
-    ssd1306_send_data(ssd);
+    v->face = faces[v->fan == FAN_HIGH][v->humidifier == HUMIDIFIER_ON];
 }
 
 // Função que representa a tela de seleção das temperaturas limites
-void selecionar_temperatura(ssd1306_t *ssd) {
-    // Obtém o tempo atual em milissegundos para debouncing
-    uint32_t t_current_time = to_ms_since_boot(get_absolute_time());
-
+void selecionar_temperatura(view_t *v, bool confirm) {
     // Lê o valor analógico do joystick no eixo Y
     y_value = read_y();
 
-    // Escala o valor lido para representar a temperatura simulada
-    y_scaled = scale(y_low,y_high,-15,50,y_value);
-
-    // Garante que a temperatura fique dentro dos limites definidos
-    if(y_scaled > 50) {
-        y_scaled = 50;
-    }else
-    if(y_scaled < -15) {
-        y_scaled = -15;
-    }
+    // Converte o valor lido na temperatura simulada, já dentro dos limites definidos
+    PROF_BEGIN(PROF_SCALE);
+    y_scaled = calib_apply(&y_calib, y_value);
+    PROF_END(PROF_SCALE);
 
-    // Limpa os campos de umidade do buffer do display
-    sprintf((char *)&string2[2],"    \0");         // Atualiza o final da string2 (umidade) com "    \0"
-    sprintf((char *)&string4[11],"   \0");         // Atualiza o final da string4 (estado do umidificador) com "    \0"
-    ssd1306_draw_string(ssd,(char *)string2,6,20); // Atualiza o buffer do display da string2 (umidade)
-    ssd1306_draw_string(ssd,(char *)string4,6,50); // Atualiza o buffer do display da string4 (estado do umidificador)
+    // Limpa os campos de umidade do display (mantendo os prefixos "U:" e "humidifier:")
+    v->show_humidity = false;
+    v->humidifier = HUMIDIFIER_BLANK;
 
     // Desliga o LED azul, pois só o ventilador está sendo configurado
-    pwm_set_gpio_level(BLUE_LED, 0);
+    actuator_force(&humidifier, HUMIDIFIER_OFF);
 
-    
-    sprintf((char *)&string1[2],"%3dC*\0",y_scaled); // Atualiza o final da string1 (temperatura) "000C°" com o valor convertido do eixo Y
-    ssd1306_draw_string(ssd,(char *)string1,6,7);    // Manda para o buffer do display o valor lido de temperatura
+    v->temperature = y_scaled; // Mostra o valor lido de temperatura
+    v->show_temperature = true;
 
     // Define a velocidade do ventilador e a expressão facial para corresponder ao limite de temperatura que está sendo configurado
     switch(contador) {
         case 0: // Configuração da temperatura para velocidade baixa
-            pwm_set_gpio_level(RED_LED, 1365);
-            sprintf((char *)&string3[4],"low   \0");
-            draw_happy(ssd,84,6);
+            actuator_force(&fan, FAN_LOW);
+            v->fan = FAN_LOW;
+            v->face = &face_happy;
             break;
         case 1: // Configuração da temperatura para velocidade média
-            pwm_set_gpio_level(RED_LED, 2730);
-            sprintf((char *)&string3[4],"medium\0");
-            draw_happy(ssd,84,6);
+            actuator_force(&fan, FAN_MEDIUM);
+            v->fan = FAN_MEDIUM;
+            v->face = &face_happy;
             break;
         case 2: // Configuração da temperatura para velocidade alta
-            pwm_set_gpio_level(RED_LED, 4095);
-            sprintf((char *)&string3[4],"high  \0");
-            draw_sad(ssd,84,6);
+            actuator_force(&fan, FAN_HIGH);
+            v->fan = FAN_HIGH;
+            v->face = &face_sad;
             break;
         default:
             contador = 0; // Reinicia o contador em caso de bug
     }
 
-    // Manda para o buffer do display a string3 (estado do ventilador)
-    ssd1306_draw_string(ssd,(char *)string3,6,37);
-    
-    // Envia os dados do buffer para atualizar o display
-    ssd1306_send_data(ssd);
-
     // Verifica se o botão A foi pressionado
-    if( (t_current_time - t_last_time) > 200 ) {
-        if(!gpio_get(BUTTON_A)) {
-            t_last_time = t_current_time;
-
-             // Armazena a temperatura definida para cada nível do ventilador
-            switch(contador) {
-                case 0:
-                    fan_low = y_scaled; // Define a temperatura para o nível baixo
-                    contador++;
-                    beep(120);          // Emite um som de confirmação
-                    break;
-                case 1:
-                    fan_medium = y_scaled; // Define a temperatura para o nível médio
-                    contador++;
-                    beep(120);
-                    break;
-                case 2:
-                    fan_high = y_scaled; // Define a temperatura para o nível alto
-                    contador = 0;
-                    beep(120);
-                    break;
-                default:
-                    contador = 0; // Reinicia o contador em caso de bug
-            }
+    if(confirm) {
+        // Armazena a temperatura definida para cada nível do ventilador
+        switch(contador) {
+            case 0:
+                fan_low = y_scaled; // Define a temperatura para o nível baixo
+                contador++;
+                play_tone(tone_confirm); // Emite um som de confirmação
+                break;
+            case 1:
+                fan_medium = y_scaled; // Define a temperatura para o nível médio
+                contador++;
+                play_tone(tone_confirm);
+                break;
+            case 2:
+                fan_high = y_scaled; // Define a temperatura para o nível alto
+                contador = 0;
+                play_tone(tone_confirm);
+                break;
+            default:
+                contador = 0; // Reinicia o contador em caso de bug
         }
     }
 }
 
 // Função que representa a tela de seleção da umidade limite
-void selecionar_umidade(ssd1306_t *ssd) {
-    // Obtém o tempo atual em milissegundos para debouncing
-    uint32_t t_current_time = to_ms_since_boot(get_absolute_time());
-
+void selecionar_umidade(view_t *v, bool confirm) {
     // Lê o valor analógico do joystick no eixo X
     x_value = read_x();
 
-    // Escala o valor lido para representar a umidade simulada
-    x_scaled = scale(x_low,x_high,0,100,x_value);
-
-    // Garante que a umidade fique dentro dos limites definidos
-    if(x_scaled > 100) {
-        x_scaled = 100;
-    }else
-    if(x_scaled < 0) {
-        x_scaled = 0;
-    }
+    // Converte o valor lido na umidade simulada, já dentro dos limites definidos
+    PROF_BEGIN(PROF_SCALE);
+    x_scaled = calib_apply(&x_calib, x_value);
+    PROF_END(PROF_SCALE);
     
-    // Limpa os campos de temperatura do buffer do display
-    sprintf((char *)&string1[2],"     \0");        // Atualiza o final da string1 (temperatura) com "     \0"
-    sprintf((char *)&string3[4],"      \0");       // Atualiza o final da string3 (estado do ventilador) com "      \0"
-    ssd1306_draw_string(ssd,(char *)string1,6,7);  // Atualiza o buffer do display da string1 (temperatura)
-    ssd1306_draw_string(ssd,(char *)string3,6,37); // Atualiza o buffer do display da string3 (estado do ventilador)
+    // Limpa os campos de temperatura do display (mantendo os prefixos "T:" e "fan:")
+    v->show_temperature = false;
+    v->fan = FAN_BLANK;
 
     // Desliga o LED vermelho, pois só o umidificador está sendo configurado
-    pwm_set_gpio_level(RED_LED, 0);
-    
-    sprintf((char *)&string2[2],"%3d%%\0",x_scaled); // Atualiza o final da string2 (umidade) "000%" com o valor convertido do eixo X
-    ssd1306_draw_string(ssd,(char *)string2,6,20);   // Manda para o buffer do display o valor lido de umidade
+    actuator_force(&fan, FAN_OFF);
+
+    v->humidity = x_scaled; // Mostra o valor lido de umidade
+    v->show_humidity = true;
 
     // Define as informações do umidificador como ligado para mostrar que é o limite de acionamento que está sendo configurado
-    pwm_set_gpio_level(BLUE_LED, 1365);            // Liga o LED azul
-    sprintf((char *)&string4[11],"on \0");         // Atualiza o final da string4 (estado do umidificador) com "on \0"
-    draw_sad(ssd,84,6);                            // Desenha o rostinho triste
-    ssd1306_draw_string(ssd,(char *)string4,6,50); // Atualiza o buffer do display da string4 (estado do umidificador)
-    
-    // Envia os dados do buffer para atualizar o display
-    ssd1306_send_data(ssd);
+    actuator_force(&humidifier, HUMIDIFIER_ON);         // Liga o LED azul
+    v->humidifier = HUMIDIFIER_ON;                       // Mostra o umidificador como ligado
+    v->face = &face_sad;                                 // Desenha o rostinho triste
 
     // Verifica se o botão A foi pressionado
-    if( (t_current_time - t_last_time) > 200 ) {
-        if(!gpio_get(BUTTON_A)) {
-            t_last_time = t_current_time; 
-            humidifier_on = x_scaled; // Define a umidade de acionamento do umidificador com o valor lido do eixo X
-            beep(120);                // Emite um som de confirmação
-        }
+    if(confirm) {
+        humidifier_on = x_scaled; // Define a umidade de acionamento do umidificador com o valor lido do eixo X
+        play_tone(tone_confirm); // Emite um som de confirmação
     }
 }
 
-void calibrar_joystick() {
+// Função que representa a tela de calibração do joystick; a calibração avança um pouco a cada volta do laço
+void calibrar_joystick(view_t *v, bool confirm) {
     // Obtém o tempo atual em milissegundos
     uint32_t t_current_time = to_ms_since_boot(get_absolute_time());
 
-    // Verifica se o botão A foi pressionado
-    if( (t_current_time - t_last_time) > 200 ) {
-        if(!gpio_get(BUTTON_A)) {
-            t_last_time = t_current_time;
+    // Verifica se o botão A foi pressionado: inicia a calibração ou aborta a que está em andamento
+    if(confirm) {
+        if(calibrator_running(&jsk_calibrator)) {
+            calibrator_abort(&jsk_calibrator); // Mantém a calibração anterior
+        }else {
+            play_tone(tone_confirm); // Emite um bip para indicar o início da calibração
+            calibrator_start(&jsk_calibrator, t_current_time);
+        }
+    }
 
-            // Desativa temporariamente a interrupção do botão do joystick para evitar bugs durante a calibração
-            gpio_set_irq_enabled(JSK_SEL, GPIO_IRQ_EDGE_FALL, false);
+    calibrator_event_t event = calibrator_tick(&jsk_calibrator, t_current_time);
+    if(event != CALIBRATOR_EV_NONE) {
+        trace_emit(TRACE_CALIBRATION, jsk_calibrator.step, event);
+    }
+    switch(event) {
+        case CALIBRATOR_EV_RETRY: // Leituras instáveis: avisa e repete o mesmo passo
+            play_tone(tone_alert);
+            // fall through
+        case CALIBRATOR_EV_PROMPT: // Novo passo: mostra na matriz para onde mover o joystick
+            v->frame = calibrator_prompt(&jsk_calibrator);
+            break;
+        case CALIBRATOR_EV_DONE:
+            update_calibration(); // Recalcula as curvas com os novos limites
+            play_tone(tone_confirm); // Emite um bip para indicar o fim da calibração
+            // fall through
+        case CALIBRATOR_EV_ABORTED:
+            // Volta a matriz de LEDs para o desenho inicial da tela de calibração
+            v->frame = FRAME_CALIBRATION;
+            break;
+        default:
+            break;
+    }
+}
 
-            beep(120);                // Emite um bip para indicar o início da calibração
-            calibrate_jsk_y_values(); // Executa a calibração dos valores do eixo Y do joystick
-            calibrate_jsk_x_values(); // Executa a calibração dos valores do eixo X do joystick
-            beep(120);                // Emite um bip para indicar o fim da calibração
+// -------- Seleção de telas - Fim --------
 
-            // Volta a matriz de LEDs para o desenho inicial da tela de calibração
-            calibration_screen();
+// -------- Telemetria - Início --------
 
-            // Reativa a interrupção do botão do joystick
-            gpio_set_irq_enabled(JSK_SEL, GPIO_IRQ_EDGE_FALL, true);
-        }
+// Entrega os bytes dos quadros ao canal só enquanto ele aceita sem esperar
+uint32_t telemetry_write(const uint8_t *data, uint32_t len) {
+#if TELEMETRY_UART
+    uint32_t n = 0;
+    while(n < len && uart_is_writable(uart_default)) {
+        uart_putc_raw(uart_default, data[n++]); // Cabe na FIFO: não bloqueia
+    }
+    return n;
+#else
+    // Sem terminal aberto os quadros são descartados; o receptor começa no próximo quadro completo
+    if(!stdio_usb_connected()) {
+        return len;
     }
+    return usb_cdc_write(data, len); // Só o que cabe na FIFO, sem a conversão de \n do printf
+#endif
 }
 
-// -------- Seleção de telas - Fim --------
+#if !TELEMETRY_UART
+// Espaço na FIFO da USB para o próximo quadro; sem terminal aberto a escrita descarta qualquer tamanho
+uint32_t telemetry_available(void) {
+    if(!stdio_usb_connected()) {
+        return UINT32_MAX;
+    }
+    return usb_cdc_available();
+}
+#endif
+
+// -------- Telemetria - Fim --------
 
 // ---------------- Funções - Fim ----------------
 
 
 
-// ---------------- Main - Início ----------------
+// ---------------- Tarefas - Início ----------------
 
-int main() {
-    ssd1306_t ssd; // Váriavel que identifica o display
+// Atualiza os filtros dos eixos com as amostras mais recentes do ADC
+void task_sample(void *arg) {
+    PROF_BEGIN(PROF_SAMPLE);
+    filter_update(&y_filter);
+    filter_update(&x_filter);
+    PROF_END(PROF_SAMPLE);
+}
 
-    stdio_init_all(); // Inicializa as entradas e saídas padrões
+// Trata a troca de tela pedida pelo botão do joystick
+void change_screen(void) {
+    screen_state = (screen_state + 1) % SCREEN_COUNT; // Avança para a próxima tela, voltando à primeira depois da última
+    trace_emit(TRACE_SCREEN, 0, screen_state);
+
+    // Alterna a imagem da matriz de LEDs entre as telas (o aviso de falta de água só é aceito na tela principal)
+    switch(screen_state) {
+        case 0:
+            view.frame = FRAME_CLEAR; // Limpa a matriz de LEDs ao voltar à tela inicial
+            break;
+        case 1:
+            view.frame = FRAME_TEMPERATURE; // Exibe o desenho de configuração de temperatura na matriz
+            break;
+        case 2:
+            view.frame = FRAME_HUMIDITY; // Exibe o desenho de configuração de umidade na matriz
+            break;
+        case 3:
+            tela_inicial(&view); // Atualiza os dados mostrados no display 1 vez para aparecer todas as informações de novo
+            view.frame = FRAME_CALIBRATION; // Exibe o desenho de calibração na matriz
+            break;
+    }
+}
 
-    init_display(&ssd); // Inicializa o display OLED
+// Trata o botão B (Simula o sinal que está sendo recebido pelo sensor de nível do umidificador)
+void toggle_low_water(void) {
+    if(switch_b) { // Faz o botão funcionar como um interruptor (simula o sinal constante 0 ou 1)
+        view.frame = FRAME_LOW_WATER; // Mostra na matriz de LEDs que o umidificador está com pouca água
+        play_tone(tone_alert); // Emite um som indicando que o umidificador está com pouca água
+        switch_b = false;
+    }else {
+        view.frame = FRAME_CLEAR; // Limpa a matriz de LEDs
+        switch_b = true;
+    }
+    trace_emit(TRACE_LOW_WATER, 0, !switch_b);
+}
 
-    npInit(MATRIX_PIN); // Inicializa e limpa a matriz de LEDs
-    npClear();
-    npWrite();
+// Registra os valores convertidos e os níveis dos atuadores que mudaram desde o último ciclo
+void trace_changes(void) {
+    static int traced_y = INT16_MIN, traced_x = INT16_MIN;      // Forçam o primeiro registro
+    static uint8_t traced_fan = UINT8_MAX, traced_humidifier = UINT8_MAX;
 
-    init_joystick(); // Inicializa o joystick
-    init_rgb();      // Inicializa o LED RGB
-    init_buttons();  // Inicializa os botões A e B
-    init_buzzers();  // Inicializa os buzzers
+    if(y_scaled != traced_y) {
+        trace_emit(TRACE_SCALED, 0, y_scaled);
+        traced_y = y_scaled;
+    }
+    if(x_scaled != traced_x) {
+        trace_emit(TRACE_SCALED, 1, x_scaled);
+        traced_x = x_scaled;
+    }
+    if(fan.level != traced_fan) {
+        trace_emit(TRACE_LEVEL, 0, fan.level);
+        traced_fan = fan.level;
+    }
+    if(humidifier.level != traced_humidifier) {
+        trace_emit(TRACE_LEVEL, 1, humidifier.level);
+        traced_humidifier = humidifier.level;
+    }
+}
 
-    // Configura as interrupções para o botão do joystick e para o botão B
-    gpio_set_irq_enabled_with_callback(JSK_SEL, GPIO_IRQ_EDGE_FALL, true, &gpio_irq_callback);
-    gpio_set_irq_enabled_with_callback(BUTTON_B, GPIO_IRQ_EDGE_FALL, true, &gpio_irq_callback);
+// Publica uma cópia do estado atual para os leitores fora do controle
+void publish_state(void) {
+    system_state_t state = {
+        screen_state, y_scaled, x_scaled, y_value, x_value, fan.level, humidifier.level, !switch_b,
+        fan_low, fan_medium, fan_high, humidifier_on,
+    };
+    seqlock_write(&shared_state_lock, &shared_state, &state, sizeof(state));
+}
 
-    while (true) {
-        sleep_ms(10); // Pequena pausa para testes no WOKWI
+// Lê uma cópia consistente do estado publicado (pode ser chamada de qualquer núcleo)
+void state_read(system_state_t *state) {
+    seqlock_read(&shared_state_lock, state, &shared_state, sizeof(*state));
+}
 
-        // Controla qual tela deve ser exibida de acordo com o estado atual
-        switch(screen_state) {
-            case 0:
-                tela_inicial(&ssd); // Tela principal
-                break;
-            case 1:
-                selecionar_temperatura(&ssd); // Tela para configurar as temperaturas de acionamento do ventilador
+// Executa a tela atual (leitura, controle dos atuadores e estado a ser mostrado) depois de tratar os botões
+void task_control(void *arg) {
+    input_event_t event;
+    bool confirm = false; // Botão A pressionado neste ciclo
+    PROF_BEGIN(PROF_CONTROL);
+
+    // Trata os eventos dos botões; toques agrupados (count > 1) contam como vários toques
+    input_poll(time_us_32());
+    while(input_get(&event)) {
+        trace_emit(TRACE_BUTTON, event.button, event.type | event.count << 8);
+        if(event.type != INPUT_PRESS) {
+            continue;
+        }
+        switch(event.button) {
+            case INPUT_JSK:
+                // O botão do joystick não troca de tela durante a calibração, quando o joystick está sendo movido
+                for(uint8_t i = 0; i < event.count && !calibrator_running(&jsk_calibrator); i++) {
+                    change_screen();
+                }
                 break;
-            case 2:
-                selecionar_umidade(&ssd); // Tela para configurar a umidade de acionamento do umidificador
+            case INPUT_A:
+                confirm = true;
                 break;
-            case 3: 
-                calibrar_joystick(); // Tela para calibrar o joystick
+            case INPUT_B:
+                // O aviso de falta de água só é tratado na tela principal
+                for(uint8_t i = 0; i < event.count && screen_state == 0; i++) {
+                    toggle_low_water();
+                }
                 break;
-            default:
-                screen_state = 0; // Caso haja um estado inválido (bug), retorna para a tela inicial
         }
+    }
 
-         // Tratar a interrupção do botão B (Simula o sinal que está sendo recebido pelo sensor de nível do umidificador)
-        if(flag_b) {
-            flag_b = false; // Reseta a flag
-            if(switch_b) { // Faz o botão funcionar como um interruptor (simula o sinal constante 0 ou 1)
-                humidifier_matrix(); // Mostra na matriz de LEDs que o umidificador está com pouca água
-                beep(400);           // Emite um som indicando que o umidificador está com pouca água
-                switch_b = false;
-            }else {
-                npClear(); // Limpa a matriz de LEDs
-                npWrite();
-                switch_b = true;
-            }
-        }
+    // Controla qual tela deve ser exibida de acordo com o estado atual
+    switch(screen_state) {
+        case 0:
+            tela_inicial(&view); // Tela principal
+            break;
+        case 1:
+            selecionar_temperatura(&view, confirm); // Tela para configurar as temperaturas de acionamento do ventilador
+            break;
+        case 2:
+            selecionar_umidade(&view, confirm); // Tela para configurar a umidade de acionamento do umidificador
+            break;
+        case 3: 
+            calibrar_joystick(&view, confirm); // Tela para calibrar o joystick
+            break;
+        default:
+            screen_state = 0; // Caso haja um estado inválido (bug), retorna para a tela inicial
+    }
+
+    // Leva os LEDs em rampa até o nível escolhido pela tela
+    uint32_t now = to_ms_since_boot(get_absolute_time());
+    actuator_output(&fan, now);
+    actuator_output(&humidifier, now);
+
+    trace_changes();
+    publish_state();
+
+    // Publica o estado para a renderização, substituindo o instantâneo anterior se ainda não foi desenhado
+    seqlock_write(&view_lock, &published_view, &view, sizeof(view));
+    PROF_END(PROF_CONTROL);
+}
 
-        // Lógica para alternar a imagem da matriz de LEDs entre as mudanças de tela
-        if(change_screen) {
-            change_screen = false;
-            switch(screen_state) {
-                case 0:
-                    gpio_set_irq_enabled(BUTTON_B, GPIO_IRQ_EDGE_FALL, true); // Permite o aviso de falta de água habilitando novamente a interrupção
-                    npClear(); // Limpa a matriz de LEDs ao voltar à tela inicial
-                    npWrite();
-                    break;
-                case 1:
-                    gpio_set_irq_enabled(BUTTON_B, GPIO_IRQ_EDGE_FALL, false); // Desativa o aviso de falta de água já que não está na tela principal
-                    temperature_screen(); // Exibe o desenho de configuração de temperatura na matriz
-                    break;
-                case 2:
-                    gpio_set_irq_enabled(BUTTON_B, GPIO_IRQ_EDGE_FALL, false); // Desativa o aviso de falta de água já que não está na tela principal
-                    humidifier_screen(); // Exibe o desenho de configuração de umidade na matriz
-                    break;
-                case 3:
-                    gpio_set_irq_enabled(BUTTON_B, GPIO_IRQ_EDGE_FALL, false); // Desativa o aviso de falta de água já que não está na tela principal
-                    tela_inicial(&ssd); // Atualiza os dados mostrados no display 1 vez para aparecer todas as informações de novo
-                    calibration_screen(); // Exibe o desenho de configuração de umidade na matriz
-                    break;
+// Desenha no buffer do display e na matriz o estado recebido do controle (só o que mudou é redesenhado)
+void render_view(ssd1306_t *ssd, const view_t *v) {
+    static np_frame_t shown_frame = FRAME_CLEAR; // A matriz é limpa na inicialização
+
+    if(v->show_temperature) {
+        ui_number_set(ssd, &ui_temperature, v->temperature);
+    }else {
+        ui_number_clear(ssd, &ui_temperature);
+    }
+    if(v->show_humidity) {
+        ui_number_set(ssd, &ui_humidity, v->humidity);
+    }else {
+        ui_number_clear(ssd, &ui_humidity);
+    }
+    ui_label_set(ssd, &ui_fan, fan_labels[v->fan]);
+    ui_label_set(ssd, &ui_humidifier, humidifier_labels[v->humidifier]);
+    ui_icon_set(ssd, &ui_face, v->face);
+
+    if(v->frame != shown_frame) {
+        npShowFrame(v->frame);
+        shown_frame = v->frame;
+    }
+}
+
+// Renderiza o instantâneo mais recente do controle, se houve publicação desde o último desenho
+void render_pending(ssd1306_t *ssd) {
+    static uint32_t rendered_seq = 0; // Nada publicado ainda
+    view_t v;
+    if(view_lock.seq != rendered_seq) {
+        rendered_seq = seqlock_read(&view_lock, &v, &published_view, sizeof(v));
+        PROF_BEGIN(PROF_RENDER);
+        render_view(ssd, &v);
+        PROF_END(PROF_RENDER);
+    }
+}
+
+// Renderiza e inicia o envio por DMA das regiões alteradas do display sem travar as outras tarefas
+void task_display(void *arg) {
+    render_pending(arg);
+    PROF_BEGIN(PROF_FLUSH);
+    ssd1306_send_data_async(arg);
+    PROF_END(PROF_FLUSH);
+}
+
+#if PROFILE
+// Nomes dos estágios do perfil, na ordem da enumeração
+static const char *const prof_stage_names[PROF_STAGE_COUNT] = {
+    "sample", "scale", "control", "render", "flush", "matrix", "buzzer",
+};
+
+// Comandos pela USB/UART: 'p' imprime o perfil dos estágios e os contadores das tarefas, 'r' zera os dois
+void task_console(void *arg) {
+    sched_t *sched = arg;
+    int c;
+
+    while((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+        if(c == 'p') {
+            prof_dump();
+            printf("tarefas: nome execuções estouros perdidos máx_us\n");
+            for(uint8_t i = 0; i < sched->count; i++) {
+                const sched_task_t *t = &sched->tasks[i];
+                printf("%s %lu %lu %lu %lu\n", t->name, (unsigned long)t->runs, (unsigned long)t->overruns,
+                       (unsigned long)t->missed, (unsigned long)t->max_us);
             }
+        }else if(c == 'r') {
+            prof_reset();
+            sched_reset_stats(sched);
         }
     }
 }
+#endif
+
+// Monta o quadro de telemetria do período com o estado publicado e envia o que o canal aceitar
+void task_telemetry(void *arg) {
+    system_state_t state;
+    state_read(&state);
+
+    const int16_t values[TM_FIELD_COUNT] = {
+        [TM_SCREEN] = state.screen,
+        [TM_TEMPERATURE] = state.temperature,
+        [TM_HUMIDITY] = state.humidity,
+        [TM_Y_RAW] = state.y_raw,
+        [TM_X_RAW] = state.x_raw,
+        [TM_FAN] = state.fan,
+        [TM_HUMIDIFIER] = state.humidifier,
+        [TM_LOW_WATER] = state.low_water,
+        [TM_FAN_LOW] = state.fan_low,
+        [TM_FAN_MEDIUM] = state.fan_medium,
+        [TM_FAN_HIGH] = state.fan_high,
+        [TM_HUMIDIFIER_ON] = state.humidifier_on,
+    };
+    telemetry_sample(&telemetry, values, to_ms_since_boot(get_absolute_time()));
+    telemetry_flush(&telemetry);
+}
+
+#if TRACE
+// Envia pela USB um bloco do registro de eventos, sem esperar pelo computador
+void task_trace(void *arg) {
+    trace_drain();
+}
+#endif
+
+#if DUAL_CORE
+// Núcleo 1: espera o núcleo 0 entregar o display pela FIFO entre os núcleos e cuida só da
+// renderização; o envio pode bloquear aqui sem atrasar o controle no núcleo 0
+void core1_main() {
+    ssd1306_t *ssd = &display;
+    multicore_fifo_pop_blocking(); // Display inicializado: a partir daqui é deste núcleo
+    absolute_time_t next = get_absolute_time();
+
+#if PROFILE
+    prof_start_core(); // O contador do perfil é de cada núcleo
+#endif
+    while (true) {
+        render_pending(ssd);
+        PROF_BEGIN(PROF_FLUSH);
+        ssd1306_send_data(ssd);
+        PROF_END(PROF_FLUSH);
+        next = delayed_by_us(next, RENDER_PERIOD_US);
+        sleep_until(next);
+    }
+}
+#endif
+
+// ---------------- Tarefas - Fim ----------------
+
+
+
+// ---------------- Main - Início ----------------
+
+int main() {
+    stdio_init_all(); // Inicializa as entradas e saídas padrões
+    trace_init();     // Registro de eventos (antes das interrupções dos botões)
+#if PROFILE
+    prof_init(prof_stage_names, PROF_STAGE_COUNT); // Medição dos estágios (antes da primeira sonda, na matriz)
+#endif
+
+    init_display(&display); // Inicializa o display OLED
+
+    npInit(MATRIX_PIN); // Inicializa e limpa a matriz de LEDs
+    npShowFrame(FRAME_CLEAR);
+
+    init_joystick();      // Inicializa o joystick
+    update_calibration(); // Monta as curvas dos eixos com a calibração padrão
+    calibrator_init(&jsk_calibrator, jsk_cal_steps, sizeof(jsk_cal_steps) / sizeof(jsk_cal_steps[0]),
+                    CAL_SETTLE_MS, CAL_SAMPLES, CAL_INTERVAL_MS, CAL_MAX_STDDEV, read_axis);
+    init_rgb();           // Inicializa o LED RGB
+    actuator_init(&fan, &fan_config, to_ms_since_boot(get_absolute_time()));
+    actuator_init(&humidifier, &humidifier_config, to_ms_since_boot(get_absolute_time()));
+    init_buttons();       // Inicializa os botões A e B
+    init_buzzers();       // Inicializa os buzzers
+
+    // Configura as interrupções de borda do botão do joystick e dos botões A e B
+    input_init(input_buttons, sizeof(input_buttons) / sizeof(input_buttons[0]));
+
+    publish_state(); // A telemetria pode ler o estado antes do primeiro ciclo do controle
+    telemetry_init(&telemetry, &telemetry_config, to_ms_since_boot(get_absolute_time()));
+
+    // Tarefas em ordem de prioridade; cada uma roda no seu próprio ritmo
+    sched_t sched;
+    sched_task_t tasks[] = {
+        SCHED_TASK("sample", SAMPLE_PERIOD_US, SAMPLE_BUDGET_US, task_sample, NULL),
+        SCHED_TASK("control", CONTROL_PERIOD_US, CONTROL_BUDGET_US, task_control, NULL),
+#if !DUAL_CORE
+        SCHED_TASK("display", DISPLAY_PERIOD_US, DISPLAY_BUDGET_US, task_display, &display),
+#endif
+        SCHED_TASK("telemetry", TELEMETRY_FLUSH_US, TELEMETRY_BUDGET_US, task_telemetry, NULL),
+#if TRACE
+        SCHED_TASK("trace", TRACE_PERIOD_US, TRACE_BUDGET_US, task_trace, NULL),
+#endif
+#if PROFILE
+        SCHED_TASK("console", CONSOLE_PERIOD_US, CONSOLE_BUDGET_US, task_console, &sched),
+#endif
+    };
+    sched_init(&sched, tasks, sizeof(tasks) / sizeof(tasks[0]), time_us_64);
+    sched_start(&sched, SCHED_TICK_US);
+
+#if DUAL_CORE
+    // A partir daqui o display e a matriz pertencem ao núcleo 1; a palavra só sinaliza a entrega (um
+    // ponteiro não caberia nos 32 bits da FIFO na simulação de 64 bits)
+    multicore_launch_core1(core1_main);
+    multicore_fifo_push_blocking(1);
+#endif
+
+    while (true) {
+        sched_run(&sched); // Dorme até o próximo tick e executa as tarefas vencidas
+    }
+}
 
 // ---------------- Main - Fim ----------------
\ No newline at end of file
@@ -0,0 +1,495 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "hardware/pio.h"
+#include "inc/ssd1306.h"
+#include "inc/ui.h"
+#include "inc/fmt.h"
+#include "inc/calib.h"
+#include "inc/calibrator.h"
+#include "inc/filter.h"
+#include "inc/actuator.h"
+#include "sprites.h"
+#include "ws2812.pio.h"
+#include "bench/reference.h"
+
+#if PICO_ON_DEVICE
+#include "hardware/structs/systick.h"
+#else
+#include <time.h>
+#include "hal/sim.h"
+#endif
+
+// Medição dos caminhos quentes do desenho e do controle com entradas fixas. Cada caso roda um número
+// fixo de iterações e o resultado sai em JSON (um caso por linha) para comparar versões:
+//
+//   ns_per_op      tempo médio por operação (melhor de BENCH_REPEATS rodadas)
+//   cycles_per_op  no Pico: menor contagem do SysTick para uma operação (null no computador)
+//   bytes_per_op   bytes que saíram por operação: ao display depois do endereço (controle, comandos
+//                  e dados) nos casos flush_*, e no fio da matriz nos casos matrix_* (null nos outros)
+//
+// Os casos ref_* são os caminhos antigos (bench/reference.c), um pixel por vez e o quadro inteiro
+// a cada envio, para comparar com os atuais na mesma execução.
+//
+// No Pico o display e a matriz precisam estar ligados nos mesmos pinos do firmware. No computador
+// o envio passa pelos modelos de sim/hal, então o tempo dos casos flush_* e matrix_* mede o modelo
+// e só os bytes valem; os bytes do display são conferidos com os contadores do I2C simulado.
+
+#define BENCH_REPEATS 5  // Rodadas de cada caso; vale a mais rápida
+#define BENCH_CYCLE_RUNS 16 // Medições de uma operação isolada com o SysTick; vale a menor
+
+#define I2C_PORT i2c1 // Mesmos pinos e endereço do firmware
+#define I2C_SDA 14
+#define I2C_SCL 15
+#define ADDRESS 0x3C
+#define MATRIX_PIN 7  // Mesmo pino e número de LEDs da matriz do firmware
+#define LED_COUNT 25
+
+// Onde vão os bytes retornados pela operação
+typedef enum {
+  BENCH_BYTES_NONE,
+  BENCH_BYTES_DISPLAY, // Enviados ao display
+  BENCH_BYTES_MATRIX,  // Enviados à matriz
+} bench_bytes_t;
+
+typedef struct {
+  const char *name;
+  uint32_t iterations;
+  void (*setup)(void);      // Chamado antes de cada rodada (pode ser NULL)
+  uint32_t (*run)(uint32_t i); // Uma operação; o retorno entra em bench_sink para não ser descartado
+  bench_bytes_t bytes;      // O retorno é o número de bytes enviados
+} bench_t;
+
+static ssd1306_t ssd;
+static uint8_t ref_ram[WIDTH * HEIGHT / 8 + 1] = {0x40}; // Buffer dos caminhos antigos
+static volatile uint32_t bench_sink;
+
+// ---------------- Relógio ----------------
+
+#if PICO_ON_DEVICE
+static uint64_t bench_now_ns(void) {
+  return time_us_64() * 1000u;
+}
+
+static void bench_cycles_init(void) {
+  systick_hw->csr = 0;
+  systick_hw->rvr = 0x00FFFFFF; // Contador de 24 bits no clock do processador
+  systick_hw->cvr = 0;
+  systick_hw->csr = 0x5;        // Liga, usando o clock do processador, sem interrupção
+}
+
+static inline uint32_t bench_cycles(void) {
+  return systick_hw->cvr;
+}
+
+// O SysTick conta para baixo
+static inline uint32_t bench_cycles_elapsed(uint32_t start, uint32_t end) {
+  return (start - end) & 0x00FFFFFF;
+}
+#else
+static uint64_t bench_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+#endif
+
+// ---------------- Casos do display ----------------
+
+static void setup_clear(void) {
+  ssd1306_fill(&ssd, false);
+}
+
+static uint32_t run_pixel(uint32_t i) {
+  // Percorre a tela inteira, ligando na primeira passada e desligando na segunda
+  uint32_t n = i % (2 * WIDTH * HEIGHT);
+  ssd1306_pixel(&ssd, n % WIDTH, (n / WIDTH) % HEIGHT, n < WIDTH * HEIGHT);
+  return n;
+}
+
+static uint32_t run_fill(uint32_t i) {
+  ssd1306_fill(&ssd, i & 1);
+  return i;
+}
+
+static uint32_t run_draw_string(uint32_t i) {
+  // Alterna dois textos do mesmo tamanho para que toda chamada altere o buffer
+  ssd1306_draw_string(&ssd, (i & 1) ? "Vent: Alto" : "Umid: Liga", 6, 37);
+  return i;
+}
+
+static uint32_t run_blit_face(uint32_t i) {
+  static const sprite_t *const faces[] = {&face_happy, &face_neutral, &face_sad};
+  const sprite_t *face = faces[i % 3];
+  ssd1306_blit(&ssd, face->data, 84, 6 + (i & 1), face->width, face->height); // y ímpar exercita o deslocamento
+  return i;
+}
+
+static uint32_t run_frames(uint32_t i) {
+  static const ui_frame_t frames[] = {
+      {3, 3, 122, 60, false},
+      {32, 3, 74, 1, true},
+      {3, 77, 1, 60, true},
+  };
+  ssd1306_fill(&ssd, false);
+  ui_frames_draw(&ssd, frames, sizeof(frames) / sizeof(frames[0]));
+  return i;
+}
+
+// Os mesmos desenhos pelos caminhos antigos
+static void setup_ref_clear(void) {
+  ref_fill(ref_ram, false);
+}
+
+static uint32_t run_ref_fill(uint32_t i) {
+  ref_fill(ref_ram, i & 1);
+  return i;
+}
+
+static uint32_t run_ref_draw_string(uint32_t i) {
+  ref_draw_string(ref_ram, (i & 1) ? "Vent: Alto" : "Umid: Liga", 6, 37);
+  return i;
+}
+
+static uint32_t run_ref_blit_face(uint32_t i) {
+  static const sprite_t *const faces[] = {&face_happy, &face_neutral, &face_sad};
+  const sprite_t *face = faces[i % 3];
+  ref_blit(ref_ram, face->data, 84, 6 + (i & 1), face->width, face->height);
+  return i;
+}
+
+static uint32_t run_ref_frames(uint32_t i) {
+  ref_fill(ref_ram, false);
+  ref_rect(ref_ram, 3, 3, 122, 60, true, false);
+  ref_rect(ref_ram, 32, 3, 74, 1, true, true);
+  ref_rect(ref_ram, 3, 77, 1, 60, true, true);
+  return i;
+}
+
+static ui_number_t bench_number = UI_NUMBER(6, 7, "T:", 3, "C*");
+static ui_label_t bench_label = UI_LABEL(6, 37);
+static ui_icon_t bench_icon = UI_ICON(84, 6);
+
+static void setup_ui(void) {
+  ssd1306_fill(&ssd, false);
+  ui_number_invalidate(&bench_number);
+  ui_label_invalidate(&bench_label);
+  bench_icon.sprite = NULL;
+}
+
+static uint32_t run_ui_number(uint32_t i) {
+  return ui_number_set(&ssd, &bench_number, (int) (i % 61) - 10); // -10..50 °C
+}
+
+static uint32_t run_ui_number_same(uint32_t i) {
+  return ui_number_set(&ssd, &bench_number, 25); // Caminho sem mudança (o mais comum no laço)
+}
+
+static uint32_t run_ui_label(uint32_t i) {
+  static const char *const labels[] = {"Vent: Desl", "Vent: Baixo", "Vent: Medio", "Vent: Alto"};
+  return ui_label_set(&ssd, &bench_label, labels[i & 3]);
+}
+
+static uint32_t run_ui_icon(uint32_t i) {
+  static const sprite_t *const faces[] = {&face_happy, &face_neutral, &face_sad};
+  return ui_icon_set(&ssd, &bench_icon, faces[i % 3]);
+}
+
+// ---------------- Casos do envio do quadro ----------------
+
+// Envia as regiões alteradas e espera o I2C; retorna o tamanho do fluxo enviado (0 se nada mudou)
+static uint32_t bench_flush(void) {
+  bool sent = ssd1306_send_data_async(&ssd);
+  ssd1306_wait(&ssd);
+  return sent ? ssd.tx_length : 0;
+}
+
+// Quadro inteiro: o tempo inclui montar o fluxo e esperar o I2C
+static uint32_t run_flush_full(uint32_t i) {
+  ssd1306_invalidate(&ssd);
+  return bench_flush();
+}
+
+// Nada mudou: o caminho mais comum do laço
+static uint32_t run_flush_clean(uint32_t i) {
+  return bench_flush();
+}
+
+// Só o campo da temperatura mudou, como no laço do firmware
+static uint32_t run_flush_number(uint32_t i) {
+  ui_number_set(&ssd, &bench_number, (int) (i % 61) - 10);
+  return bench_flush();
+}
+
+// Campo da temperatura e rostinho mudaram: duas janelas em páginas diferentes
+static uint32_t run_flush_number_face(uint32_t i) {
+  static const sprite_t *const faces[] = {&face_happy, &face_neutral, &face_sad};
+  ui_number_set(&ssd, &bench_number, (int) (i % 61) - 10);
+  ui_icon_set(&ssd, &bench_icon, faces[i % 3]);
+  return bench_flush();
+}
+
+// Caminho antigo: o quadro inteiro a cada envio, com os comandos de endereço um por transação
+static uint32_t run_ref_flush(uint32_t i) {
+  return ref_send_full(I2C_PORT, ADDRESS, ref_ram);
+}
+
+// ---------------- Casos da matriz ----------------
+
+static PIO np_pio = pio0;
+static uint np_sm;
+static int np_dma_chan;
+static uint32_t np_frame[LED_COUNT];
+
+static void bench_matrix_init(void) {
+  uint offset = pio_add_program(np_pio, &ws2812_program);
+  np_sm = pio_claim_unused_sm(np_pio, true);
+  ws2812_program_init(np_pio, np_sm, offset, MATRIX_PIN, 800000.f);
+
+  np_dma_chan = dma_claim_unused_channel(true);
+  dma_channel_config c = dma_channel_get_default_config(np_dma_chan);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_dreq(&c, pio_get_dreq(np_pio, np_sm, true));
+  dma_channel_configure(np_dma_chan, &c, &np_pio->txf[np_sm], NULL, LED_COUNT, false);
+
+  for (uint i = 0; i < LED_COUNT; ++i)
+    np_frame[i] = (i * 0x1F) | (i * 3) << 8 | (i & 7) << 16; // Quadro GRB empacotado qualquer
+}
+
+// Começa cada rodada sem quadro em andamento: a primeira operação isolada mede só o custo na CPU
+static void setup_matrix(void) {
+  dma_channel_wait_for_finish_blocking(np_dma_chan);
+}
+
+// Quadro por DMA, como o npWrite: a CPU só espera o quadro anterior e dispara a DMA
+static uint32_t run_matrix_dma(uint32_t i) {
+  dma_channel_wait_for_finish_blocking(np_dma_chan);
+  dma_channel_transfer_from_buffer_now(np_dma_chan, np_frame, LED_COUNT);
+  return LED_COUNT * 3;
+}
+
+// Caminho antigo: a CPU coloca cada LED na FIFO e espera o quadro inteiro entrar nela
+static uint32_t run_ref_matrix(uint32_t i) {
+  return ref_np_put_pixels(np_pio, np_sm, np_frame, LED_COUNT);
+}
+
+// ---------------- Casos do controle ----------------
+
+static calib_t bench_calib;
+
+static void setup_calib(void) {
+  calib_set(&bench_calib, 20, 1950, 2150, 4080, -10, 50);
+}
+
+static uint32_t run_calib_apply(uint32_t i) {
+  return calib_apply(&bench_calib, i & 0x0FFF); // Todos os códigos do ADC, nos três trechos
+}
+
+static uint32_t run_calib_set(uint32_t i) {
+  calib_set(&bench_calib, 20 + (i & 15), 1950, 2150, 4080 - (i & 15), -10, 50);
+  return bench_calib.slope[0];
+}
+
+static const filter_config_t bench_filter_config = {0, 5, 3}; // Mediana de 5 e EMA com alfa 1/8
+static filter_t bench_filter;
+
+static void setup_filter(void) {
+  filter_init(&bench_filter, &bench_filter_config, 0);
+}
+
+static uint32_t run_filter_step(uint32_t i) {
+  // Rampa lenta com um pico a cada 7 leituras, para a mediana trabalhar
+  uint16_t code = 2048 + (i & 255) + ((i % 7) == 0 ? 900 : 0);
+  return filter_step(&bench_filter, code << FILTER_FRAC_BITS);
+}
+
+static const actuator_config_t bench_fan_config = {
+    25, 3, false, 1, 2000, 2000, 8, {0, 1365, 2730, 4095},
+};
+static actuator_t bench_fan;
+static const int16_t bench_fan_limits[] = {26, 30, 35};
+
+static void setup_actuator(void) {
+  actuator_init(&bench_fan, &bench_fan_config, 0);
+}
+
+static uint32_t run_actuator(uint32_t i) {
+  // Temperatura em dente de serra de 20 a 40 °C, uma leitura por ms
+  int16_t value = 20 + (int16_t) ((i / 50) % 21);
+  uint8_t level = actuator_update(&bench_fan, value, bench_fan_limits, i);
+  actuator_output(&bench_fan, i);
+  return level;
+}
+
+static uint16_t bench_calibrator_result[4];
+static const calibrator_step_t bench_calibrator_steps[] = {
+    {0, 0, CALIBRATOR_KEEP_MIN, &bench_calibrator_result[0]},
+    {1, 0, CALIBRATOR_KEEP_MAX, &bench_calibrator_result[1]},
+    {2, 1, CALIBRATOR_KEEP_MIN, &bench_calibrator_result[2]},
+    {3, 1, CALIBRATOR_KEEP_MAX, &bench_calibrator_result[3]},
+};
+static calibrator_t bench_calibrator;
+static uint32_t bench_calibrator_reads;
+
+static uint16_t bench_calibrator_read(uint8_t input) {
+  ++bench_calibrator_reads;
+  return 2048 + input * 100 + (bench_calibrator_reads & 31); // Ruído determinístico
+}
+
+static void setup_calibrator(void) {
+  bench_calibrator_reads = 0;
+  calibrator_init(&bench_calibrator, bench_calibrator_steps,
+                  sizeof(bench_calibrator_steps) / sizeof(bench_calibrator_steps[0]),
+                  500, 32, 10, 0, bench_calibrator_read);
+}
+
+// Uma sequência completa de calibração, com ticks a cada ms como no laço do firmware
+static uint32_t run_calibrator(uint32_t i) {
+  uint32_t now = 0;
+  calibrator_start(&bench_calibrator, now);
+  while (calibrator_tick(&bench_calibrator, now) != CALIBRATOR_EV_DONE)
+    ++now;
+  return bench_calibrator_result[0] + now;
+}
+
+static uint32_t run_fmt(uint32_t i) {
+  char text[UI_TEXT_MAX + 1];
+  char *p = fmt_str(text, "T:");
+  p = fmt_int(p, (int32_t) (i % 61) - 10, 3);
+  p = fmt_str(p, "C*");
+  return p - text;
+}
+
+static const bench_t benchmarks[] = {
+    {"ssd1306_pixel", 100000, setup_clear, run_pixel, BENCH_BYTES_NONE},
+    {"ssd1306_fill", 2000, NULL, run_fill, BENCH_BYTES_NONE},
+    {"ref_fill", 200, NULL, run_ref_fill, BENCH_BYTES_NONE},
+    {"ssd1306_draw_string", 20000, setup_clear, run_draw_string, BENCH_BYTES_NONE},
+    {"ref_draw_string", 2000, setup_ref_clear, run_ref_draw_string, BENCH_BYTES_NONE},
+    {"ssd1306_blit_face", 20000, setup_clear, run_blit_face, BENCH_BYTES_NONE},
+    {"ref_blit_face", 2000, setup_ref_clear, run_ref_blit_face, BENCH_BYTES_NONE},
+    {"ui_frames_draw", 2000, NULL, run_frames, BENCH_BYTES_NONE},
+    {"ref_frames", 200, NULL, run_ref_frames, BENCH_BYTES_NONE},
+    {"ui_number_set", 20000, setup_ui, run_ui_number, BENCH_BYTES_NONE},
+    {"ui_number_set_unchanged", 100000, setup_ui, run_ui_number_same, BENCH_BYTES_NONE},
+    {"ui_label_set", 20000, setup_ui, run_ui_label, BENCH_BYTES_NONE},
+    {"ui_icon_set", 20000, setup_ui, run_ui_icon, BENCH_BYTES_NONE},
+    {"fmt_number_field", 100000, NULL, run_fmt, BENCH_BYTES_NONE},
+    {"flush_full", 20, setup_ui, run_flush_full, BENCH_BYTES_DISPLAY},
+    {"flush_clean", 2000, setup_ui, run_flush_clean, BENCH_BYTES_DISPLAY},
+    {"flush_number", 200, setup_ui, run_flush_number, BENCH_BYTES_DISPLAY},
+    {"flush_number_face", 200, setup_ui, run_flush_number_face, BENCH_BYTES_DISPLAY},
+    {"ref_flush_full", 20, NULL, run_ref_flush, BENCH_BYTES_DISPLAY},
+    {"matrix_frame_dma", 200, setup_matrix, run_matrix_dma, BENCH_BYTES_MATRIX},
+    {"ref_matrix_put_pixel", 200, setup_matrix, run_ref_matrix, BENCH_BYTES_MATRIX},
+    {"calib_apply", 100000, setup_calib, run_calib_apply, BENCH_BYTES_NONE},
+    {"calib_set", 20000, setup_calib, run_calib_set, BENCH_BYTES_NONE},
+    {"filter_step", 100000, setup_filter, run_filter_step, BENCH_BYTES_NONE},
+    {"actuator_update_output", 100000, setup_actuator, run_actuator, BENCH_BYTES_NONE},
+    {"calibrator_sequence", 20, setup_calibrator, run_calibrator, BENCH_BYTES_NONE},
+};
+
+// ---------------- Execução ----------------
+
+static void bench_run(const bench_t *b, bool last) {
+  uint64_t best_ns = UINT64_MAX;
+  uint32_t bytes = 0;
+
+  for (uint8_t r = 0; r < BENCH_REPEATS; ++r) {
+    if (b->setup)
+      b->setup();
+    uint32_t sink = 0;
+#if !PICO_ON_DEVICE
+    uint64_t i2c_bytes = sim_i2c_bytes(1) - sim_i2c_transactions(1);
+#endif
+    uint64_t start = bench_now_ns();
+    for (uint32_t i = 0; i < b->iterations; ++i)
+      sink += b->run(i);
+    uint64_t elapsed = bench_now_ns() - start;
+    if (elapsed < best_ns)
+      best_ns = elapsed;
+    bench_sink += sink;
+    if (b->bytes != BENCH_BYTES_NONE)
+      bytes = sink / b->iterations; // Entradas fixas: o mesmo total em todas as rodadas
+#if !PICO_ON_DEVICE
+    // Os bytes contados pelas operações têm que ser os que passaram pelo barramento (sem os endereços)
+    i2c_bytes = sim_i2c_bytes(1) - sim_i2c_transactions(1) - i2c_bytes;
+    if (i2c_bytes != (b->bytes == BENCH_BYTES_DISPLAY ? sink : 0)) {
+      fprintf(stderr, "%s: %llu bytes no I2C, %lu contados\n", b->name, (unsigned long long) i2c_bytes,
+              (unsigned long) sink);
+      exit(1);
+    }
+#endif
+  }
+
+  printf("    {\"name\": \"%s\", \"iterations\": %lu, \"ns_per_op\": %.1f, ", b->name,
+         (unsigned long) b->iterations, (double) best_ns / b->iterations);
+
+#if PICO_ON_DEVICE
+  // Operação isolada: a menor contagem descarta interrupções; o custo da própria medição é descontado
+  uint32_t overhead = UINT32_MAX, cycles = UINT32_MAX;
+  for (uint8_t r = 0; r < BENCH_CYCLE_RUNS; ++r) {
+    uint32_t start = bench_cycles();
+    uint32_t end = bench_cycles();
+    uint32_t elapsed = bench_cycles_elapsed(start, end);
+    if (elapsed < overhead)
+      overhead = elapsed;
+  }
+  if (b->setup)
+    b->setup();
+  for (uint8_t r = 0; r < BENCH_CYCLE_RUNS; ++r) {
+    uint32_t start = bench_cycles();
+    bench_sink += b->run(r);
+    uint32_t elapsed = bench_cycles_elapsed(start, bench_cycles());
+    if (elapsed < cycles)
+      cycles = elapsed;
+  }
+  // Operações mais longas que o contador de 24 bits (~134 ms a 125 MHz) dão voltas: só o envio
+  // do quadro chega perto, e o tempo em ns continua valendo
+  printf("\"cycles_per_op\": %lu, ", (unsigned long) (cycles - overhead));
+#else
+  printf("\"cycles_per_op\": null, ");
+#endif
+
+  if (b->bytes != BENCH_BYTES_NONE)
+    printf("\"bytes_per_op\": %lu}%s\n", (unsigned long) bytes, last ? "" : ",");
+  else
+    printf("\"bytes_per_op\": null}%s\n", last ? "" : ",");
+}
+
+int main(void) {
+  stdio_init_all();
+
+  i2c_init(I2C_PORT, 400 * 1000);
+  gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
+  gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
+  gpio_pull_up(I2C_SDA);
+  gpio_pull_up(I2C_SCL);
+  ssd1306_init(&ssd, WIDTH, HEIGHT, false, ADDRESS, I2C_PORT);
+  ssd1306_config(&ssd);
+  bench_matrix_init();
+
+#if PICO_ON_DEVICE
+  sleep_ms(3000); // Tempo para abrir o terminal da USB
+  bench_cycles_init();
+  const char *target = "rp2040";
+#else
+  const char *target = "host";
+#endif
+
+  uint8_t count = sizeof(benchmarks) / sizeof(benchmarks[0]);
+  printf("{\n  \"target\": \"%s\",\n  \"benchmarks\": [\n", target);
+  for (uint8_t i = 0; i < count; ++i)
+    bench_run(&benchmarks[i], i == count - 1);
+  printf("  ]\n}\n");
+
+#if PICO_ON_DEVICE
+  while (true)
+    tight_loop_contents();
+#endif
+  return 0;
+}
@@ -0,0 +1,119 @@
+#include "reference.h"
+#include "inc/ssd1306.h"
+#include "inc/font.h"
+
+void ref_pixel(uint8_t *ram, uint8_t x, uint8_t y, bool value) {
+  if (x >= WIDTH || y >= HEIGHT)
+    return;
+  uint16_t index = (y >> 3) * WIDTH + x + 1;
+  uint8_t pixel = (y & 0b111);
+  if (value)
+    ram[index] |= (1 << pixel);
+  else
+    ram[index] &= ~(1 << pixel);
+}
+
+void ref_fill(uint8_t *ram, bool value) {
+  for (uint8_t y = 0; y < HEIGHT; ++y) {
+    for (uint8_t x = 0; x < WIDTH; ++x) {
+      ref_pixel(ram, x, y, value);
+    }
+  }
+}
+
+void ref_rect(uint8_t *ram, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+  for (uint16_t x = left; x < left + width; ++x) {
+    ref_pixel(ram, x, top, value);
+    ref_pixel(ram, x, top + height - 1, value);
+  }
+  for (uint16_t y = top; y < top + height; ++y) {
+    ref_pixel(ram, left, y, value);
+    ref_pixel(ram, left + width - 1, y, value);
+  }
+
+  if (fill) {
+    for (uint16_t x = left + 1; x < left + width - 1; ++x) {
+      for (uint16_t y = top + 1; y < top + height - 1; ++y) {
+        ref_pixel(ram, x, y, value);
+      }
+    }
+  }
+}
+
+void ref_hline(uint8_t *ram, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
+  for (uint16_t x = x0; x <= x1; ++x)
+    ref_pixel(ram, x, y, value);
+}
+
+void ref_vline(uint8_t *ram, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
+  for (uint16_t y = y0; y <= y1; ++y)
+    ref_pixel(ram, x, y, value);
+}
+
+void ref_blit(uint8_t *ram, const uint8_t *bitmap, uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
+  for (uint8_t j = 0; j < h; ++j) {
+    for (uint8_t i = 0; i < w; ++i) {
+      ref_pixel(ram, x + i, y + j, bitmap[(j >> 3) * w + i] >> (j & 7) & 1);
+    }
+  }
+}
+
+void ref_draw_char(uint8_t *ram, char c, uint8_t x, uint8_t y) {
+  uint16_t index = 0;
+  if (c >= 'a' && c <= 'z') {
+    index = (c - 'a' + 37) * 8;
+  } else if (c >= 'A' && c <= 'Z') {
+    index = (c - 'A' + 11) * 8;
+  } else if (c >= '0' && c <= '9') {
+    index = (c - '0' + 1) * 8;
+  } else if (c == ':') {
+    index = 63 * 8;
+  } else if (c == '?') {
+    index = 64 * 8;
+  } else if (c == '*') {
+    index = 65 * 8;
+  } else if (c == '%') {
+    index = 66 * 8;
+  } else if (c == '-') {
+    index = 67 * 8;
+  }
+
+  for (uint8_t i = 0; i < 8; ++i) {
+    uint8_t line = font[index + i];
+    for (uint8_t j = 0; j < 8; ++j) {
+      ref_pixel(ram, x + i, y + j, line & (1 << j));
+    }
+  }
+}
+
+void ref_draw_string(uint8_t *ram, const char *str, uint8_t x, uint8_t y) {
+  while (*str) {
+    ref_draw_char(ram, *str++, x, y);
+    x += 8;
+    if (x + 8 >= WIDTH) {
+      x = 0;
+      y += 8;
+    }
+    if (y + 8 >= HEIGHT) {
+      break;
+    }
+  }
+}
+
+uint32_t ref_send_full(i2c_inst_t *i2c, uint8_t address, const uint8_t *ram) {
+  const uint8_t commands[6] = {SET_COL_ADDR, 0, WIDTH - 1, SET_PAGE_ADDR, 0, HEIGHT / 8 - 1};
+  uint32_t sent = 0;
+
+  for (uint8_t i = 0; i < 6; ++i) {
+    uint8_t command[2] = {0x80, commands[i]};
+    sent += i2c_write_blocking(i2c, address, command, 2, false);
+  }
+  sent += i2c_write_blocking(i2c, address, ram, WIDTH * HEIGHT / 8 + 1, false);
+  return sent;
+}
+
+uint32_t ref_np_put_pixels(PIO pio, uint sm, const uint32_t *frame, uint count) {
+  for (uint i = 0; i < count; ++i)
+    pio_sm_put_blocking(pio, sm, frame[i]);
+  return count * 3;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "hardware/pio.h"
+
+// Caminhos de desenho antigos, um pixel por vez, sobre um buffer no formato do ram_buffer do
+// SSD1306 (byte de controle em [0], depois 8 páginas de WIDTH colunas). Servem de referência: os
+// testes comparam o buffer das primitivas por página com o destes, e a medição mostra quanto elas
+// ganharam. Ao contrário do código original, os pixels fora da tela são ignorados.
+
+void ref_pixel(uint8_t *ram, uint8_t x, uint8_t y, bool value);
+void ref_fill(uint8_t *ram, bool value);
+void ref_rect(uint8_t *ram, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill);
+void ref_hline(uint8_t *ram, uint8_t x0, uint8_t x1, uint8_t y, bool value);
+void ref_vline(uint8_t *ram, uint8_t x, uint8_t y0, uint8_t y1, bool value);
+
+// Bitmap organizado por páginas (o formato do ssd1306_blit) copiado pixel a pixel
+void ref_blit(uint8_t *ram, const uint8_t *bitmap, uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+
+// Texto com a escolha do glifo por faixas de caracteres e 64 pixels por caractere (os caracteres
+// fora da fonte ficam em branco)
+void ref_draw_char(uint8_t *ram, char c, uint8_t x, uint8_t y);
+void ref_draw_string(uint8_t *ram, const char *str, uint8_t x, uint8_t y);
+
+// Envio antigo do quadro: os 6 comandos de endereço em transações separadas de 2 bytes e o buffer
+// inteiro com i2c_write_blocking, esperando o fim. Retorna os bytes enviados depois do endereço
+uint32_t ref_send_full(i2c_inst_t *i2c, uint8_t address, const uint8_t *ram);
+
+// Envio antigo da matriz: um pio_sm_put_blocking por LED, com a CPU esperando espaço na FIFO.
+// Retorna os bytes que saem no fio (3 por LED)
+uint32_t ref_np_put_pixels(PIO pio, uint sm, const uint32_t *frame, uint count);
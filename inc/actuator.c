@@ -0,0 +1,73 @@
+#include "actuator.h"
+#include "hardware/pwm.h"
+
+static void actuator_set(actuator_t *a, uint8_t level, uint32_t now_ms) {
+  if (level == a->level)
+    return;
+  a->level = level;
+  a->changed_ms = now_ms;
+  ++a->switches;
+}
+
+void actuator_init(actuator_t *a, const actuator_config_t *cfg, uint32_t now_ms) {
+  a->cfg = cfg;
+  a->level = 0;
+  a->changed_ms = now_ms;
+  a->pwm = cfg->pwm[0];
+  a->output_ms = now_ms;
+  a->switches = 0;
+  a->writes = 1;
+  pwm_set_gpio_level(cfg->gpio, a->pwm);
+}
+
+uint8_t actuator_update(actuator_t *a, int16_t value, const int16_t *limits, uint32_t now_ms) {
+  const actuator_config_t *cfg = a->cfg;
+  uint16_t dwell = a->level ? cfg->min_on_ms : cfg->min_off_ms;
+
+  if (now_ms - a->changed_ms < dwell)
+    return a->level;
+
+  // Com falling os valores e limites trocam de sinal: a mesma comparação vale nos dois sentidos
+  int32_t v = cfg->falling ? -(int32_t)value : value;
+  int32_t sign = cfg->falling ? -1 : 1;
+  uint8_t level = a->level;
+
+  while (level < cfg->levels && v >= sign * limits[level])
+    ++level;
+  while (level > 0 && v < sign * limits[level - 1] - cfg->hysteresis)
+    --level;
+
+  actuator_set(a, level, now_ms);
+  return a->level;
+}
+
+void actuator_force(actuator_t *a, uint8_t level) {
+  // Não conta como troca nem reinicia o tempo mínimo: ao sair da pré-visualização o nível medido
+  // volta na primeira avaliação
+  a->level = level > a->cfg->levels ? a->cfg->levels : level;
+}
+
+void actuator_output(actuator_t *a, uint32_t now_ms) {
+  const actuator_config_t *cfg = a->cfg;
+  uint16_t target = cfg->pwm[a->level];
+  uint32_t elapsed = now_ms - a->output_ms;
+  uint16_t pwm = target;
+
+  if (cfg->ramp_per_ms) {
+    uint32_t step = elapsed * cfg->ramp_per_ms;
+
+    if (target > a->pwm && (uint32_t)(target - a->pwm) > step)
+      pwm = a->pwm + step;
+    else if (target < a->pwm && (uint32_t)(a->pwm - target) > step)
+      pwm = a->pwm - step;
+  }
+  if (pwm == a->pwm) {
+    if (pwm == target)
+      a->output_ms = now_ms; // Parado no alvo: a próxima rampa conta a partir daqui
+    return; // Chamado no mesmo ms: o tempo acumula até dar um passo
+  }
+  a->output_ms = now_ms;
+  a->pwm = pwm;
+  ++a->writes;
+  pwm_set_gpio_level(cfg->gpio, pwm);
+}
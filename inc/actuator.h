@@ -0,0 +1,43 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+#define ACTUATOR_MAX_LEVELS 3 // Níveis acima de desligado
+
+// Atuador de vários níveis com saída PWM. O nível sobe quando o valor alcança o limite do próximo
+// nível e só desce quando o valor volta além do limite menos a histerese; depois de uma mudança o
+// nível fica parado pelo tempo mínimo configurado. A saída anda em rampa até o PWM do nível.
+typedef struct {
+  uint gpio;              // Saída PWM
+  uint8_t levels;         // Níveis acima de desligado (limites passados para actuator_update)
+  bool falling;           // Liga quando o valor cai até o limite em vez de subir até ele
+  int16_t hysteresis;     // Banda abaixo (ou acima, se falling) de cada limite para descer de nível
+  uint16_t min_on_ms;     // Tempo mínimo em um nível ligado antes de mudar
+  uint16_t min_off_ms;    // Tempo mínimo desligado antes de ligar
+  uint16_t ramp_per_ms;   // Variação máxima do PWM por ms (0: muda de uma vez)
+  uint16_t pwm[ACTUATOR_MAX_LEVELS + 1]; // PWM de cada nível (pwm[0]: desligado)
+} actuator_config_t;
+
+typedef struct {
+  const actuator_config_t *cfg;
+  uint8_t level;          // Nível atual
+  uint32_t changed_ms;    // Última mudança de nível
+  uint16_t pwm;           // PWM aplicado (segue a rampa)
+  uint32_t output_ms;     // Última atualização da rampa
+  uint32_t switches;      // Mudanças de nível desde o início
+  uint32_t writes;        // Escritas no PWM desde o início
+} actuator_t;
+
+// Começa desligado, com a saída em pwm[0] e o tempo mínimo desligado contando a partir de now_ms
+void actuator_init(actuator_t *a, const actuator_config_t *cfg, uint32_t now_ms);
+
+// Avalia o nível para o valor medido; limits tem cfg->levels limites, um por nível ligado.
+// Retorna o nível atual.
+uint8_t actuator_update(actuator_t *a, int16_t value, const int16_t *limits, uint32_t now_ms);
+
+// Coloca o atuador em um nível sem histerese nem tempo mínimo (pré-visualização nas telas de
+// configuração)
+void actuator_force(actuator_t *a, uint8_t level);
+
+// Avança a rampa da saída até o PWM do nível atual; só escreve no PWM quando o valor muda
+void actuator_output(actuator_t *a, uint32_t now_ms);
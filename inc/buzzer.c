@@ -0,0 +1,106 @@
+#include "buzzer.h"
+#include "spsc.h"
+#include "hardware/pwm.h"
+#include "hardware/sync.h"
+
+// Menor divisor inteiro que deixa o wrap em 16 bits (mais resolução na frequência) e o wrap
+// correspondente, com a frequência em centésimos de Hz
+#define NOTE_DIV(chz) (BUZZER_SYS_HZ * 100 / ((chz) * 65536ull) + 1)
+#define NOTE_WRAP(chz) (BUZZER_SYS_HZ * 100 / (NOTE_DIV(chz) * (chz)) - 1)
+#define NOTE(chz) { NOTE_DIV(chz), NOTE_WRAP(chz) }
+
+typedef struct {
+  uint8_t div;
+  uint16_t wrap;
+} note_pwm_t;
+
+static const note_pwm_t notes[NOTE_COUNT] = {
+  [NOTE_C4] = NOTE(26163), [NOTE_D4] = NOTE(29366), [NOTE_E4] = NOTE(32963),
+  [NOTE_F4] = NOTE(34923), [NOTE_G4] = NOTE(39200), [NOTE_A4] = NOTE(44000),
+  [NOTE_B4] = NOTE(49388), [NOTE_C5] = NOTE(52325), [NOTE_D5] = NOTE(58733),
+  [NOTE_E5] = NOTE(65926), [NOTE_F5] = NOTE(69846), [NOTE_G5] = NOTE(78399),
+  [NOTE_A5] = NOTE(88000), [NOTE_B5] = NOTE(98777),
+};
+
+static uint buzzer_gpio[BUZZER_MAX];
+static uint8_t buzzer_count;
+
+// Laço principal -> alarme
+static buzzer_step_t step_slots[BUZZER_QUEUE];
+static spsc_t step_queue;
+static volatile bool playing;
+static int8_t sounding = -1; // Buzzer ligado pelo passo atual (-1: nenhum)
+
+void buzzer_init(const uint *gpios, uint8_t count) {
+  buzzer_count = count > BUZZER_MAX ? BUZZER_MAX : count;
+  spsc_init(&step_queue, step_slots, sizeof(buzzer_step_t), BUZZER_QUEUE);
+
+  for (uint8_t i = 0; i < buzzer_count; ++i) {
+    uint slice = pwm_gpio_to_slice_num(gpios[i]);
+
+    buzzer_gpio[i] = gpios[i];
+    gpio_set_function(gpios[i], GPIO_FUNC_PWM);
+    pwm_set_clkdiv_int_frac(slice, notes[NOTE_C4].div, 0);
+    pwm_set_wrap(slice, notes[NOTE_C4].wrap);
+    pwm_set_gpio_level(gpios[i], 0);
+    pwm_set_enabled(slice, true);
+  }
+}
+
+uint32_t buzzer_advance(void) {
+  buzzer_step_t step;
+
+  if (sounding >= 0) {
+    pwm_set_gpio_level(buzzer_gpio[sounding], 0);
+    sounding = -1;
+  }
+  if (!spsc_pop(&step_queue, &step)) {
+    playing = false;
+    return 0;
+  }
+  playing = true;
+
+  if (step.note != NOTE_REST && step.note < NOTE_COUNT && step.buzzer < buzzer_count) {
+    const note_pwm_t *n = &notes[step.note];
+    uint slice = pwm_gpio_to_slice_num(buzzer_gpio[step.buzzer]);
+
+    // Divisor e wrap têm buffer duplo no PWM: a nota muda no fim do período em andamento
+    pwm_set_clkdiv_int_frac(slice, n->div, 0);
+    pwm_set_wrap(slice, n->wrap);
+    pwm_set_gpio_level(buzzer_gpio[step.buzzer], ((uint32_t)n->wrap + 1) * step.duty >> 8);
+    sounding = step.buzzer;
+  }
+  // Um passo de duração 0 ainda precisa de um alarme para o próximo
+  return step.duration_ms ? step.duration_ms * 1000u : 1;
+}
+
+static int64_t buzzer_alarm(alarm_id_t id, void *user_data) {
+  uint32_t us = buzzer_advance();
+
+  // Negativo: conta a partir do horário em que o alarme deveria ter disparado, sem acumular atraso
+  return us ? -(int64_t)us : 0;
+}
+
+bool buzzer_play(const buzzer_step_t *steps, uint8_t count) {
+  if (spsc_space(&step_queue) < count)
+    return false;
+  for (uint8_t i = 0; i < count; ++i)
+    spsc_push(&step_queue, &steps[i]);
+
+  // O alarme roda neste núcleo: com as interrupções desligadas ele não pode terminar a fila
+  // entre o teste e o início da reprodução
+  uint32_t irq = save_and_disable_interrupts();
+  uint32_t us = playing ? 0 : buzzer_advance();
+  restore_interrupts(irq);
+
+  if (us && add_alarm_in_us(us, buzzer_alarm, NULL, true) < 0) {
+    // Sem alarme disponível: descarta a sequência em vez de deixar o buzzer ligado
+    while (buzzer_advance())
+      ;
+  }
+  return true;
+}
+
+bool buzzer_playing(void) {
+  return playing;
+}
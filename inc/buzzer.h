@@ -0,0 +1,40 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+#define BUZZER_MAX 2         // Buzzers tratados pelo módulo
+#define BUZZER_QUEUE 16      // Passos aguardando para tocar (potência de 2)
+#define BUZZER_SYS_HZ 125000000ull // Clock do sistema usado no cálculo dos divisores das notas
+
+// Notas com divisor e wrap do PWM pré-calculados (NOTE_REST é silêncio)
+typedef enum {
+  NOTE_REST,
+  NOTE_C4, NOTE_D4, NOTE_E4, NOTE_F4, NOTE_G4, NOTE_A4, NOTE_B4,
+  NOTE_C5, NOTE_D5, NOTE_E5, NOTE_F5, NOTE_G5, NOTE_A5, NOTE_B5,
+  NOTE_COUNT
+} buzzer_note_t;
+
+// Um passo da sequência: toca uma nota em um buzzer e silencia o buzzer do passo anterior
+typedef struct {
+  uint8_t buzzer;       // Índice do buzzer na tabela passada para buzzer_init
+  uint8_t note;         // buzzer_note_t
+  uint8_t duty;         // Ciclo de trabalho em 1/256 (128 = 50%)
+  uint16_t duration_ms;
+} buzzer_step_t;
+
+// Configura o PWM dos buzzers (desligados) e a fila de passos
+void buzzer_init(const uint *gpios, uint8_t count);
+
+// Enfileira os passos e começa a tocar se estiver parado, sem esperar o som terminar. Chamar sempre
+// do núcleo que executou buzzer_init (o alarme que avança os passos roda nele). Retorna false se a
+// fila não tiver espaço para a sequência inteira (nada é enfileirado).
+bool buzzer_play(const buzzer_step_t *steps, uint8_t count);
+
+#define buzzer_play_pattern(pattern) buzzer_play((pattern), sizeof(pattern) / sizeof((pattern)[0]))
+
+// Há uma sequência tocando
+bool buzzer_playing(void);
+
+// Silencia o passo atual e aplica o próximo; retorna a duração dele em us, ou 0 se a fila acabou
+// (usado pelo alarme e por simulações)
+uint32_t buzzer_advance(void);
@@ -0,0 +1,77 @@
+#include "calib.h"
+
+void calib_set(calib_t *c, uint16_t low, uint16_t middle_low, uint16_t middle_high, uint16_t high,
+               int16_t out_min, int16_t out_max) {
+  int32_t q_min = (int32_t)out_min << CALIB_FRAC_BITS;
+  int32_t q_max = (int32_t)out_max << CALIB_FRAC_BITS;
+  // Centro inteiro: um valor médio em x.5 (-15..50 dá 17.5) ficaria trocando entre os dois inteiros
+  // vizinhos com o ruído do joystick parado no meio, principalmente com a zona morta estreita
+  int32_t q_mid = (((int32_t)out_min + out_max) / 2) << CALIB_FRAC_BITS;
+
+  c->out_min = out_min;
+  c->out_max = out_max;
+
+  // Eixo invertido: percorre os pontos do alto para o baixo para mantê-los em ordem crescente
+  if (low > high) {
+    uint16_t t = low;
+    low = high;
+    high = t;
+    t = middle_low;
+    middle_low = middle_high;
+    middle_high = t;
+    int32_t q = q_min;
+    q_min = q_max;
+    q_max = q;
+  }
+
+  // O centro precisa estar dentro dos extremos e com o início antes do fim
+  if (middle_low > middle_high) {
+    uint16_t t = middle_low;
+    middle_low = middle_high;
+    middle_high = t;
+  }
+  if (middle_low < low)
+    middle_low = low;
+  if (middle_high > high)
+    middle_high = high;
+  if (middle_low > high)
+    middle_low = high;
+  if (middle_high < low)
+    middle_high = low;
+
+  c->point[0] = low;
+  c->point[1] = middle_low;
+  c->point[2] = middle_high;
+  c->point[3] = high;
+  c->base[0] = q_min;
+  c->base[1] = q_mid;
+  c->base[2] = q_mid;
+  c->base[3] = q_max;
+
+  // Únicas divisões da curva: inclinação de cada trecho em Q32, arredondada para o mais próximo.
+  // Com 16 bits além do Q16 o erro acumulado em 4095 códigos fica bem abaixo de meia unidade Q16
+  for (uint8_t i = 0; i < 3; ++i) {
+    int32_t width = c->point[i + 1] - c->point[i];
+    // Diferença já em 64 bits: com a faixa toda do int16 ela não cabe em 32
+    int64_t rise = ((int64_t)c->base[i + 1] - c->base[i]) << 16;
+    int64_t slope = 0;
+    if (width)
+      slope = (rise + (rise < 0 ? -width / 2 : width / 2)) / width;
+    c->slope[i] = (int32_t)(slope >> 16);
+    c->slope_frac[i] = (uint16_t)slope;
+  }
+}
+
+int32_t calib_apply_q16(const calib_t *c, uint16_t code) {
+  uint8_t i;
+
+  if (code <= c->point[0])
+    return c->base[0];
+  if (code >= c->point[3])
+    return c->base[3];
+
+  i = code < c->point[1] ? 0 : code < c->point[2] ? 1 : 2;
+  // Multiplicação e deslocamento: duas multiplicações de 32 bits no lugar de uma divisão
+  int32_t dx = code - c->point[i];
+  return c->base[i] + dx * c->slope[i] + (int32_t)(((uint32_t)dx * c->slope_frac[i] + 0x8000) >> 16);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+
+#define CALIB_FRAC_BITS 16 // Saída em ponto fixo Q16
+
+// Curva de calibração de um eixo: converte o código do ADC em um valor entre out_min e out_max
+// por três trechos lineares (extremo baixo -> início do centro, zona morta no centro com o valor
+// médio arredondado para inteiro, fim do centro -> extremo alto). As inclinações são calculadas só quando a calibração muda.
+typedef struct {
+  uint16_t point[4]; // Códigos do ADC dos pontos da curva, em ordem crescente
+  int32_t base[4];   // Saída em Q16 em cada ponto
+  int32_t slope[3];  // Inclinação de cada trecho em Q16 por código do ADC (parte inteira)
+  uint16_t slope_frac[3]; // 16 bits a mais da inclinação, para o arredondamento sair exato
+  int16_t out_min, out_max;
+} calib_t;
+
+// Recalcula a curva a partir dos valores capturados na calibração; low e high podem estar em
+// qualquer ordem (eixo invertido) e o centro é ajustado para ficar entre eles
+void calib_set(calib_t *c, uint16_t low, uint16_t middle_low, uint16_t middle_high, uint16_t high,
+               int16_t out_min, int16_t out_max);
+
+// Valor calibrado em Q16, limitado a [out_min, out_max]
+int32_t calib_apply_q16(const calib_t *c, uint16_t code);
+
+// Valor calibrado arredondado para o inteiro mais próximo
+static inline int calib_apply(const calib_t *c, uint16_t code) {
+  return (calib_apply_q16(c, code) + (1 << (CALIB_FRAC_BITS - 1))) >> CALIB_FRAC_BITS;
+}
@@ -0,0 +1,153 @@
+#include "calibrator.h"
+
+// Compara instantes em ms, funcionando mesmo quando o contador dá a volta
+static bool calibrator_reached(uint32_t now_ms, uint32_t when_ms) {
+  return (int32_t)(now_ms - when_ms) >= 0;
+}
+
+// Raiz quadrada inteira (bit a bit, sem divisões)
+static uint32_t calibrator_isqrt(uint64_t value) {
+  uint64_t root = 0;
+  uint64_t bit = 1ull << 62;
+
+  while (bit > value)
+    bit >>= 2;
+  while (bit) {
+    if (value >= root + bit) {
+      value -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (uint32_t)root;
+}
+
+void calibrator_init(calibrator_t *cal, const calibrator_step_t *steps, uint8_t step_count,
+                     uint32_t settle_ms, uint16_t samples, uint32_t interval_ms, uint16_t max_stddev,
+                     uint16_t (*read)(uint8_t input)) {
+  cal->steps = steps;
+  cal->step_count = step_count > CALIBRATOR_MAX_STEPS ? CALIBRATOR_MAX_STEPS : step_count;
+  cal->settle_ms = settle_ms;
+  cal->samples = samples;
+  cal->interval_ms = interval_ms;
+  cal->max_stddev = max_stddev;
+  cal->read = read;
+  cal->state = CALIBRATOR_IDLE;
+  cal->started = false;
+  cal->aborted = false;
+}
+
+// Começa um passo: marca o fim da espera
+static void calibrator_begin_step(calibrator_t *cal, uint8_t step, uint32_t now_ms) {
+  cal->step = step;
+  cal->state = CALIBRATOR_SETTLE;
+  cal->next_ms = now_ms + cal->settle_ms;
+}
+
+// Começa a coleta do passo: zera as estatísticas
+static void calibrator_begin_collect(calibrator_t *cal, uint32_t now_ms) {
+  calibrator_stats_t *s = &cal->stats[cal->step];
+
+  cal->state = CALIBRATOR_COLLECT;
+  cal->next_ms = now_ms;
+  cal->mean_q = 0;
+  cal->m2_q = 0;
+  s->min = UINT16_MAX;
+  s->max = 0;
+  s->mean = 0;
+  s->stddev = 0;
+  s->count = 0;
+}
+
+// Acrescenta uma amostra: extremos e média e soma dos quadrados dos desvios pelo método de Welford,
+// que não acumula somas crescentes nem perde precisão com um nível alto e pouco ruído
+static void calibrator_add_sample(calibrator_t *cal, uint16_t value) {
+  calibrator_stats_t *s = &cal->stats[cal->step];
+  int32_t x = (int32_t)value << CALIBRATOR_FRAC_BITS;
+  int32_t delta = x - cal->mean_q;
+  int32_t n = ++s->count;
+
+  if (value < s->min)
+    s->min = value;
+  if (value > s->max)
+    s->max = value;
+  cal->mean_q += (delta + (delta < 0 ? -n / 2 : n / 2)) / n;
+  int64_t m2 = (int64_t)delta * (x - cal->mean_q);
+  // Com a média arredondada o termo pode sair um pouco negativo quando a amostra está na média
+  if (m2 > 0 || (uint64_t)-m2 <= cal->m2_q)
+    cal->m2_q += m2;
+  else
+    cal->m2_q = 0;
+  s->mean = (uint16_t)((cal->mean_q + (1 << (CALIBRATOR_FRAC_BITS - 1))) >> CALIBRATOR_FRAC_BITS);
+}
+
+// Fecha o passo com o desvio padrão arredondado: variância em Q16, raiz em Q8
+static void calibrator_finish_step(calibrator_t *cal) {
+  calibrator_stats_t *s = &cal->stats[cal->step];
+  uint32_t root = calibrator_isqrt(cal->m2_q / s->count);
+
+  s->stddev = (uint16_t)((root + (1 << (CALIBRATOR_FRAC_BITS - 1))) >> CALIBRATOR_FRAC_BITS);
+}
+
+void calibrator_start(calibrator_t *cal, uint32_t now_ms) {
+  if (!cal->step_count)
+    return;
+  calibrator_begin_step(cal, 0, now_ms);
+  cal->started = true;
+  cal->aborted = false;
+}
+
+void calibrator_abort(calibrator_t *cal) {
+  if (calibrator_running(cal))
+    cal->aborted = true;
+}
+
+calibrator_event_t calibrator_tick(calibrator_t *cal, uint32_t now_ms) {
+  if (!calibrator_running(cal))
+    return CALIBRATOR_EV_NONE;
+
+  if (cal->aborted) {
+    cal->state = CALIBRATOR_IDLE;
+    cal->aborted = false;
+    return CALIBRATOR_EV_ABORTED;
+  }
+
+  if (cal->started) {
+    cal->started = false;
+    return CALIBRATOR_EV_PROMPT;
+  }
+
+  if (!calibrator_reached(now_ms, cal->next_ms))
+    return CALIBRATOR_EV_NONE;
+
+  if (cal->state == CALIBRATOR_SETTLE)
+    calibrator_begin_collect(cal, now_ms);
+
+  // Coleta no máximo uma amostra por tick, no ritmo de interval_ms
+  calibrator_add_sample(cal, cal->read(cal->steps[cal->step].input));
+  cal->next_ms += cal->interval_ms;
+  if (cal->stats[cal->step].count < cal->samples)
+    return CALIBRATOR_EV_NONE;
+
+  // Joystick mexendo durante a coleta: os extremos não representam a posição, o passo recomeça
+  calibrator_finish_step(cal);
+  if (cal->max_stddev && cal->stats[cal->step].stddev > cal->max_stddev) {
+    calibrator_begin_step(cal, cal->step, now_ms);
+    return CALIBRATOR_EV_RETRY;
+  }
+
+  if (cal->step + 1 < cal->step_count) {
+    calibrator_begin_step(cal, cal->step + 1, now_ms);
+    return CALIBRATOR_EV_PROMPT;
+  }
+
+  // Só grava os resultados com a sequência inteira concluída
+  for (uint8_t i = 0; i < cal->step_count; ++i) {
+    const calibrator_stats_t *r = &cal->stats[i];
+    *cal->steps[i].result = cal->steps[i].keep == CALIBRATOR_KEEP_MIN ? r->min : r->max;
+  }
+  cal->state = CALIBRATOR_IDLE;
+  return CALIBRATOR_EV_DONE;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CALIBRATOR_MAX_STEPS 8 // Passos de uma sequência de calibração
+#define CALIBRATOR_FRAC_BITS 8 // Média e desvio acumulados em ponto fixo Q8
+
+// O que guardar das amostras de um passo
+typedef enum {
+  CALIBRATOR_KEEP_MIN, // Menor valor lido
+  CALIBRATOR_KEEP_MAX, // Maior valor lido
+} calibrator_keep_t;
+
+// Um passo da sequência: avisa o usuário, espera o joystick assentar e coleta as amostras
+typedef struct {
+  uint8_t prompt;         // Aviso mostrado durante o passo (quem chama decide o que é, ex.: quadro da matriz)
+  uint8_t input;          // Entrada lida pela função de leitura
+  calibrator_keep_t keep;
+  uint16_t *result;       // Onde o valor é guardado quando a sequência termina sem ser abortada
+} calibrator_step_t;
+
+// Estatísticas das amostras de um passo, zeradas quando a coleta do passo começa (depois de um
+// CALIBRATOR_EV_RETRY ainda mostram a tentativa rejeitada). mean é atualizada a cada amostra;
+// stddev (desvio padrão da população) só no fim do passo
+typedef struct {
+  uint16_t min, max, mean, stddev;
+  uint16_t count;
+} calibrator_stats_t;
+
+typedef enum {
+  CALIBRATOR_IDLE,    // Parado (nunca iniciado, concluído ou abortado)
+  CALIBRATOR_SETTLE,  // Aviso mostrado, esperando o usuário posicionar o joystick
+  CALIBRATOR_COLLECT, // Coletando amostras do passo atual
+} calibrator_state_t;
+
+// Eventos retornados por calibrator_tick
+typedef enum {
+  CALIBRATOR_EV_NONE,
+  CALIBRATOR_EV_PROMPT, // Começou um passo: mostrar o aviso de calibrator_prompt()
+  CALIBRATOR_EV_DONE,   // Sequência concluída e resultados gravados
+  CALIBRATOR_EV_ABORTED,
+  CALIBRATOR_EV_RETRY,  // Leituras do passo instáveis demais: o passo recomeça, mostrar o aviso de novo
+} calibrator_event_t;
+
+typedef struct {
+  const calibrator_step_t *steps;
+  uint8_t step_count;
+  uint32_t settle_ms;       // Espera depois do aviso de cada passo
+  uint32_t interval_ms;     // Intervalo entre amostras
+  uint16_t samples;         // Amostras por passo
+  uint16_t max_stddev;      // Desvio padrão acima do qual o passo é repetido (0: aceita qualquer)
+  uint16_t (*read)(uint8_t input);
+
+  calibrator_state_t state;
+  uint8_t step;
+  bool started;             // Falta anunciar o primeiro passo
+  bool aborted;             // Abortar no próximo tick
+  uint32_t next_ms;         // Próximo instante de troca de estado ou de amostra
+  int32_t mean_q;           // Média do passo em Q8 (Welford)
+  uint64_t m2_q;            // Soma dos quadrados dos desvios em Q16
+  calibrator_stats_t stats[CALIBRATOR_MAX_STEPS];
+} calibrator_t;
+
+void calibrator_init(calibrator_t *cal, const calibrator_step_t *steps, uint8_t step_count,
+                     uint32_t settle_ms, uint16_t samples, uint32_t interval_ms, uint16_t max_stddev,
+                     uint16_t (*read)(uint8_t input));
+
+// Inicia a sequência; o primeiro aviso sai no próximo calibrator_tick
+void calibrator_start(calibrator_t *cal, uint32_t now_ms);
+
+// Pede para abortar; os resultados anteriores são mantidos
+void calibrator_abort(calibrator_t *cal);
+
+// Avança a máquina de estados; chamar a cada volta do laço principal (nunca bloqueia)
+calibrator_event_t calibrator_tick(calibrator_t *cal, uint32_t now_ms);
+
+static inline bool calibrator_running(const calibrator_t *cal) {
+  return cal->state != CALIBRATOR_IDLE;
+}
+
+// Aviso do passo atual
+static inline uint8_t calibrator_prompt(const calibrator_t *cal) {
+  return cal->steps[cal->step].prompt;
+}
@@ -0,0 +1,69 @@
+#include "filter.h"
+#include "sampler.h"
+
+void filter_init(filter_t *f, const filter_config_t *config, uint8_t input) {
+  f->config = config;
+  f->input = input;
+  filter_reset(f);
+}
+
+void filter_reset(filter_t *f) {
+  f->head = 0;
+  f->filled = 0;
+  f->ema = 0;
+  f->primed = false;
+}
+
+// Mediana da janela por inserção em uma cópia ordenada (no máximo 5 elementos)
+static uint16_t filter_median(const filter_t *f) {
+  uint16_t sorted[FILTER_MEDIAN_MAX];
+
+  for (uint8_t i = 0; i < f->filled; ++i) {
+    uint16_t v = f->window[i];
+    uint8_t j = i;
+    for (; j > 0 && sorted[j - 1] > v; --j)
+      sorted[j] = sorted[j - 1];
+    sorted[j] = v;
+  }
+  return sorted[f->filled / 2];
+}
+
+uint16_t filter_step(filter_t *f, uint16_t sample_q4) {
+  const filter_config_t *cfg = f->config;
+  uint16_t value = sample_q4;
+
+  if (cfg->median_len > 1) {
+    f->window[f->head] = value;
+    if (++f->head >= cfg->median_len)
+      f->head = 0;
+    if (f->filled < cfg->median_len)
+      ++f->filled;
+    value = filter_median(f);
+  }
+
+  // O acumulador guarda a saída deslocada de ema_shift bits, então o arredondamento não se acumula
+  if (!f->primed) {
+    f->ema = (uint32_t)value << cfg->ema_shift;
+    f->primed = true;
+  } else {
+    f->ema += value - (f->ema >> cfg->ema_shift);
+  }
+  return filter_output(f);
+}
+
+uint16_t filter_update(filter_t *f) {
+  uint8_t bits = f->config->oversample_bits;
+  if (bits > FILTER_OVERSAMPLE_MAX)
+    bits = FILTER_OVERSAMPLE_MAX;
+  while (bits && (1u << (2 * bits)) > sampler_depth()) // Com muitas entradas o anel guarda menos amostras de cada
+    --bits;
+
+  // A soma de 4^bits amostras já é a média em Q(2 * bits); desloca para Q4 sem dividir
+  uint32_t sum = sampler_sum(f->input, 1u << (2 * bits));
+  filter_step(f, sum << (FILTER_FRAC_BITS - 2 * bits));
+  return filter_value(f);
+}
+
+uint16_t filter_output(const filter_t *f) {
+  return f->ema >> f->config->ema_shift;
+}
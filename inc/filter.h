@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define FILTER_FRAC_BITS 4   // O filtro trabalha com o código do ADC em ponto fixo Q4 (código * 16)
+#define FILTER_OVERSAMPLE_MAX 2 // Até 4^2 = 16 amostras por leitura (2 bits a mais de resolução)
+#define FILTER_MEDIAN_MAX 5  // Maior janela da mediana
+
+// Etapas do filtro de uma entrada, aplicadas nesta ordem a cada leitura
+typedef struct {
+  uint8_t oversample_bits; // Soma 4^bits amostras do anel e decima para uma leitura com bits a mais
+  uint8_t median_len;      // Mediana das últimas leituras para descartar picos (1 desliga, máximo 5, ímpar)
+  uint8_t ema_shift;       // Média móvel exponencial com alfa = 1 / 2^shift (0 desliga)
+} filter_config_t;
+
+// Estado do filtro de uma entrada do ADC
+typedef struct {
+  const filter_config_t *config;
+  uint8_t input;                        // Entrada do sampler
+  uint8_t head, filled;                 // Janela circular da mediana
+  uint16_t window[FILTER_MEDIAN_MAX];   // Últimas leituras decimadas (Q4)
+  uint32_t ema;                         // Acumulador da EMA: saída << ema_shift
+  bool primed;                          // false até a primeira leitura inicializar a EMA
+} filter_t;
+
+void filter_init(filter_t *f, const filter_config_t *config, uint8_t input);
+void filter_reset(filter_t *f);
+
+// Passa uma leitura pelo filtro e retorna a saída em Q4
+uint16_t filter_step(filter_t *f, uint16_t sample_q4);
+
+// Lê o bloco mais recente da entrada no sampler, filtra e retorna o código do ADC (12 bits, arredondado)
+uint16_t filter_update(filter_t *f);
+
+// Última saída do filtro em Q4, sem ler novas amostras
+uint16_t filter_output(const filter_t *f);
+
+// Última saída do filtro como código do ADC (12 bits, arredondado), sem ler novas amostras
+static inline uint16_t filter_value(const filter_t *f) {
+  return (filter_output(f) + (1u << (FILTER_FRAC_BITS - 1))) >> FILTER_FRAC_BITS;
+}
@@ -0,0 +1,69 @@
+#include "fmt.h"
+
+// Formatação de inteiros sem printf: escreve os caracteres em dst e retorna o ponteiro para
+// depois do último escrito (sem terminador, quem chama coloca o '\0' no final).
+
+// O M0+ não tem instrução de divisão: value / 10 vira uma chamada a __aeabi_uidiv, que no RP2040
+// usa o divisor do SIO. Abaixo deste limite value / 10 é exatamente (value * 0xCCCD) >> 19 com o
+// produto em 32 bits (uma multiplicação de um ciclo), o que cobre todos os números da tela
+#define FMT_RECIPROCAL_MAX 81920u
+
+// Escreve os dígitos de trás para frente em um buffer temporário
+static uint8_t fmt_digits(char *tmp, uint32_t value) {
+  uint8_t n = 0;
+  while (value >= FMT_RECIPROCAL_MAX) {
+    uint32_t q = value / 10;
+    tmp[n++] = '0' + (value - q * 10);
+    value = q;
+  }
+  do {
+    uint32_t q = (value * 0xCCCDu) >> 19;
+    tmp[n++] = '0' + (value - q * 10);
+    value = q;
+  } while (value);
+  return n;
+}
+
+// Número sem sinal alinhado à direita em "width" caracteres, completando com espaços (como "%*u")
+char *fmt_uint(char *dst, uint32_t value, uint8_t width) {
+  char tmp[10];
+  uint8_t n = fmt_digits(tmp, value);
+  while (width > n) {
+    *dst++ = ' ';
+    --width;
+  }
+  while (n)
+    *dst++ = tmp[--n];
+  return dst;
+}
+
+// Número com sinal alinhado à direita em "width" caracteres, com o '-' junto aos dígitos (como "%*d")
+char *fmt_int(char *dst, int32_t value, uint8_t width) {
+  char tmp[10];
+  uint32_t magnitude = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+  uint8_t n = fmt_digits(tmp, magnitude);
+  uint8_t len = n + (value < 0);
+  while (width > len) {
+    *dst++ = ' ';
+    --width;
+  }
+  if (value < 0)
+    *dst++ = '-';
+  while (n)
+    *dst++ = tmp[--n];
+  return dst;
+}
+
+// Copia um texto fixo
+char *fmt_str(char *dst, const char *src) {
+  while (*src)
+    *dst++ = *src++;
+  return dst;
+}
+
+// Repete um caractere "count" vezes
+char *fmt_fill(char *dst, char c, uint8_t count) {
+  while (count--)
+    *dst++ = c;
+  return dst;
+}
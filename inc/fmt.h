@@ -0,0 +1,8 @@
+#pragma once
+
+#include <stdint.h>
+
+char *fmt_uint(char *dst, uint32_t value, uint8_t width);
+char *fmt_int(char *dst, int32_t value, uint8_t width);
+char *fmt_str(char *dst, const char *src);
+char *fmt_fill(char *dst, char c, uint8_t count);
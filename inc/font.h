@@ -2,7 +2,7 @@
 // Fontes para A-Z e 0-9. Os caracteres tem 8x8 pixels
 
 
-static uint8_t font[] = {
+static const uint8_t font[] = {
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // Nothing
 0x3e, 0x7f, 0x71, 0x59, 0x4d, 0x7f, 0x3e, 0x00, //0
 0x40, 0x42, 0x7f, 0x7f, 0x40, 0x40, 0x00, 0x00, //1
@@ -72,3 +72,17 @@ static uint8_t font[] = {
 0x46, 0x66, 0x30, 0x18, 0x0c, 0x66, 0x62, 0x00, //%
 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00  //-
 };
+
+#define FONT_GLYPH_BLANK 0    // Glifo vazio (espaço)
+#define FONT_GLYPH_UNKNOWN 64 // Glifo usado para caracteres sem desenho na fonte ('?')
+
+// Tabela de tradução de caractere para glifo, montada em tempo de compilação.
+// Entradas não listadas ficam em 0 e são tratadas como caracteres desconhecidos.
+static const uint8_t font_index[256] = {
+  ['0'] = 1, ['1'] = 2, ['2'] = 3, ['3'] = 4, ['4'] = 5, ['5'] = 6, ['6'] = 7, ['7'] = 8, ['8'] = 9, ['9'] = 10,
+  ['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16, ['G'] = 17, ['H'] = 18, ['I'] = 19, ['J'] = 20, ['K'] = 21, ['L'] = 22, ['M'] = 23,
+  ['N'] = 24, ['O'] = 25, ['P'] = 26, ['Q'] = 27, ['R'] = 28, ['S'] = 29, ['T'] = 30, ['U'] = 31, ['V'] = 32, ['W'] = 33, ['X'] = 34, ['Y'] = 35, ['Z'] = 36,
+  ['a'] = 37, ['b'] = 38, ['c'] = 39, ['d'] = 40, ['e'] = 41, ['f'] = 42, ['g'] = 43, ['h'] = 44, ['i'] = 45, ['j'] = 46, ['k'] = 47, ['l'] = 48, ['m'] = 49,
+  ['n'] = 50, ['o'] = 51, ['p'] = 52, ['q'] = 53, ['r'] = 54, ['s'] = 55, ['t'] = 56, ['u'] = 57, ['v'] = 58, ['w'] = 59, ['x'] = 60, ['y'] = 61, ['z'] = 62,
+  [':'] = 63, ['?'] = 64, ['*'] = 65, ['%'] = 66, ['-'] = 67,
+};
@@ -0,0 +1,153 @@
+#include "input.h"
+#include "spsc.h"
+#include "trace.h"
+
+// Borda aceita pela interrupção
+typedef struct {
+  uint32_t time_us;
+  uint8_t button;
+  bool pressed;
+} input_edge_t;
+
+// Estado de um botão visto pelo laço principal
+typedef struct {
+  bool pressed;
+  bool long_sent;          // INPUT_LONG_PRESS já gerado neste toque
+  bool has_last_press;     // Há um toque anterior que pode formar um toque duplo
+  uint32_t changed_us;     // Última mudança de estado
+  uint32_t last_press_us;  // Último toque, para o toque duplo
+} input_state_t;
+
+static const input_config_t *input_buttons;
+static uint8_t input_count;
+
+// Interrupção -> laço principal
+static input_edge_t input_edge_slots[INPUT_EDGE_QUEUE];
+static spsc_t input_edges;
+static uint32_t input_accepted_us[INPUT_MAX_BUTTONS]; // Última borda aceita (só a interrupção usa)
+
+// Estado e eventos do laço principal
+static input_state_t input_state[INPUT_MAX_BUTTONS];
+static input_event_t input_events[INPUT_EVENT_QUEUE];
+static uint8_t input_head, input_len;
+
+static void input_irq(uint gpio, uint32_t events) {
+  for (uint8_t i = 0; i < input_count; ++i) {
+    if (input_buttons[i].gpio == gpio) {
+      input_edge(i, !gpio_get(gpio), time_us_32());
+      return;
+    }
+  }
+}
+
+void input_init(const input_config_t *buttons, uint8_t count) {
+  input_buttons = buttons;
+  input_count = count > INPUT_MAX_BUTTONS ? INPUT_MAX_BUTTONS : count;
+  input_head = 0;
+  input_len = 0;
+  spsc_init(&input_edges, input_edge_slots, sizeof(input_edge_t), INPUT_EDGE_QUEUE);
+
+  uint32_t now = time_us_32();
+  for (uint8_t i = 0; i < input_count; ++i) {
+    input_state_t *s = &input_state[i];
+    s->pressed = !gpio_get(buttons[i].gpio);
+    s->long_sent = s->pressed; // Um botão já segurado no boot não gera toque longo
+    s->has_last_press = false;
+    s->changed_us = now;
+    input_accepted_us[i] = now - buttons[i].debounce_ms * 1000u;
+    gpio_set_irq_enabled_with_callback(buttons[i].gpio, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, input_irq);
+  }
+}
+
+void input_edge(uint8_t button, bool pressed, uint32_t time_us) {
+  // Debounce por botão: um botão trepidando não bloqueia os outros
+  if (time_us - input_accepted_us[button] < input_buttons[button].debounce_ms * 1000u) {
+    trace_emit(TRACE_EDGE, button, pressed);
+    return;
+  }
+  input_accepted_us[button] = time_us;
+  trace_emit(TRACE_EDGE, button, pressed | 2);
+
+  input_edge_t edge = {time_us, button, pressed};
+  spsc_push(&input_edges, &edge);
+}
+
+// Enfileira um evento, agrupando com o último se for igual e ainda não tiver sido lido
+static void input_emit(uint8_t button, input_type_t type, uint32_t time_us) {
+  if (input_len) {
+    input_event_t *last = &input_events[(input_head + input_len - 1) % INPUT_EVENT_QUEUE];
+    if (last->button == button && last->type == type) {
+      if (last->count < UINT8_MAX)
+        ++last->count;
+      last->time_us = time_us;
+      return;
+    }
+  }
+  if (input_len == INPUT_EVENT_QUEUE) { // Fila cheia: descarta o mais antigo
+    input_head = (input_head + 1) % INPUT_EVENT_QUEUE;
+    --input_len;
+  }
+  input_events[(input_head + input_len) % INPUT_EVENT_QUEUE] = (input_event_t){time_us, button, type, 1};
+  ++input_len;
+}
+
+// Aplica uma mudança de estado do botão e gera os eventos correspondentes
+static void input_apply(uint8_t button, bool pressed, uint32_t time_us) {
+  const input_config_t *cfg = &input_buttons[button];
+  input_state_t *s = &input_state[button];
+
+  if (pressed == s->pressed) // Borda repetida (a outra foi filtrada pelo debounce)
+    return;
+  s->pressed = pressed;
+  s->changed_us = time_us;
+
+  if (!pressed) {
+    input_emit(button, INPUT_RELEASE, time_us);
+    return;
+  }
+
+  input_emit(button, INPUT_PRESS, time_us);
+  s->long_sent = false;
+  if (cfg->double_ms && s->has_last_press && time_us - s->last_press_us <= cfg->double_ms * 1000u) {
+    input_emit(button, INPUT_DOUBLE_PRESS, time_us);
+    s->has_last_press = false; // Um terceiro toque começa um novo par
+  } else {
+    s->has_last_press = true;
+    s->last_press_us = time_us;
+  }
+}
+
+void input_poll(uint32_t now_us) {
+  input_edge_t edge;
+
+  while (spsc_pop(&input_edges, &edge))
+    input_apply(edge.button, edge.pressed, edge.time_us);
+
+  for (uint8_t i = 0; i < input_count; ++i) {
+    const input_config_t *cfg = &input_buttons[i];
+    input_state_t *s = &input_state[i];
+
+    // Uma borda descartada pelo debounce pode deixar o estado errado; depois do debounce o nível
+    // do pino é a referência
+    if (now_us - s->changed_us >= cfg->debounce_ms * 1000u) {
+      bool level = !gpio_get(cfg->gpio);
+      if (level != s->pressed)
+        input_apply(i, level, now_us);
+    }
+
+    if (s->pressed && cfg->long_ms && !s->long_sent && now_us - s->changed_us >= cfg->long_ms * 1000u) {
+      s->long_sent = true;
+      s->has_last_press = false; // Toque longo não conta para o toque duplo
+      input_emit(i, INPUT_LONG_PRESS, now_us);
+    }
+  }
+}
+
+bool input_get(input_event_t *event) {
+  if (!input_len)
+    return false;
+  *event = input_events[input_head];
+  input_head = (input_head + 1) % INPUT_EVENT_QUEUE;
+  --input_len;
+  return true;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+#define INPUT_MAX_BUTTONS 4 // Botões tratados pelo módulo
+#define INPUT_EDGE_QUEUE 16 // Bordas aguardando input_poll
+#define INPUT_EVENT_QUEUE 8 // Eventos aguardando input_get
+
+// Configuração de um botão (ligado ao GND com pull-up: nível baixo = pressionado)
+typedef struct {
+  uint gpio;
+  uint16_t debounce_ms; // Bordas mais próximas que isso da última aceita são ignoradas
+  uint16_t long_ms;     // Tempo segurando para gerar INPUT_LONG_PRESS (0 desliga)
+  uint16_t double_ms;   // Janela entre dois toques para gerar INPUT_DOUBLE_PRESS (0 desliga)
+} input_config_t;
+
+typedef enum {
+  INPUT_PRESS,        // Botão pressionado (sempre gerado, sem esperar os gestos)
+  INPUT_RELEASE,      // Botão solto
+  INPUT_LONG_PRESS,   // Segurado por long_ms (uma vez por toque)
+  INPUT_DOUBLE_PRESS, // Segundo toque dentro de double_ms (além do INPUT_PRESS)
+} input_type_t;
+
+typedef struct {
+  uint32_t time_us; // Instante da borda (ou da detecção, no toque longo)
+  uint8_t button;   // Índice do botão na tabela passada para input_init
+  uint8_t type;     // input_type_t
+  uint8_t count;    // Eventos iguais seguidos que foram agrupados neste (pelo menos 1)
+} input_event_t;
+
+// Configura as interrupções de borda de descida e subida dos botões da tabela
+void input_init(const input_config_t *buttons, uint8_t count);
+
+// Processa as bordas registradas pelas interrupções e os tempos dos gestos; chamar periodicamente
+void input_poll(uint32_t now_us);
+
+// Retira o próximo evento
+bool input_get(input_event_t *event);
+
+// Registra uma borda como a interrupção faz (usado pela interrupção e por simulações)
+void input_edge(uint8_t button, bool pressed, uint32_t time_us);
@@ -0,0 +1,105 @@
+#include "prof.h"
+
+#if PROFILE
+
+#include <stdio.h>
+#include <string.h>
+#if !PICO_ON_DEVICE
+#include <time.h>
+#endif
+
+typedef struct {
+  uint32_t generation;         // Diferente de prof_generation: a tabela foi zerada desde a última medição
+  uint32_t count;
+  uint32_t min, max;
+  uint64_t sum;
+  uint32_t hist[PROF_BUCKETS];
+} prof_stage_t;
+
+static prof_stage_t prof_stages[PROF_CORES][PROF_MAX_STAGES];
+static const char *const *prof_names;
+static uint8_t prof_count;
+static volatile uint32_t prof_generation = 1; // As entradas começam em 0, ou seja, zeradas
+
+#if !PICO_ON_DEVICE
+uint32_t prof_ticks(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t) ts.tv_sec * 1000000000u + (uint32_t) ts.tv_nsec;
+}
+#endif
+
+void prof_start_core(void) {
+#if PICO_ON_DEVICE
+  systick_hw->csr = 0;
+  systick_hw->rvr = PROF_TICK_MASK;
+  systick_hw->cvr = 0;
+  systick_hw->csr = 0x5; // Liga, usando o clock do processador, sem interrupção
+#endif
+}
+
+void prof_init(const char *const *names, uint8_t count) {
+  prof_names = names;
+  prof_count = count > PROF_MAX_STAGES ? PROF_MAX_STAGES : count;
+  prof_start_core();
+}
+
+void prof_record(uint8_t stage, uint32_t ticks) {
+  prof_stage_t *s = &prof_stages[get_core_num()][stage];
+  uint32_t generation = prof_generation;
+
+  if (s->generation != generation) {
+    memset(s, 0, sizeof(*s));
+    s->generation = generation;
+    s->min = UINT32_MAX;
+  }
+  ++s->count;
+  s->sum += ticks;
+  if (ticks < s->min)
+    s->min = ticks;
+  if (ticks > s->max)
+    s->max = ticks;
+  ++s->hist[ticks > 1 ? 31 - __builtin_clz(ticks) : 0];
+}
+
+void prof_reset(void) {
+  prof_generation = prof_generation + 1;
+}
+
+// Linha de um estágio; retorna false se ele não foi medido desde o último prof_reset
+static bool prof_dump_stage(const prof_stage_t *s, const char *name, uint32_t generation) {
+  if (s->generation != generation || s->count == 0)
+    return false;
+  printf("%s %lu %lu %lu %lu |", name, (unsigned long) s->count, (unsigned long) s->min,
+         (unsigned long) (s->sum / s->count), (unsigned long) s->max);
+  for (uint8_t k = 0; k < PROF_BUCKETS; ++k) {
+    if (s->hist[k])
+      printf(" %u:%lu", k, (unsigned long) s->hist[k]);
+  }
+  printf("\n");
+  return true;
+}
+
+void prof_dump(void) {
+  uint32_t generation = prof_generation;
+
+  // A cópia pode cruzar uma medição do outro núcleo; para diagnóstico basta
+  printf("perfil (%s): estágio n mín média máx | 2^k:n\n", PROF_UNIT);
+  for (uint8_t i = 0; i < prof_count; ++i) {
+    if (!prof_dump_stage(&prof_stages[0][i], prof_names[i], generation))
+      printf("%s 0\n", prof_names[i]);
+  }
+  for (uint8_t core = 1; core < PROF_CORES; ++core) {
+    bool header = false;
+    for (uint8_t i = 0; i < prof_count; ++i) {
+      const prof_stage_t *s = &prof_stages[core][i];
+      if (!header && s->generation == generation && s->count) {
+        printf("núcleo %u:\n", core);
+        header = true;
+      }
+      prof_dump_stage(s, prof_names[i], generation);
+    }
+  }
+}
+
+#endif
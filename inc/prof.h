@@ -0,0 +1,61 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+// Medição do tempo de cada estágio do laço (opção PROFILE do CMake). Com PROFILE = 0 as sondas não
+// geram código e a tabela não ocupa RAM.
+#ifndef PROFILE
+#define PROFILE 0
+#endif
+
+#define PROF_MAX_STAGES 8 // Estágios na tabela
+#define PROF_CORES 2      // Uma tabela por núcleo
+#define PROF_BUCKETS 32   // Histograma log2: o balde k conta durações em [2^k, 2^(k+1)) (o 0 inclui 0 e 1)
+
+#if PROFILE
+
+#if PICO_ON_DEVICE
+#include "hardware/structs/systick.h"
+
+// No Pico a unidade é o ciclo do processador (SysTick de 24 bits, que conta para baixo); um estágio
+// precisa durar menos que 2^24 ciclos (~134 ms a 125 MHz)
+#define PROF_UNIT "ciclos"
+#define PROF_TICK_MASK 0x00FFFFFFu
+static inline uint32_t prof_ticks(void) {
+  return ~systick_hw->cvr;
+}
+#else
+// No computador a unidade é o ns do relógio monotônico
+#define PROF_UNIT "ns"
+#define PROF_TICK_MASK 0xFFFFFFFFu
+uint32_t prof_ticks(void);
+#endif
+
+// stage é o nome de uma constante (a variável local do início é criada a partir dele); BEGIN e END
+// precisam estar no mesmo bloco e no mesmo núcleo. Cada núcleo grava na sua tabela, então o mesmo
+// estágio pode ser medido nos dois sem travas
+#define PROF_BEGIN(stage) uint32_t prof_start_##stage = prof_ticks()
+#define PROF_END(stage) prof_record((stage), (prof_ticks() - prof_start_##stage) & PROF_TICK_MASK)
+
+// Dá nome aos estágios e liga o contador no núcleo que chamou; chamar antes da primeira sonda
+void prof_init(const char *const *names, uint8_t count);
+
+// Liga o contador no núcleo que chamou (o SysTick é de cada núcleo); chamar no núcleo 1 se ele usa sondas
+void prof_start_core(void);
+
+// Acumula uma duração do estágio na tabela do núcleo que chamou
+void prof_record(uint8_t stage, uint32_t ticks);
+
+// Imprime mínimo, média, máximo e histograma de cada estágio medido desde o último prof_reset: a
+// tabela do núcleo 0 inteira e, se o núcleo 1 mediu algo, os estágios dele
+void prof_dump(void);
+
+// Zera a tabela; cada estágio é zerado pelo próprio núcleo na próxima medição, sem travas
+void prof_reset(void);
+
+#else
+
+#define PROF_BEGIN(stage) ((void) 0)
+#define PROF_END(stage) ((void) 0)
+
+#endif
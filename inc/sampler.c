@@ -0,0 +1,116 @@
+#include "sampler.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+
+// A DMA nunca para: cada rodada tem um número de transferências múltiplo do tamanho do anel e de
+// qualquer quantidade de entradas (1 a 5), então a posição no anel e a entrada de cada amostra
+// continuam as mesmas quando o canal de controle reinicia a contagem
+#define SAMPLER_RUN_LENGTH (SAMPLER_RING_LEN * 3u * 5u * 65536u)
+
+#define SAMPLER_ADC_CLOCK 48000000u // Clock do ADC; cada conversão leva no mínimo 96 ciclos
+
+static uint16_t sampler_ring[SAMPLER_RING_LEN] __attribute__((aligned(SAMPLER_RING_LEN * sizeof(uint16_t))));
+static const uint32_t sampler_run_length = SAMPLER_RUN_LENGTH;
+
+static int sampler_data_chan = -1; // Canal que copia a FIFO do ADC para o anel
+static int sampler_ctrl_chan = -1; // Canal que recarrega a contagem do canal de dados ao fim de cada rodada
+static uint8_t sampler_count;      // Entradas na varredura
+static uint8_t sampler_rank[SAMPLER_INPUTS]; // Posição de cada entrada na varredura
+
+bool sampler_init(uint8_t input_mask, uint32_t rate_hz) {
+  input_mask &= (1u << SAMPLER_INPUTS) - 1;
+  if (!input_mask || rate_hz == 0 || rate_hz > SAMPLER_ADC_CLOCK / 96)
+    return false;
+
+  // O round-robin percorre as entradas da máscara em ordem crescente, começando pela menor
+  uint8_t first = SAMPLER_INPUTS;
+  sampler_count = 0;
+  for (uint8_t i = 0; i < SAMPLER_INPUTS; ++i) {
+    sampler_rank[i] = sampler_count;
+    if (input_mask & (1u << i)) {
+      if (first == SAMPLER_INPUTS)
+        first = i;
+      ++sampler_count;
+    }
+  }
+
+  adc_run(false);
+  adc_set_temp_sensor_enabled(input_mask & (1u << SAMPLER_TEMP_SENSOR));
+  adc_select_input(first);
+  adc_set_round_robin(input_mask);
+  adc_fifo_setup(true, true, 1, false, false); // FIFO com DREQ a cada amostra, 12 bits sem flag de erro
+  adc_set_clkdiv((float)SAMPLER_ADC_CLOCK / rate_hz - 1);
+  adc_fifo_drain();
+
+  if (sampler_data_chan < 0) {
+    sampler_data_chan = dma_claim_unused_channel(true);
+    sampler_ctrl_chan = dma_claim_unused_channel(true);
+  }
+
+  // Canal de dados: FIFO do ADC -> anel, voltando ao início do anel a cada 2^SAMPLER_RING_BITS bytes
+  dma_channel_config c = dma_channel_get_default_config(sampler_data_chan);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+  channel_config_set_read_increment(&c, false);
+  channel_config_set_write_increment(&c, true);
+  channel_config_set_ring(&c, true, SAMPLER_RING_BITS);
+  channel_config_set_dreq(&c, DREQ_ADC);
+  channel_config_set_chain_to(&c, sampler_ctrl_chan);
+
+  // Canal de controle: escreve a contagem da rodada no registrador que também dispara o canal de dados
+  dma_channel_config k = dma_channel_get_default_config(sampler_ctrl_chan);
+  channel_config_set_transfer_data_size(&k, DMA_SIZE_32);
+  channel_config_set_read_increment(&k, false);
+  channel_config_set_write_increment(&k, false);
+  dma_channel_configure(sampler_ctrl_chan, &k, &dma_hw->ch[sampler_data_chan].al1_transfer_count_trig,
+                        &sampler_run_length, 1, false);
+
+  dma_channel_configure(sampler_data_chan, &c, sampler_ring, &adc_hw->fifo, SAMPLER_RUN_LENGTH, true);
+  adc_run(true);
+
+  // Espera o anel encher uma vez para que as primeiras leituras já sejam amostras reais
+  while (dma_hw->ch[sampler_data_chan].transfer_count > SAMPLER_RUN_LENGTH - SAMPLER_RING_LEN)
+    tight_loop_contents();
+  return true;
+}
+
+uint8_t sampler_depth(void) {
+  // Uma varredura de folga para a amostra mais antiga não ser sobrescrita durante a leitura
+  return SAMPLER_RING_LEN / sampler_count - 1;
+}
+
+// Índice (dentro da rodada) da amostra mais recente da entrada que já foi completamente escrita
+static uint32_t sampler_newest(uint8_t input) {
+  uint32_t written = SAMPLER_RUN_LENGTH - dma_hw->ch[sampler_data_chan].transfer_count;
+
+  // Ignora a amostra recém-contada (a escrita pode ainda estar em andamento) e volta até a entrada
+  // pedida; somar a rodada evita índices negativos logo depois da recarga
+  uint32_t index = written + SAMPLER_RUN_LENGTH - 2;
+  uint8_t rank = index % sampler_count;
+  uint8_t want = sampler_rank[input];
+  return index - (rank >= want ? rank - want : rank + sampler_count - want);
+}
+
+uint16_t sampler_latest(uint8_t input) {
+  return sampler_ring[sampler_newest(input) % SAMPLER_RING_LEN];
+}
+
+uint32_t sampler_sum(uint8_t input, uint8_t count) {
+  uint32_t index = sampler_newest(input);
+  uint32_t sum = 0;
+
+  if (count > sampler_depth())
+    count = sampler_depth();
+  for (uint8_t i = 0; i < count; ++i) {
+    sum += sampler_ring[index % SAMPLER_RING_LEN];
+    index -= sampler_count;
+  }
+  return sum;
+}
+
+uint16_t sampler_mean(uint8_t input, uint8_t count) {
+  if (count > sampler_depth())
+    count = sampler_depth();
+  if (count == 0)
+    return sampler_latest(input);
+  return (sampler_sum(input, count) + count / 2) / count;
+}
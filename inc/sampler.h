@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SAMPLER_INPUTS 5     // Entradas do ADC: 0 a 3 nos GPIOs 26 a 29 e 4 no sensor de temperatura interno
+#define SAMPLER_RING_BITS 7  // O anel de DMA ocupa 2^7 bytes (precisa ficar alinhado a esse tamanho)
+#define SAMPLER_RING_LEN (1u << (SAMPLER_RING_BITS - 1)) // Amostras de 16 bits no anel
+
+#define SAMPLER_TEMP_SENSOR 4 // Entrada do sensor de temperatura interno
+
+// Coloca o ADC em modo contínuo, alternando (round-robin) entre as entradas de input_mask, com as
+// conversões copiadas pela DMA para um anel na RAM. rate_hz é o total de conversões por segundo,
+// dividido entre as entradas. Retorna false se a máscara ou a taxa forem inválidas.
+bool sampler_init(uint8_t input_mask, uint32_t rate_hz);
+
+// Amostras de uma entrada que cabem no anel sem risco de serem sobrescritas durante a leitura
+uint8_t sampler_depth(void);
+
+// Última amostra completa da entrada
+uint16_t sampler_latest(uint8_t input);
+
+// Soma e média das últimas count amostras da entrada (count é limitado a sampler_depth)
+uint32_t sampler_sum(uint8_t input, uint8_t count);
+uint16_t sampler_mean(uint8_t input, uint8_t count);
@@ -0,0 +1,75 @@
+#include "sched.h"
+#include "hardware/sync.h"
+
+void sched_init(sched_t *s, sched_task_t *tasks, uint8_t count, uint64_t (*now)(void)) {
+  uint64_t start = now();
+
+  s->tasks = tasks;
+  s->count = count;
+  s->now = now;
+  s->ticks = 0;
+  s->seen = 0;
+  for (uint8_t i = 0; i < count; ++i)
+    tasks[i].next_us = start;
+  sched_reset_stats(s);
+}
+
+void sched_reset_stats(sched_t *s) {
+  for (uint8_t i = 0; i < s->count; ++i) {
+    sched_task_t *t = &s->tasks[i];
+    t->runs = 0;
+    t->overruns = 0;
+    t->missed = 0;
+    t->max_us = 0;
+  }
+}
+
+uint8_t sched_dispatch(sched_t *s, uint64_t now_us) {
+  uint8_t ran = 0;
+
+  for (uint8_t i = 0; i < s->count; ++i) {
+    sched_task_t *t = &s->tasks[i];
+    if (now_us < t->next_us)
+      continue;
+
+    uint64_t start = s->now();
+    t->run(t->arg);
+    uint32_t elapsed = (uint32_t)(s->now() - start);
+
+    ++t->runs;
+    ++ran;
+    if (elapsed > t->max_us)
+      t->max_us = elapsed;
+    if (elapsed > t->budget_us)
+      ++t->overruns;
+
+    // Mantém a fase da tarefa; se ficou para trás mais de um período, pula os que passaram
+    t->next_us += t->period_us;
+    if (t->next_us <= now_us) {
+      uint64_t behind = (now_us - t->next_us) / t->period_us + 1;
+      t->missed += (uint32_t)behind;
+      t->next_us += behind * t->period_us;
+    }
+  }
+  return ran;
+}
+
+// Alarme do tick: só conta e sinaliza o evento que acorda o __wfe do laço principal
+static bool sched_tick(repeating_timer_t *rt) {
+  sched_t *s = rt->user_data;
+  ++s->ticks;
+  __sev();
+  return true;
+}
+
+bool sched_start(sched_t *s, uint32_t tick_us) {
+  // Período negativo: o intervalo é contado do início de um tick ao próximo, sem acumular atraso
+  return add_repeating_timer_us(-(int64_t)tick_us, sched_tick, s, &s->timer);
+}
+
+void sched_run(sched_t *s) {
+  while (s->ticks == s->seen)
+    __wfe();
+  s->seen = s->ticks;
+  sched_dispatch(s, s->now());
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+// Tarefa periódica do escalonador cooperativo
+typedef struct {
+  const char *name;
+  uint32_t period_us;       // Intervalo entre execuções
+  uint32_t budget_us;       // Tempo máximo esperado de uma execução
+  void (*run)(void *arg);
+  void *arg;
+
+  uint64_t next_us;         // Próxima execução
+  uint32_t runs;            // Execuções
+  uint32_t overruns;        // Execuções que passaram do orçamento
+  uint32_t missed;          // Períodos perdidos por atraso (a tarefa não tenta recuperá-los)
+  uint32_t max_us;          // Maior duração medida
+} sched_task_t;
+
+#define SCHED_TASK(name, period_us, budget_us, run, arg) { (name), (period_us), (budget_us), (run), (arg), 0, 0, 0, 0, 0 }
+
+typedef struct {
+  sched_task_t *tasks;      // Em ordem de prioridade: as primeiras rodam antes quando vencem juntas
+  uint8_t count;
+  uint64_t (*now)(void);    // Relógio em us (time_us_64 na placa, relógio simulado no host)
+  volatile uint32_t ticks;  // Incrementado pelo alarme
+  uint32_t seen;            // Último tick atendido
+  repeating_timer_t timer;
+} sched_t;
+
+void sched_init(sched_t *s, sched_task_t *tasks, uint8_t count, uint64_t (*now)(void));
+
+// Executa as tarefas vencidas em now_us; retorna quantas rodaram
+uint8_t sched_dispatch(sched_t *s, uint64_t now_us);
+
+// Liga o alarme que acorda o laço principal a cada tick_us
+bool sched_start(sched_t *s, uint32_t tick_us);
+
+// Dorme até o próximo tick do alarme e executa as tarefas vencidas (uma volta do laço principal)
+void sched_run(sched_t *s);
+
+// Zera os contadores das tarefas
+void sched_reset_stats(sched_t *s);
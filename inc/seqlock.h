@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+// Seqlock de um escritor e vários leitores: o escritor nunca espera e o leitor repete a cópia se
+// ela cruzou uma escrita. Contador ímpar indica escrita em andamento.
+typedef struct {
+  volatile uint32_t seq;
+} seqlock_t;
+
+#define SEQLOCK_INIT { 0 }
+
+// Escritor: copia size bytes de src para o dado protegido dst
+static inline void seqlock_write(seqlock_t *lock, void *dst, const void *src, size_t size) {
+  lock->seq = lock->seq + 1;
+  __dmb(); // Leitores veem o contador ímpar antes de qualquer byte novo
+  memcpy(dst, src, size);
+  __dmb(); // Todos os bytes novos antes do contador par
+  lock->seq = lock->seq + 1;
+}
+
+// Leitor: copia o dado protegido src para dst com garantia de que a cópia não está rasgada; retorna
+// o contador da versão copiada (muda a cada escrita)
+static inline uint32_t seqlock_read(const seqlock_t *lock, void *dst, const void *src, size_t size) {
+  uint32_t seq;
+  do {
+    while ((seq = lock->seq) & 1)
+      tight_loop_contents();
+    __dmb();
+    memcpy(dst, src, size);
+    __dmb();
+  } while (lock->seq != seq);
+  return seq;
+}
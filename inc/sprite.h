@@ -0,0 +1,14 @@
+#pragma once
+
+#include "ssd1306.h"
+
+// Desenho de 1 bit por pixel guardado na flash, organizado por páginas como o buffer do display
+typedef struct {
+  uint8_t width, height;
+  const uint8_t *data;
+} sprite_t;
+
+// Desenha o sprite com o canto superior esquerdo em (x, y)
+static inline void sprite_draw(ssd1306_t *ssd, const sprite_t *sprite, uint8_t x, uint8_t y) {
+  ssd1306_blit(ssd, sprite->data, x, y, sprite->width, sprite->height);
+}
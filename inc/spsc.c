@@ -0,0 +1,41 @@
+#include <string.h>
+#include "spsc.h"
+#include "hardware/sync.h"
+
+void spsc_init(spsc_t *q, void *slots, uint16_t elem_size, uint32_t capacity) {
+  q->slots = slots;
+  q->elem_size = elem_size;
+  q->mask = capacity - 1;
+  q->head = 0;
+  q->tail = 0;
+  q->dropped = 0;
+}
+
+bool spsc_push(spsc_t *q, const void *elem) {
+  uint32_t head = q->head;
+
+  if (head - q->tail > q->mask) {
+    ++q->dropped;
+    return false;
+  }
+  memcpy(q->slots + (head & q->mask) * q->elem_size, elem, q->elem_size);
+  __dmb(); // O elemento precisa estar na memória antes do consumidor ver o novo índice
+  q->head = head + 1;
+  return true;
+}
+
+uint32_t spsc_space(const spsc_t *q) {
+  return q->mask + 1 - (q->head - q->tail);
+}
+
+bool spsc_pop(spsc_t *q, void *elem) {
+  uint32_t tail = q->tail;
+
+  if (tail == q->head)
+    return false;
+  __dmb(); // Lê o elemento só depois de ver o índice publicado pelo produtor
+  memcpy(elem, q->slots + (tail & q->mask) * q->elem_size, q->elem_size);
+  __dmb(); // Termina a cópia antes de liberar a posição para o produtor
+  q->tail = tail + 1;
+  return true;
+}
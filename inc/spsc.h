@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Fila sem travas de um produtor e um consumidor (podem estar em núcleos diferentes). Cada índice
+// só é escrito por um dos lados, então basta uma barreira de memória entre os dados e o índice.
+typedef struct {
+  uint8_t *slots;
+  uint16_t elem_size;
+  uint32_t mask;              // Capacidade - 1 (a capacidade é potência de 2)
+  volatile uint32_t head;     // Próxima posição a escrever (só o produtor altera)
+  volatile uint32_t tail;     // Próxima posição a ler (só o consumidor altera)
+  uint32_t dropped;           // Elementos descartados por fila cheia (contado pelo produtor)
+} spsc_t;
+
+// slots precisa ter capacity * elem_size bytes; capacity precisa ser potência de 2
+void spsc_init(spsc_t *q, void *slots, uint16_t elem_size, uint32_t capacity);
+
+// Produtor: copia o elemento para a fila; retorna false (e descarta) se estiver cheia
+bool spsc_push(spsc_t *q, const void *elem);
+
+// Produtor: posições livres (o consumidor só pode aumentar esse valor)
+uint32_t spsc_space(const spsc_t *q);
+
+// Consumidor: retira o elemento mais antigo
+bool spsc_pop(spsc_t *q, void *elem);
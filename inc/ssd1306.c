@@ -1,6 +1,19 @@
+#include <string.h>
 #include "ssd1306.h"
 #include "font.h"
 
+// Bytes gastos no barramento por uma janela: uma transação com endereço, controle e 6 comandos
+// mais o endereço e o byte de controle da transação de dados
+#define SSD1306_WINDOW_OVERHEAD (2 + 6 + 2)
+
+// Palavras no fluxo de DMA: janelas completas cabem no quadro inteiro mais os comandos de cada página
+#define SSD1306_STREAM_WORDS(bufsize) ((bufsize) + SSD1306_MAX_PAGES * (1 + 6 + 1))
+
+// Retângulo de páginas/colunas que será reenviado ao display
+typedef struct {
+  uint8_t x0, x1, p0, p1;
+} ssd1306_window_t;
+
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
   ssd->width = width;
   ssd->height = height;
@@ -11,37 +24,60 @@ void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_v
   ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
   ssd->ram_buffer[0] = 0x40;
   ssd->port_buffer[0] = 0x80;
+  ssd->batch_buffer[0] = 0x00; // Co = 0: todos os bytes seguintes são comandos
+  ssd->batch_count = 0;
+
+  // Dois fluxos permitem montar o próximo envio enquanto o anterior ainda está no barramento
+  ssd->tx_stream[0] = calloc(SSD1306_STREAM_WORDS(ssd->bufsize), sizeof(uint16_t));
+  ssd->tx_stream[1] = calloc(SSD1306_STREAM_WORDS(ssd->bufsize), sizeof(uint16_t));
+  ssd->tx_length = 0;
+  ssd->tx_index = 0;
+
+  // A DMA escreve palavras de 16 bits no IC_DATA_CMD no ritmo do DREQ de transmissão do I2C
+  ssd->dma_chan = dma_claim_unused_channel(true);
+  dma_channel_config c = dma_channel_get_default_config(ssd->dma_chan);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_dreq(&c, i2c_get_dreq(i2c, true));
+  dma_channel_configure(ssd->dma_chan, &c, &i2c_get_hw(i2c)->data_cmd, NULL, 0, false);
+
+  ssd1306_invalidate(ssd); // O primeiro envio sempre transmite o quadro completo
 }
 
 void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  // Toda a sequência de inicialização vai em uma única transação
+  ssd1306_batch_begin(ssd);
+  ssd1306_batch_add(ssd, SET_DISP | 0x00);
+  ssd1306_batch_add(ssd, SET_MEM_ADDR);
+  ssd1306_batch_add(ssd, 0x00); // Endereçamento horizontal: o buffer é organizado por páginas
+  ssd1306_batch_add(ssd, SET_DISP_START_LINE | 0x00);
+  ssd1306_batch_add(ssd, SET_SEG_REMAP | 0x01);
+  ssd1306_batch_add(ssd, SET_MUX_RATIO);
+  ssd1306_batch_add(ssd, HEIGHT - 1);
+  ssd1306_batch_add(ssd, SET_COM_OUT_DIR | 0x08);
+  ssd1306_batch_add(ssd, SET_DISP_OFFSET);
+  ssd1306_batch_add(ssd, 0x00);
+  ssd1306_batch_add(ssd, SET_COM_PIN_CFG);
+  ssd1306_batch_add(ssd, 0x12);
+  ssd1306_batch_add(ssd, SET_DISP_CLK_DIV);
+  ssd1306_batch_add(ssd, 0x80);
+  ssd1306_batch_add(ssd, SET_PRECHARGE);
+  ssd1306_batch_add(ssd, 0xF1);
+  ssd1306_batch_add(ssd, SET_VCOM_DESEL);
+  ssd1306_batch_add(ssd, 0x30);
+  ssd1306_batch_add(ssd, SET_CONTRAST);
+  ssd1306_batch_add(ssd, 0xFF);
+  ssd1306_batch_add(ssd, SET_ENTIRE_ON);
+  ssd1306_batch_add(ssd, SET_NORM_INV);
+  ssd1306_batch_add(ssd, SET_CHARGE_PUMP);
+  ssd1306_batch_add(ssd, 0x14);
+  ssd1306_batch_add(ssd, SET_DISP | 0x01);
+  ssd1306_batch_send(ssd);
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+  ssd1306_wait(ssd); // Não intercala comandos com um quadro ainda em envio
   ssd->port_buffer[1] = command;
   i2c_write_blocking(
     ssd->i2c_port,
@@ -52,66 +88,274 @@ void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
   );
 }
 
-void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
+// Inicia um lote de comandos que será enviado em uma única transação
+void ssd1306_batch_begin(ssd1306_t *ssd) {
+  ssd->batch_count = 0;
+}
+
+// Acrescenta um comando (ou argumento) ao lote, enviando o lote atual se estiver cheio
+void ssd1306_batch_add(ssd1306_t *ssd, uint8_t command) {
+  if (ssd->batch_count == SSD1306_BATCH_MAX)
+    ssd1306_batch_send(ssd);
+  ssd->batch_buffer[++ssd->batch_count] = command;
+}
+
+// Envia o lote como um fluxo de controle: 0x00 seguido de todos os comandos
+void ssd1306_batch_send(ssd1306_t *ssd) {
+  if (ssd->batch_count == 0)
+    return;
+  ssd1306_wait(ssd); // Não intercala comandos com um quadro ainda em envio
   i2c_write_blocking(
     ssd->i2c_port,
     ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
+    ssd->batch_buffer,
+    ssd->batch_count + 1,
     false
   );
+  ssd->batch_count = 0;
 }
 
-void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-  uint16_t index = (y >> 3) + (x << 3) + 1;
-  uint8_t pixel = (y & 0b111);
-  if (value)
-    ssd->ram_buffer[index] |= (1 << pixel);
-  else
-    ssd->ram_buffer[index] &= ~(1 << pixel);
+// Marca as colunas x0..x1 da página como alteradas desde o último envio
+void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t page, uint8_t x0, uint8_t x1) {
+  if (ssd->dirty_x0[page] > ssd->dirty_x1[page]) { // Página estava limpa
+    ssd->dirty_x0[page] = x0;
+    ssd->dirty_x1[page] = x1;
+    return;
+  }
+  if (x0 < ssd->dirty_x0[page])
+    ssd->dirty_x0[page] = x0;
+  if (x1 > ssd->dirty_x1[page])
+    ssd->dirty_x1[page] = x1;
 }
 
-/*
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-  uint8_t byte = value ? 0xFF : 0x00;
-  for (uint8_t i = 1; i < ssd->bufsize; ++i)
-    ssd->ram_buffer[i] = byte;
-}*/
+// Marca o display inteiro como alterado, forçando o envio do quadro completo
+void ssd1306_invalidate(ssd1306_t *ssd) {
+  for (uint8_t page = 0; page < ssd->pages; ++page) {
+    ssd->dirty_x0[page] = 0;
+    ssd->dirty_x1[page] = ssd->width - 1;
+  }
+}
 
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // Itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
+static size_t ssd1306_window_cost(const ssd1306_window_t *w) {
+  return SSD1306_WINDOW_OVERHEAD + (size_t)(w->x1 - w->x0 + 1) * (w->p1 - w->p0 + 1);
+}
+
+// Converte as faixas alteradas em janelas e limpa as marcações, retornando quantas janelas devem ser enviadas
+static uint8_t ssd1306_plan_windows(ssd1306_t *ssd, ssd1306_window_t *windows) {
+  ssd1306_window_t full = {0, ssd->width - 1, 0, ssd->pages - 1};
+  uint8_t count = 0;
+  size_t total = 0;
+
+  // Agrupa as faixas alteradas de páginas vizinhas quando a união custa menos que duas janelas
+  for (uint8_t page = 0; page < ssd->pages; ++page) {
+    if (ssd->dirty_x0[page] > ssd->dirty_x1[page])
+      continue;
+    ssd1306_window_t span = {ssd->dirty_x0[page], ssd->dirty_x1[page], page, page};
+    ssd->dirty_x0[page] = 0xFF;
+    ssd->dirty_x1[page] = 0;
+
+    if (count > 0 && windows[count - 1].p1 + 1 == page) {
+      ssd1306_window_t *last = &windows[count - 1];
+      ssd1306_window_t merged = {
+        last->x0 < span.x0 ? last->x0 : span.x0,
+        last->x1 > span.x1 ? last->x1 : span.x1,
+        last->p0,
+        page
+      };
+      size_t separate = ssd1306_window_cost(last) + ssd1306_window_cost(&span);
+      if (ssd1306_window_cost(&merged) <= separate) {
+        total += ssd1306_window_cost(&merged) - ssd1306_window_cost(last);
+        *last = merged;
+        continue;
+      }
     }
+    windows[count++] = span;
+    total += ssd1306_window_cost(&span);
+  }
+
+  // Volta para o quadro completo quando as janelas somadas custam o mesmo ou mais
+  if (count > 0 && total >= ssd1306_window_cost(&full)) {
+    windows[0] = full;
+    count = 1;
+  }
+  return count;
 }
 
+// Acrescenta ao fluxo uma transação I2C com os bytes dados, marcando STOP no último
+static size_t ssd1306_stream_bytes(uint16_t *stream, size_t n, uint8_t control, const uint8_t *bytes, size_t len) {
+  stream[n++] = control;
+  for (size_t i = 0; i < len; ++i)
+    stream[n++] = bytes[i];
+  stream[n - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+  return n;
+}
 
+// Acrescenta ao fluxo os comandos SET_COL_ADDR/SET_PAGE_ADDR da janela seguidos dos seus dados
+static size_t ssd1306_stream_window(ssd1306_t *ssd, uint16_t *stream, size_t n, const ssd1306_window_t *w) {
+  const uint8_t commands[6] = {SET_COL_ADDR, w->x0, w->x1, SET_PAGE_ADDR, w->p0, w->p1};
+  uint8_t span = w->x1 - w->x0 + 1;
 
-void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-  for (uint8_t x = left; x < left + width; ++x) {
-    ssd1306_pixel(ssd, x, top, value);
-    ssd1306_pixel(ssd, x, top + height - 1, value);
+  // Os comandos da janela vão juntos em um único fluxo de controle
+  n = ssd1306_stream_bytes(stream, n, 0x00, commands, 6);
+
+  stream[n++] = 0x40;
+  for (uint8_t page = w->p0; page <= w->p1; ++page) {
+    const uint8_t *row = &ssd->ram_buffer[page * ssd->width + w->x0 + 1];
+    for (uint8_t x = 0; x < span; ++x)
+      stream[n++] = row[x];
   }
-  for (uint8_t y = top; y < top + height; ++y) {
-    ssd1306_pixel(ssd, left, y, value);
-    ssd1306_pixel(ssd, left + width - 1, y, value);
+  stream[n - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+  return n;
+}
+
+// Inicia o envio das regiões alteradas por DMA e retorna sem esperar o fim da transmissão.
+// O ram_buffer pode ser redesenhado logo em seguida, pois os dados já foram copiados para o fluxo.
+// Retorna false se não havia nada para enviar.
+bool ssd1306_send_data_async(ssd1306_t *ssd) {
+  ssd1306_window_t windows[SSD1306_MAX_PAGES];
+  uint8_t count = ssd1306_plan_windows(ssd, windows);
+  if (count == 0)
+    return false; // Nada mudou desde o último envio
+
+  // Monta o fluxo livre enquanto o anterior pode ainda estar sendo transmitido
+  uint8_t next = ssd->tx_index ^ 1;
+  uint16_t *stream = ssd->tx_stream[next];
+  size_t n = 0;
+  for (uint8_t i = 0; i < count; ++i)
+    n = ssd1306_stream_window(ssd, stream, n, &windows[i]);
+
+  ssd1306_wait(ssd);
+  ssd->tx_index = next;
+  ssd->tx_length = n;
+
+  // Configura o endereço do display da mesma forma que o i2c_write_blocking do SDK
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  hw->enable = 0;
+  hw->tar = ssd->address;
+  hw->enable = 1;
+
+  dma_channel_transfer_from_buffer_now(ssd->dma_chan, stream, n);
+  return true;
+}
+
+// Indica se ainda há um quadro sendo transmitido (a DMA terminar não significa que o I2C terminou)
+bool ssd1306_busy(ssd1306_t *ssd) {
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+
+  // Em caso de NACK o controlador descarta a FIFO, então o envio é abortado. As faixas alteradas já
+  // foram limpas ao montar o fluxo e não se sabe até onde o display recebeu: o próximo envio
+  // transmite o quadro completo
+  if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+    dma_channel_abort(ssd->dma_chan);
+    (void) hw->clr_tx_abrt;
+    ssd1306_invalidate(ssd);
+    return false;
   }
+  if (dma_channel_is_busy(ssd->dma_chan))
+    return true;
+  return !(hw->status & I2C_IC_STATUS_TFE_BITS) || (hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS);
+}
 
-  if (fill) {
-    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-        ssd1306_pixel(ssd, x, y, value);
-      }
+// Espera o fim do envio em andamento
+void ssd1306_wait(ssd1306_t *ssd) {
+  while (ssd1306_busy(ssd))
+    tight_loop_contents();
+}
+
+// Envia as regiões alteradas e só retorna quando o display recebeu tudo
+void ssd1306_send_data(ssd1306_t *ssd) {
+  if (ssd1306_send_data_async(ssd))
+    ssd1306_wait(ssd);
+}
+
+// Escreve os bits de "mask" com os valores de "bits" nas colunas x0..x1 de uma página,
+// marcando como alterado só o trecho que realmente mudou.
+// As linhas das páginas começam em ram_buffer + 1 e não ficam alinhadas a palavras de 32 bits,
+// por isso o laço trabalha byte a byte (o M0+ não permite acesso desalinhado).
+static void ssd1306_write_span(ssd1306_t *ssd, uint8_t page, uint8_t x0, uint8_t x1, uint8_t mask, uint8_t bits) {
+  uint8_t *row = &ssd->ram_buffer[page * ssd->width + 1];
+  int16_t first = -1, last = -1;
+  bits &= mask;
+  for (uint8_t x = x0; x <= x1; ++x) {
+    uint8_t byte = (row[x] & ~mask) | bits;
+    if (byte != row[x]) {
+      row[x] = byte;
+      if (first < 0)
+        first = x;
+      last = x;
+    }
+  }
+  if (first >= 0)
+    ssd1306_mark_dirty(ssd, page, first, last);
+}
+
+// Mescla colunas de origem em uma página: cada byte é deslocado (shift positivo para baixo,
+// negativo para cima) e só os bits de "mask" são escritos
+static void ssd1306_merge_columns(ssd1306_t *ssd, uint8_t page, uint8_t x, uint8_t cols, const uint8_t *src, int8_t shift, uint8_t mask) {
+  uint8_t *row = &ssd->ram_buffer[page * ssd->width + x + 1];
+  int16_t first = -1, last = -1;
+  for (uint8_t i = 0; i < cols; ++i) {
+    uint8_t bits = shift >= 0 ? (uint8_t)(src[i] << shift) : (uint8_t)(src[i] >> -shift);
+    uint8_t byte = (row[i] & ~mask) | (bits & mask);
+    if (byte != row[i]) {
+      row[i] = byte;
+      if (first < 0)
+        first = i;
+      last = i;
     }
   }
+  if (first >= 0)
+    ssd1306_mark_dirty(ssd, page, x + first, x + last);
+}
+
+// Máscara com os bits das linhas y0..y1 (inclusive) dentro de uma página
+static inline uint8_t ssd1306_row_mask(uint8_t y0, uint8_t y1) {
+  return (uint8_t)((0xFFu << (y0 & 7)) & (0xFFu >> (7 - (y1 & 7))));
+}
+
+void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
+  if (x >= ssd->width || y >= ssd->height)
+    return;
+  uint8_t page = y >> 3;
+  uint16_t index = page * ssd->width + x + 1;
+  uint8_t old = ssd->ram_buffer[index];
+  uint8_t pixel = (y & 0b111);
+  uint8_t byte = value ? (old | (1 << pixel)) : (old & ~(1 << pixel));
+  if (byte != old) { // Só marca a região como alterada se o byte realmente mudou
+    ssd->ram_buffer[index] = byte;
+    ssd1306_mark_dirty(ssd, page, x, x);
+  }
+}
+
+void ssd1306_fill(ssd1306_t *ssd, bool value) {
+  for (uint8_t page = 0; page < ssd->pages; ++page)
+    ssd1306_write_span(ssd, page, 0, ssd->width - 1, 0xFF, value ? 0xFF : 0x00);
+}
+
+// Preenche um retângulo página a página, com uma máscara para as páginas parcialmente cobertas
+void ssd1306_fill_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value) {
+  if (width == 0 || height == 0 || left >= ssd->width || top >= ssd->height)
+    return;
+  uint8_t right = (left + width > ssd->width) ? ssd->width - 1 : left + width - 1;
+  uint8_t bottom = (top + height > ssd->height) ? ssd->height - 1 : top + height - 1;
+
+  for (uint8_t page = top >> 3; page <= bottom >> 3; ++page) {
+    uint8_t y0 = (page == top >> 3) ? top : page << 3;
+    uint8_t y1 = (page == bottom >> 3) ? bottom : (page << 3) + 7;
+    ssd1306_write_span(ssd, page, left, right, ssd1306_row_mask(y0, y1), value ? 0xFF : 0x00);
+  }
+}
+
+void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+  if (width == 0 || height == 0)
+    return;
+  ssd1306_hline(ssd, left, left + width - 1, top, value);
+  ssd1306_hline(ssd, left, left + width - 1, top + height - 1, value);
+  ssd1306_vline(ssd, left, top, top + height - 1, value);
+  ssd1306_vline(ssd, left + width - 1, top, top + height - 1, value);
+
+  if (fill && width > 2 && height > 2)
+    ssd1306_fill_rect(ssd, top + 1, left + 1, width - 2, height - 2, value);
 }
 
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
@@ -144,54 +388,58 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 
 
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-  for (uint8_t x = x0; x <= x1; ++x)
-    ssd1306_pixel(ssd, x, y, value);
+  if (y >= ssd->height || x0 >= ssd->width || x0 > x1)
+    return;
+  if (x1 >= ssd->width)
+    x1 = ssd->width - 1;
+  ssd1306_write_span(ssd, y >> 3, x0, x1, 1u << (y & 7), value ? 0xFF : 0x00);
 }
 
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-  for (uint8_t y = y0; y <= y1; ++y)
-    ssd1306_pixel(ssd, x, y, value);
+  if (x >= ssd->width || y0 >= ssd->height || y0 > y1)
+    return;
+  if (y1 >= ssd->height)
+    y1 = ssd->height - 1;
+  for (uint8_t page = y0 >> 3; page <= y1 >> 3; ++page) {
+    uint8_t top = (page == y0 >> 3) ? y0 : page << 3;
+    uint8_t bottom = (page == y1 >> 3) ? y1 : (page << 3) + 7;
+    ssd1306_write_span(ssd, page, x, x, ssd1306_row_mask(top, bottom), value ? 0xFF : 0x00);
+  }
+}
+
+// Copia um bitmap de 1 bit por pixel organizado por páginas (cada byte é uma coluna de 8 linhas,
+// bit 0 em cima), com w colunas e h linhas, para a posição (x, y). Os pixels dentro do retângulo
+// w x h são sobrescritos (acesos e apagados) e o que passa da borda do display é cortado.
+void ssd1306_blit(ssd1306_t *ssd, const uint8_t *bitmap, uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
+  if (x >= ssd->width || y >= ssd->height || w == 0 || h == 0)
+    return;
+  uint8_t cols = (x + w > ssd->width) ? ssd->width - x : w;
+  uint8_t src_pages = (h + 7) >> 3;
+  uint8_t shift = y & 7;
+
+  for (uint8_t sp = 0; sp < src_pages; ++sp) {
+    uint8_t rows = (sp == src_pages - 1) ? h - (sp << 3) : 8;
+    uint8_t mask = 0xFFu >> (8 - rows);
+    uint8_t page = (y >> 3) + sp;
+
+    // Parte de cada byte de origem que cai na página de destino alinhada
+    if (page < ssd->pages)
+      ssd1306_merge_columns(ssd, page, x, cols, &bitmap[sp * w], shift, mask << shift);
+
+    // Sobra que cai na página seguinte quando y não é múltiplo de 8
+    if (shift && page + 1 < ssd->pages && (mask >> (8 - shift)))
+      ssd1306_merge_columns(ssd, page + 1, x, cols, &bitmap[sp * w], shift - 8, mask >> (8 - shift));
+  }
 }
 
 // Função para desenhar um caractere
+// As colunas dos glifos já são bytes verticais no formato das páginas, então o glifo é copiado direto para o buffer
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
 {
-  uint16_t index = 0;
-  char ver=c;
-  if (c >= 'a' && c <= 'z')
-  {
-    index = (c - 'a' + 37) * 8; // Para letras minúsculas
-  }else if (c >= 'A' && c <= 'Z')
-  {
-    index = (c - 'A' + 11) * 8; // Para letras maiúsculas
-  }else  if (c >= '0' && c <= '9')
-  {
-    index = (c - '0' + 1) * 8; // Adiciona o deslocamento necessário
-  }else if(c == ':')
-  {
-    index = 63 * 8;
-  }else if(c == '?')
-  {
-    index = 64 * 8;
-  }else if(c == '*')
-  {
-    index = 65 * 8;
-  }else if(c == '%')
-  {
-    index = 66 * 8;
-  }else if(c == '-')
-  {
-    index = 67 * 8;
-  }
-  
-  for (uint8_t i = 0; i < 8; ++i)
-  {
-    uint8_t line = font[index + i];
-    for (uint8_t j = 0; j < 8; ++j)
-    {
-      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j));
-    }
-  }
+  uint8_t glyph = font_index[(uint8_t)c];
+  if (glyph == FONT_GLYPH_BLANK && c != ' ')
+    glyph = FONT_GLYPH_UNKNOWN;
+  ssd1306_blit(ssd, &font[glyph * 8], x, y, 8, 8);
 }
 
 // Função para desenhar uma string
@@ -1,9 +1,14 @@
+#pragma once
+
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "hardware/dma.h"
 
 #define WIDTH 128
 #define HEIGHT 64
+#define SSD1306_MAX_PAGES 8 // Número máximo de páginas (64 linhas / 8)
+#define SSD1306_BATCH_MAX 32 // Número máximo de comandos em uma única transação
 
 typedef enum {
   SET_CONTRAST = 0x81,
@@ -32,18 +37,36 @@ typedef struct {
   uint8_t *ram_buffer;
   size_t bufsize;
   uint8_t port_buffer[2];
+  uint8_t batch_buffer[SSD1306_BATCH_MAX + 1]; // Byte de controle 0x00 seguido dos comandos agrupados
+  uint8_t batch_count;                         // Número de comandos no lote atual
+  uint16_t *tx_stream[2];              // Fluxos de palavras IC_DATA_CMD (um em envio, outro em montagem)
+  size_t tx_length;                    // Número de palavras do fluxo em envio
+  uint8_t tx_index;                    // Índice do fluxo em envio
+  int dma_chan;                        // Canal de DMA que alimenta a FIFO de transmissão do I2C
+  uint8_t dirty_x0[SSD1306_MAX_PAGES]; // Primeira coluna alterada em cada página
+  uint8_t dirty_x1[SSD1306_MAX_PAGES]; // Última coluna alterada em cada página (x0 > x1 indica página limpa)
 } ssd1306_t;
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_batch_begin(ssd1306_t *ssd);
+void ssd1306_batch_add(ssd1306_t *ssd, uint8_t command);
+void ssd1306_batch_send(ssd1306_t *ssd);
 void ssd1306_send_data(ssd1306_t *ssd);
+bool ssd1306_send_data_async(ssd1306_t *ssd);
+bool ssd1306_busy(ssd1306_t *ssd);
+void ssd1306_wait(ssd1306_t *ssd);
+void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t page, uint8_t x0, uint8_t x1);
+void ssd1306_invalidate(ssd1306_t *ssd);
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
+void ssd1306_fill_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value);
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill);
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value);
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
+void ssd1306_blit(ssd1306_t *ssd, const uint8_t *bitmap, uint8_t x, uint8_t y, uint8_t w, uint8_t h);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
 void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "telemetry.h"
+
+#define TELEMETRY_HEADER_LEN 5  // magic0, magic1, schema, seq, len
+#define TELEMETRY_FIXED_LEN 7   // flags, time_ms, mask
+#define TELEMETRY_FRAME_MAX (TELEMETRY_HEADER_LEN + TELEMETRY_FIXED_LEN + 2 * TELEMETRY_MAX_FIELDS + 2)
+
+void telemetry_init(telemetry_t *t, const telemetry_config_t *cfg, uint32_t now_ms) {
+  t->cfg = cfg;
+  t->keyframe = true;
+  t->since_keyframe = 0;
+  t->next_ms = now_ms;
+  t->seq = 0;
+  t->head = 0;
+  t->tail = 0;
+  t->frames = 0;
+  t->dropped = 0;
+}
+
+uint16_t telemetry_crc(const uint8_t *data, uint32_t len) {
+  uint16_t crc = 0xFFFF;
+  while (len--) {
+    crc ^= (uint16_t) *data++ << 8;
+    for (uint8_t bit = 0; bit < 8; ++bit)
+      crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
+
+bool telemetry_sample(telemetry_t *t, const int16_t *values, uint32_t now_ms) {
+  const telemetry_config_t *cfg = t->cfg;
+  uint8_t frame[TELEMETRY_FRAME_MAX];
+  uint16_t mask = 0;
+
+  if ((int32_t) (now_ms - t->next_ms) < 0)
+    return false;
+  t->next_ms += cfg->period_ms;
+  if ((int32_t) (now_ms - t->next_ms) >= 0)
+    t->next_ms = now_ms + cfg->period_ms; // Atrasou mais de um período: não tenta recuperar
+
+  // Os quadros completos contam períodos, não quadros enviados: com o estado parado eles são o
+  // sinal de vida para o receptor
+  bool keyframe = t->keyframe || ++t->since_keyframe >= cfg->keyframe_every;
+  for (uint8_t i = 0; i < cfg->field_count; ++i) {
+    if (keyframe || values[i] != t->sent[i])
+      mask |= 1u << i;
+  }
+  if (!mask)
+    return false;
+
+  uint32_t n = TELEMETRY_HEADER_LEN;
+  frame[n++] = keyframe ? TELEMETRY_FLAG_KEYFRAME : 0;
+  frame[n++] = now_ms;
+  frame[n++] = now_ms >> 8;
+  frame[n++] = now_ms >> 16;
+  frame[n++] = now_ms >> 24;
+  frame[n++] = mask;
+  frame[n++] = mask >> 8;
+  for (uint8_t i = 0; i < cfg->field_count; ++i) {
+    if (mask & (1u << i)) {
+      frame[n++] = (uint16_t) values[i];
+      frame[n++] = (uint16_t) values[i] >> 8;
+    }
+  }
+  frame[0] = TELEMETRY_MAGIC0;
+  frame[1] = TELEMETRY_MAGIC1;
+  frame[2] = cfg->schema;
+  frame[3] = t->seq;
+  frame[4] = n - TELEMETRY_HEADER_LEN;
+  uint16_t crc = telemetry_crc(&frame[1], n - 1);
+  frame[n++] = crc;
+  frame[n++] = crc >> 8;
+
+  ++t->seq; // Um quadro descartado também consome o número, para o receptor ver a perda
+  if (TELEMETRY_RING_LEN - (t->head - t->tail) < n) {
+    // Canal lento ou fechado: o receptor perde este quadro e o próximo precisa ser completo
+    ++t->dropped;
+    t->keyframe = true;
+    return false;
+  }
+  for (uint32_t i = 0; i < n; ++i)
+    t->ring[(t->head + i) & (TELEMETRY_RING_LEN - 1)] = frame[i];
+  t->head += n;
+  ++t->frames;
+
+  for (uint8_t i = 0; i < cfg->field_count; ++i)
+    t->sent[i] = values[i];
+  t->keyframe = false;
+  if (keyframe)
+    t->since_keyframe = 0;
+  return true;
+}
+
+// Envia len bytes do início do anel; o anel pode dar a volta: envia até o fim do buffer e depois o
+// começo. Retorna false se o canal encheu antes
+static bool telemetry_send(telemetry_t *t, uint32_t len) {
+  while (len) {
+    uint32_t start = t->tail & (TELEMETRY_RING_LEN - 1);
+    uint32_t part = len < TELEMETRY_RING_LEN - start ? len : TELEMETRY_RING_LEN - start;
+    uint32_t written = t->cfg->write(&t->ring[start], part);
+    t->tail += written;
+    len -= written;
+    if (written < part)
+      return false;
+  }
+  return true;
+}
+
+void telemetry_flush(telemetry_t *t) {
+  if (!t->cfg->available) {
+    telemetry_send(t, t->head - t->tail); // Canal cheio: o resto sai no próximo flush
+    return;
+  }
+  // Um quadro por vez, do magic ao CRC (o tamanho está no cabeçalho dentro do anel)
+  while (t->head != t->tail) {
+    uint32_t len = TELEMETRY_HEADER_LEN + t->ring[(t->tail + 4) & (TELEMETRY_RING_LEN - 1)] + 2;
+    if (t->cfg->available() < len || !telemetry_send(t, len))
+      return;
+  }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+// Telemetria binária: a cada período o estado (uma lista de campos int16) vira um quadro com CRC
+// que vai para um anel de transmissão; telemetry_flush entrega ao canal só o que ele aceita sem
+// esperar. Quadros completos (keyframes) saem a cada keyframe_every períodos e depois de qualquer
+// perda; nos outros só vão os campos que mudaram desde o último quadro enviado.
+//
+// Quadro (little-endian):
+//   0xA5 'M' schema seq len | flags time_ms(4) mask(2) valores(2 por bit de mask) | crc(2)
+// len conta os bytes entre ele e o CRC; o CRC-16/CCITT (polinômio 0x1021, início 0xFFFF) cobre do
+// 'M' até o último valor. tools/telemetry_parse.py decodifica o fluxo.
+
+#define TELEMETRY_MAX_FIELDS 16  // Campos por quadro (bits de mask)
+#define TELEMETRY_RING_LEN 512   // Bytes no anel de transmissão (potência de 2)
+
+#define TELEMETRY_MAGIC0 0xA5
+#define TELEMETRY_MAGIC1 'M'
+#define TELEMETRY_FLAG_KEYFRAME 0x01 // Todos os campos presentes: o receptor pode descartar o estado anterior
+
+// Entrega bytes ao canal sem bloquear; retorna quantos foram aceitos
+typedef uint32_t (*telemetry_write_t)(const uint8_t *data, uint32_t len);
+
+// Bytes que o canal aceita agora
+typedef uint32_t (*telemetry_available_t)(void);
+
+typedef struct {
+  uint8_t schema;           // Versão da lista de campos (muda quando a ordem ou o significado muda)
+  uint8_t field_count;
+  uint32_t period_ms;       // Intervalo entre quadros
+  uint16_t keyframe_every;  // Um quadro completo a cada tantos períodos
+  telemetry_write_t write;
+  // Com o canal dividido com outro fluxo (a USB com o registro de eventos), o flush só entrega um
+  // quadro quando ele cabe inteiro, para os dois não se misturarem no meio de um quadro; write
+  // precisa aceitar tudo o que available informou. NULL: o quadro pode sair aos pedaços.
+  telemetry_available_t available;
+} telemetry_config_t;
+
+typedef struct {
+  const telemetry_config_t *cfg;
+  int16_t sent[TELEMETRY_MAX_FIELDS]; // Valores que o receptor conhece
+  bool keyframe;            // O próximo quadro precisa ser completo
+  uint16_t since_keyframe;  // Períodos desde o último quadro completo
+  uint32_t next_ms;         // Próximo quadro
+  uint8_t seq;              // Número do quadro (o receptor detecta perdas)
+  uint8_t ring[TELEMETRY_RING_LEN];
+  uint32_t head, tail;      // Anel de transmissão
+  uint32_t frames;          // Quadros colocados no anel
+  uint32_t dropped;         // Quadros descartados com o anel cheio
+} telemetry_t;
+
+void telemetry_init(telemetry_t *t, const telemetry_config_t *cfg, uint32_t now_ms);
+
+// Monta o quadro do período se ele venceu (values tem cfg->field_count campos); retorna true se
+// um quadro foi para o anel. Um quadro de diferença sem mudanças não é enviado.
+bool telemetry_sample(telemetry_t *t, const int16_t *values, uint32_t now_ms);
+
+// Passa ao canal o que couber do anel (só quadros inteiros com cfg->available)
+void telemetry_flush(telemetry_t *t);
+
+// CRC-16/CCITT usado nos quadros
+uint16_t telemetry_crc(const uint8_t *data, uint32_t len);
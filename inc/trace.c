@@ -0,0 +1,105 @@
+#include "trace.h"
+
+#if TRACE
+
+#include "hardware/sync.h"
+#include "spsc.h"
+#include "telemetry.h"
+#include "usb_cdc.h"
+
+static trace_record_t trace_slots[TRACE_RING_LEN];
+static spsc_t trace_ring;
+static uint32_t trace_last_us;    // Tempo do último registro gravado (produtor)
+static uint32_t trace_dropped;    // Registros perdidos ainda não avisados (produtor)
+static uint32_t trace_drained_us; // Tempo do último registro enviado (consumidor)
+
+void trace_init(void) {
+  spsc_init(&trace_ring, trace_slots, sizeof(trace_record_t), TRACE_RING_LEN);
+  trace_last_us = time_us_32();
+  trace_drained_us = trace_last_us;
+  trace_dropped = 0;
+}
+
+// Grava um registro, com a extensão do tempo antes se o intervalo não couber em 16 bits
+static bool trace_put(uint32_t now, trace_event_t event, uint8_t arg, int16_t value) {
+  uint32_t delta = now - trace_last_us;
+  uint32_t high = delta >> 16;
+  if (high > UINT16_MAX)
+    high = UINT16_MAX; // Mais de ~71 minutos sem eventos: o decodificador perde a referência absoluta
+
+  if (spsc_space(&trace_ring) < (high ? 2u : 1u))
+    return false;
+  if (high) {
+    trace_record_t time = {0, TRACE_TIME, 0, (int16_t) high};
+    spsc_push(&trace_ring, &time);
+  }
+  trace_record_t record = {(uint16_t) delta, event, arg, value};
+  spsc_push(&trace_ring, &record);
+  trace_last_us = now;
+  return true;
+}
+
+void trace_emit(trace_event_t event, uint8_t arg, int16_t value) {
+  // O delta só é válido se a ordem no anel for a ordem dos tempos: a interrupção não pode entrar
+  // entre a leitura do relógio e a gravação
+  uint32_t irq = save_and_disable_interrupts();
+  uint32_t now = time_us_32();
+
+  if (trace_dropped) {
+    if (!trace_put(now, TRACE_DROPPED, 0, trace_dropped > INT16_MAX ? INT16_MAX : (int16_t) trace_dropped)) {
+      ++trace_dropped;
+      restore_interrupts(irq);
+      return;
+    }
+    trace_dropped = 0;
+  }
+  if (!trace_put(now, event, arg, value))
+    ++trace_dropped;
+  restore_interrupts(irq);
+}
+
+void trace_drain(void) {
+  uint8_t chunk[TRACE_HEADER_LEN + TRACE_CHUNK_RECORDS * sizeof(trace_record_t) + TRACE_CRC_LEN];
+  uint32_t base = trace_drained_us;
+  uint8_t count = 0;
+  trace_record_t record;
+
+  // Só retira do anel os registros que cabem na FIFO da USB agora; sem terminal aberto ou com o
+  // computador atrasado eles continuam no anel até ele encher
+  uint32_t room = usb_cdc_available();
+  if (room < TRACE_HEADER_LEN + sizeof(trace_record_t) + TRACE_CRC_LEN)
+    return;
+  uint32_t fit = (room - TRACE_HEADER_LEN - TRACE_CRC_LEN) / sizeof(trace_record_t);
+  uint8_t max = fit < TRACE_CHUNK_RECORDS ? fit : TRACE_CHUNK_RECORDS;
+
+  while (count < max && spsc_pop(&trace_ring, &record)) {
+    uint8_t *p = &chunk[TRACE_HEADER_LEN + count * sizeof(trace_record_t)];
+    p[0] = record.delta_us;
+    p[1] = record.delta_us >> 8;
+    p[2] = record.event;
+    p[3] = record.arg;
+    p[4] = (uint16_t) record.value;
+    p[5] = (uint16_t) record.value >> 8;
+    trace_drained_us += record.event == TRACE_TIME ? (uint32_t) (uint16_t) record.value << 16 : record.delta_us;
+    ++count;
+  }
+  if (!count)
+    return;
+
+  chunk[0] = TRACE_MAGIC0;
+  chunk[1] = TRACE_MAGIC1;
+  chunk[2] = count;
+  chunk[3] = base;
+  chunk[4] = base >> 8;
+  chunk[5] = base >> 16;
+  chunk[6] = base >> 24;
+  uint32_t len = TRACE_HEADER_LEN + count * sizeof(trace_record_t);
+  uint16_t crc = telemetry_crc(&chunk[1], len - 1);
+  chunk[len++] = crc;
+  chunk[len++] = crc >> 8;
+  // Direto na FIFO da USB: sem a conversão de \n do printf, sem passar pela UART, que bloquearia o
+  // laço no ritmo do baud rate, e sem esperar. O bloco inteiro cabe (o espaço só aumenta até aqui)
+  usb_cdc_write(chunk, len);
+}
+
+#endif
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+// Registro binário de eventos (opção TRACE do CMake, ligada por padrão). Cada evento vira um
+// registro de 6 bytes em um anel na RAM, gravado com as interrupções desligadas por poucos ciclos
+// (pode ser chamado da interrupção e do laço principal do núcleo 0), e trace_drain envia os
+// registros pela USB em blocos, sem esperar. tools/trace_decode.py converte o fluxo em texto.
+#ifndef TRACE
+#define TRACE 1
+#endif
+
+#define TRACE_RING_LEN 256    // Registros no anel (potência de 2)
+#define TRACE_CHUNK_RECORDS 16 // Registros por bloco enviado
+
+// Eventos; a ordem faz parte do formato (tools/trace_decode.py usa os mesmos números)
+typedef enum {
+  TRACE_TIME,      // Extensão do tempo: value << 16 us somados antes do próximo registro
+  TRACE_DROPPED,   // value registros perdidos com o anel cheio
+  TRACE_EDGE,      // Borda de botão na interrupção: arg botão, value bit 0 pressionado, bit 1 aceita pelo debounce
+  TRACE_BUTTON,    // Evento de botão: arg botão, value tipo | quantidade << 8
+  TRACE_SCREEN,    // Troca de tela: value tela
+  TRACE_SCALED,    // Valor convertido mudou: arg eixo (0 temperatura, 1 umidade), value valor
+  TRACE_LEVEL,     // Nível de atuador mudou: arg atuador (0 ventilador, 1 umidificador), value nível
+  TRACE_LOW_WATER, // Aviso de pouca água: value 1 ligado, 0 desligado
+  TRACE_CALIBRATION, // Calibração: value evento do calibrador
+  TRACE_EVENT_COUNT,
+} trace_event_t;
+
+// Registro: tempo desde o registro anterior, evento e dados
+typedef struct {
+  uint16_t delta_us;
+  uint8_t event;
+  uint8_t arg;
+  int16_t value;
+} trace_record_t;
+
+// Bloco enviado pela USB: cabeçalho, count registros e CRC (little-endian). base_us é o tempo do
+// registro anterior ao primeiro do bloco, para o decodificador começar em qualquer bloco. O CRC é o
+// dos quadros de telemetria (telemetry_crc), do 'T' até o último registro: o decodificador descarta
+// o bloco corrompido ou o magic falso no meio de outro fluxo e procura de novo no byte seguinte.
+#define TRACE_MAGIC0 0xA5
+#define TRACE_MAGIC1 'T'
+#define TRACE_HEADER_LEN 7 // magic0, magic1, count, base_us (4 bytes)
+#define TRACE_CRC_LEN 2
+
+#if TRACE
+
+void trace_init(void);
+
+// Grava um evento; descarta (e conta) se o anel estiver cheio
+void trace_emit(trace_event_t event, uint8_t arg, int16_t value);
+
+// Envia pela USB até um bloco com os registros que cabem na FIFO agora, sem esperar; chamar
+// periodicamente do laço principal
+void trace_drain(void);
+
+#else
+
+static inline void trace_init(void) {}
+static inline void trace_emit(trace_event_t event, uint8_t arg, int16_t value) {}
+static inline void trace_drain(void) {}
+
+#endif
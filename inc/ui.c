@@ -0,0 +1,90 @@
+#include <string.h>
+#include "ui.h"
+#include "fmt.h"
+
+// Atualiza o texto, redesenhando só os caracteres que mudaram. Retorna true se algo foi desenhado.
+bool ui_label_set(ssd1306_t *ssd, ui_label_t *label, const char *text) {
+  bool drawn = false;
+  uint8_t i = 0;
+  // Só os caracteres do texto anterior estão na tela: depois do terminador podem sobrar restos de
+  // um texto ainda mais antigo, que já foram apagados
+  uint8_t shown = label->valid ? strlen(label->text) : 0;
+
+  for (; i < UI_TEXT_MAX && text[i]; ++i) {
+    if (i < shown && label->text[i] == text[i])
+      continue;
+    ssd1306_draw_char(ssd, text[i], label->x + i * 8, label->y);
+    label->text[i] = text[i];
+    drawn = true;
+  }
+
+  // Apaga o que sobrou de um texto anterior mais longo
+  for (uint8_t j = i; j < shown; ++j) {
+    ssd1306_draw_char(ssd, ' ', label->x + j * 8, label->y);
+    drawn = true;
+  }
+
+  label->text[i] = '\0';
+  label->valid = true;
+  return drawn;
+}
+
+void ui_label_invalidate(ui_label_t *label) {
+  label->valid = false;
+}
+
+// Atualiza o campo numérico; se o valor não mudou não formata nem desenha nada
+bool ui_number_set(ssd1306_t *ssd, ui_number_t *number, int value) {
+  char text[UI_TEXT_MAX + 1];
+
+  if (number->valid && number->value == value)
+    return false;
+  number->valid = true;
+  number->value = value;
+
+  char *end = fmt_str(text, number->prefix);
+  end = fmt_int(end, value, number->digits);
+  end = fmt_str(end, number->suffix);
+  *end = '\0';
+  return ui_label_set(ssd, &number->label, text);
+}
+
+// Apaga o número e o sufixo, mantendo o prefixo na tela
+bool ui_number_clear(ssd1306_t *ssd, ui_number_t *number) {
+  char text[UI_TEXT_MAX + 1];
+  char *end = fmt_str(text, number->prefix);
+  end = fmt_fill(end, ' ', number->digits + strlen(number->suffix));
+  *end = '\0';
+
+  number->valid = false;
+  return ui_label_set(ssd, &number->label, text);
+}
+
+void ui_number_invalidate(ui_number_t *number) {
+  number->valid = false;
+  ui_label_invalidate(&number->label);
+}
+
+// Troca o ícone, desenhando apenas se o sprite for diferente do que já está na tela
+bool ui_icon_set(ssd1306_t *ssd, ui_icon_t *icon, const sprite_t *sprite) {
+  if (icon->sprite == sprite)
+    return false;
+  sprite_draw(ssd, sprite, icon->x, icon->y);
+  icon->sprite = sprite;
+  return true;
+}
+
+void ui_icon_invalidate(ui_icon_t *icon) {
+  icon->sprite = NULL;
+}
+
+// Desenha as bordas e divisórias fixas da tela
+void ui_frames_draw(ssd1306_t *ssd, const ui_frame_t *frames, uint8_t count) {
+  for (uint8_t i = 0; i < count; ++i) {
+    const ui_frame_t *f = &frames[i];
+    if (f->fill)
+      ssd1306_fill_rect(ssd, f->top, f->left, f->width, f->height, true);
+    else
+      ssd1306_rect(ssd, f->top, f->left, f->width, f->height, true, false);
+  }
+}
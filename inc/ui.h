@@ -0,0 +1,47 @@
+#pragma once
+
+#include "ssd1306.h"
+#include "sprite.h"
+
+#define UI_TEXT_MAX 16 // Número máximo de caracteres de um texto na tela
+
+// Texto em posição fixa que guarda o último conteúdo desenhado
+typedef struct {
+  uint8_t x, y;
+  bool valid;                   // false força redesenhar tudo na próxima atualização
+  char text[UI_TEXT_MAX + 1];   // Último texto desenhado
+} ui_label_t;
+
+// Campo numérico "prefixo + número alinhado à direita + sufixo" que só é formatado quando o valor muda
+typedef struct {
+  ui_label_t label;
+  const char *prefix, *suffix;
+  uint8_t digits;               // Largura do número em caracteres
+  bool valid;                   // false indica que o valor guardado não está na tela
+  int value;                    // Último valor desenhado
+} ui_number_t;
+
+// Ícone em posição fixa que guarda o último sprite desenhado
+typedef struct {
+  uint8_t x, y;
+  const sprite_t *sprite;       // NULL força redesenhar
+} ui_icon_t;
+
+// Elementos fixos da tela (bordas e divisórias), desenhados apenas quando a tela é invalidada
+typedef struct {
+  uint8_t top, left, width, height;
+  bool fill;
+} ui_frame_t;
+
+#define UI_LABEL(x, y) { (x), (y), false, "" }
+#define UI_NUMBER(x, y, prefix, digits, suffix) { UI_LABEL(x, y), (prefix), (suffix), (digits), false, 0 }
+#define UI_ICON(x, y) { (x), (y), NULL }
+
+bool ui_label_set(ssd1306_t *ssd, ui_label_t *label, const char *text);
+void ui_label_invalidate(ui_label_t *label);
+bool ui_number_set(ssd1306_t *ssd, ui_number_t *number, int value);
+bool ui_number_clear(ssd1306_t *ssd, ui_number_t *number);
+void ui_number_invalidate(ui_number_t *number);
+bool ui_icon_set(ssd1306_t *ssd, ui_icon_t *icon, const sprite_t *sprite);
+void ui_icon_invalidate(ui_icon_t *icon);
+void ui_frames_draw(ssd1306_t *ssd, const ui_frame_t *frames, uint8_t count);
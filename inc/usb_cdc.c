@@ -0,0 +1,31 @@
+#include "usb_cdc.h"
+#include "pico/stdio_usb.h"
+#include "hardware/sync.h"
+#include "tusb.h"
+
+// A tarefa da TinyUSB roda em uma interrupção do stdio da USB neste núcleo: com as interrupções
+// desligadas ela não mexe na FIFO entre a consulta do espaço e a escrita
+
+uint32_t usb_cdc_available(void) {
+  if (!stdio_usb_connected())
+    return 0;
+  uint32_t irq = save_and_disable_interrupts();
+  uint32_t room = tud_cdc_write_available();
+  restore_interrupts(irq);
+  return room;
+}
+
+uint32_t usb_cdc_write(const void *data, uint32_t len) {
+  if (!stdio_usb_connected())
+    return 0;
+  uint32_t irq = save_and_disable_interrupts();
+  uint32_t room = tud_cdc_write_available();
+  if (len > room)
+    len = room;
+  if (len) {
+    tud_cdc_write(data, len);
+    tud_cdc_write_flush();
+  }
+  restore_interrupts(irq);
+  return len;
+}
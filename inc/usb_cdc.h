@@ -0,0 +1,13 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+// Escrita binária direto na FIFO de transmissão da USB CDC, sem esperar o computador: entra só o que
+// cabe agora e o resto fica com quem chamou. O stdio da USB (printf) bloqueia até 500 ms com a
+// FIFO cheia, o que atrasaria o laço principal.
+
+// Bytes que cabem agora na FIFO (0 sem terminal aberto)
+uint32_t usb_cdc_available(void);
+
+// Escreve até len bytes, no máximo os que cabem, e agenda o envio; retorna quantos entraram
+uint32_t usb_cdc_write(const void *data, uint32_t len);
@@ -0,0 +1,101 @@
+#include "sim.h"
+#include "hardware/adc.h"
+
+#define SIM_ADC_INPUTS 5
+#define SIM_ADC_CLOCK 48000000.0
+
+adc_hw_t sim_adc_regs;
+
+static uint16_t value[SIM_ADC_INPUTS] = {2048, 2048, 2048, 2048, 876}; // Joystick no centro e ~27 °C
+static uint16_t noise[SIM_ADC_INPUTS];
+static uint32_t noise_state = 1;
+static uint selected;
+static uint round_robin;
+static bool running;
+static float clkdiv;
+
+void adc_init(void) {
+  selected = 0;
+  round_robin = 0;
+  running = false;
+  clkdiv = 0;
+}
+
+void adc_gpio_init(uint gpio) {
+  gpio_set_function(gpio, GPIO_FUNC_NULL);
+  gpio_disable_pulls(gpio);
+}
+
+void adc_select_input(uint input) {
+  selected = input % SIM_ADC_INPUTS;
+}
+
+uint adc_get_selected_input(void) {
+  return selected;
+}
+
+void adc_set_round_robin(uint input_mask) {
+  round_robin = input_mask & ((1u << SIM_ADC_INPUTS) - 1);
+}
+
+void adc_set_temp_sensor_enabled(bool enable) {
+  (void)enable;
+}
+
+void adc_set_clkdiv(float div) {
+  clkdiv = div;
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift) {
+  (void)en;
+  (void)dreq_en;
+  (void)dreq_thresh;
+  (void)err_in_fifo;
+  (void)byte_shift;
+}
+
+void adc_fifo_drain(void) {
+}
+
+void adc_run(bool run) {
+  running = run;
+}
+
+uint64_t sim_adc_period_ns(void) {
+  if (!running)
+    return 0;
+  // Como no hardware: uma conversão a cada clkdiv + 1 ciclos, nunca menos que 96
+  double cycles = clkdiv + 1 < 96 ? 96 : clkdiv + 1;
+  return (uint64_t)(cycles * 1e9 / SIM_ADC_CLOCK + 0.5);
+}
+
+uint16_t sim_adc_convert(void) {
+  uint input = selected;
+  int32_t v = value[input];
+
+  if (noise[input]) {
+    noise_state = noise_state * 1664525u + 1013904223u; // LCG: o ruído se repete em toda execução
+    v += (int32_t)((noise_state >> 8) % (2u * noise[input] + 1)) - noise[input];
+  }
+
+  // Round-robin: passa para a próxima entrada da máscara
+  if (round_robin) {
+    do
+      selected = (selected + 1) % SIM_ADC_INPUTS;
+    while (!(round_robin & (1u << selected)));
+  }
+  return v < 0 ? 0 : v > 4095 ? 4095 : v;
+}
+
+uint16_t adc_read(void) {
+  busy_wait_us(2); // 96 ciclos de 48 MHz
+  return sim_adc_convert();
+}
+
+void sim_adc_set(uint input, uint16_t v) {
+  value[input % SIM_ADC_INPUTS] = v > 4095 ? 4095 : v;
+}
+
+void sim_adc_noise(uint input, uint16_t amplitude) {
+  noise[input % SIM_ADC_INPUTS] = amplitude;
+}
@@ -0,0 +1,349 @@
+#include <stdlib.h>
+#include <pthread.h>
+#include "sim.h"
+#include "hardware/sync.h"
+
+#define SIM_TIMERS 32        // Alarmes, timers repetitivos e eventos do cenário pendentes
+#define SIM_SPIN_NS 1000     // Tempo consumido por uma volta de espera ativa
+#define SIM_CONSOLE_LEN 64   // Caracteres da entrada da USB/UART ainda não lidos
+
+typedef enum { TIMER_FREE, TIMER_ALARM, TIMER_REPEATING, TIMER_EVENT } timer_kind_t;
+
+typedef struct {
+  timer_kind_t kind;
+  uint64_t at_ns;
+  uint32_t seq;               // Desempate: alarmes no mesmo instante disparam na ordem em que foram criados
+  alarm_id_t id;
+  alarm_callback_t alarm;
+  repeating_timer_t *timer;
+  sim_event_fn event;
+  void *arg;
+} sim_timer_t;
+
+static uint64_t now_ns;
+static uint64_t end_ns = UINT64_MAX;
+static void (*end_fn)(void);
+static sim_timer_t timers[SIM_TIMERS];
+static uint32_t next_seq;
+static alarm_id_t next_id = 1;
+
+// Núcleos: cada um é uma thread, mas só um roda por vez. A vez passa nas esperas do relógio virtual
+// para o núcleo que volta primeiro (no mesmo instante, o núcleo 0), então a execução continua
+// determinística. Os alarmes disparam na thread que estiver avançando o relógio e, como no firmware,
+// são interrupções do núcleo 0
+static pthread_mutex_t core_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t core_cond = PTHREAD_COND_INITIALIZER;
+static bool core1_launched;
+static uint running_core;
+static uint64_t core_wake_ns[2];  // Instante em que o núcleo que não está rodando volta
+static bool core_in_wfe[2];       // Parado no __wfe: um evento ou uma interrupção o acorda antes
+static bool event_pending[2];     // Registrador de evento do __sev/__wfe de cada núcleo
+static _Thread_local uint this_core;
+
+uint64_t sim_now_ns(void) {
+  return now_ns;
+}
+
+void sim_set_end(uint64_t t_ns, void (*on_end)(void)) {
+  end_ns = t_ns;
+  end_fn = on_end;
+}
+
+static sim_timer_t *timer_add(timer_kind_t kind, uint64_t at_ns, alarm_id_t id) {
+  for (int i = 0; i < SIM_TIMERS; ++i) {
+    if (timers[i].kind == TIMER_FREE) {
+      timers[i] = (sim_timer_t){kind, at_ns, next_seq++, id};
+      return &timers[i];
+    }
+  }
+  return NULL;
+}
+
+// Alarme que o callback pediu para repetir; sem espaço a simulação não seria mais fiel ao firmware
+static sim_timer_t *timer_again(timer_kind_t kind, uint64_t at_ns, alarm_id_t id) {
+  sim_timer_t *t = timer_add(kind, at_ns, id);
+  if (!t) {
+    fprintf(stderr, "sim: mais de %d alarmes pendentes\n", SIM_TIMERS);
+    exit(1);
+  }
+  return t;
+}
+
+static sim_timer_t *timer_next(void) {
+  sim_timer_t *next = NULL;
+
+  for (int i = 0; i < SIM_TIMERS; ++i) {
+    sim_timer_t *t = &timers[i];
+    if (t->kind == TIMER_FREE)
+      continue;
+    if (!next || t->at_ns < next->at_ns || (t->at_ns == next->at_ns && t->seq < next->seq))
+      next = t;
+  }
+  return next;
+}
+
+static void timer_fire(sim_timer_t *slot) {
+  sim_timer_t t = *slot;
+
+  slot->kind = TIMER_FREE; // O callback pode criar outros alarmes
+  switch (t.kind) {
+    case TIMER_ALARM: {
+      int64_t r = t.alarm(t.id, t.arg);
+      // Como no SDK: negativo conta do horário previsto, positivo conta de agora
+      if (r) {
+        uint64_t at = r < 0 ? t.at_ns + (uint64_t)-r * 1000 : now_ns + (uint64_t)r * 1000;
+        sim_timer_t *again = timer_again(TIMER_ALARM, at, t.id);
+        again->alarm = t.alarm;
+        again->arg = t.arg;
+      }
+      break;
+    }
+    case TIMER_REPEATING:
+      if (t.timer->callback(t.timer)) {
+        int64_t d = t.timer->delay_us; // Negativo: entre inícios; positivo: depois do fim do callback
+        uint64_t at = d < 0 ? t.at_ns + (uint64_t)-d * 1000 : now_ns + (uint64_t)d * 1000;
+        sim_timer_t *again = timer_again(TIMER_REPEATING, at, t.id);
+        again->timer = t.timer;
+      }
+      break;
+    case TIMER_EVENT:
+      t.event(t.arg);
+      break;
+    default:
+      break;
+  }
+}
+
+// Avança até t_ns ou até o próximo alarme, o que vier antes; retorna true se um alarme disparou
+static bool clock_step(uint64_t t_ns) {
+  sim_timer_t *next = timer_next();
+  bool fire = next && next->at_ns <= t_ns;
+  uint64_t stop = fire ? next->at_ns : t_ns;
+
+  if (stop < now_ns)
+    stop = now_ns; // Alarme atrasado: dispara agora
+  if (stop > end_ns) {
+    sim_dma_run(end_ns);
+    sim_pio_run(end_ns);
+    now_ns = end_ns;
+    if (end_fn)
+      end_fn();
+    exit(0);
+  }
+  sim_dma_run(stop);
+  sim_pio_run(stop);
+  now_ns = stop;
+  if (!fire)
+    return false;
+  timer_fire(next);
+  if (core1_launched && core_in_wfe[0])
+    core_wake_ns[0] = now_ns; // A interrupção acorda o núcleo 0
+  return true;
+}
+
+// Passa a vez para o núcleo core e espera ela voltar
+static void core_switch(uint core) {
+  pthread_mutex_lock(&core_mutex);
+  running_core = core;
+  pthread_cond_broadcast(&core_cond);
+  while (running_core != this_core)
+    pthread_cond_wait(&core_cond, &core_mutex);
+  pthread_mutex_unlock(&core_mutex);
+}
+
+void sim_advance_to(uint64_t t_ns) {
+  if (!core1_launched) {
+    while (clock_step(t_ns))
+      ;
+    return;
+  }
+
+  core_wake_ns[this_core] = t_ns;
+  for (;;) {
+    uint next = core_wake_ns[1] < core_wake_ns[0] ? 1 : 0;
+    // Um alarme por vez: ele pode acordar o outro núcleo antes do previsto
+    if (clock_step(core_wake_ns[next]))
+      continue;
+    if (next == this_core)
+      return;
+    core_switch(next);
+  }
+}
+
+static void *core1_thread(void *arg) {
+  void (*entry)(void) = (void (*)(void))(uintptr_t)arg;
+
+  this_core = 1;
+  pthread_mutex_lock(&core_mutex);
+  while (running_core != 1)
+    pthread_cond_wait(&core_cond, &core_mutex);
+  pthread_mutex_unlock(&core_mutex);
+  entry();
+  for (;;)
+    sim_advance_to(UINT64_MAX); // Como o núcleo parado depois de retornar
+  return NULL;
+}
+
+void sim_core1_launch(void (*entry)(void)) {
+  pthread_t thread;
+
+  if (core1_launched) {
+    fprintf(stderr, "sim: núcleo 1 iniciado duas vezes\n");
+    exit(1);
+  }
+  core1_launched = true;
+  core_wake_ns[1] = now_ns; // Começa na próxima espera do núcleo 0
+  if (pthread_create(&thread, NULL, core1_thread, (void *)(uintptr_t)entry)) {
+    fprintf(stderr, "sim: não foi possível criar a thread do núcleo 1\n");
+    exit(1);
+  }
+  pthread_detach(thread);
+}
+
+uint get_core_num(void) {
+  return this_core;
+}
+
+bool sim_at(uint64_t t_ns, sim_event_fn fn, void *arg) {
+  sim_timer_t *t = timer_add(TIMER_EVENT, t_ns, 0);
+  if (!t)
+    return false;
+  t->event = fn;
+  t->arg = arg;
+  return true;
+}
+
+// -------- SDK --------
+
+uint64_t time_us_64(void) {
+  return now_ns / 1000;
+}
+
+absolute_time_t get_absolute_time(void) {
+  return now_ns / 1000;
+}
+
+void busy_wait_us(uint64_t us) {
+  sim_advance_to(now_ns + us * 1000);
+}
+
+void busy_wait_ms(uint32_t ms) {
+  busy_wait_us(ms * 1000ull);
+}
+
+void sleep_us(uint64_t us) {
+  busy_wait_us(us);
+}
+
+void sleep_ms(uint32_t ms) {
+  busy_wait_us(ms * 1000ull);
+}
+
+void sleep_until(absolute_time_t t) {
+  if (t * 1000 > now_ns)
+    sim_advance_to(t * 1000);
+}
+
+void tight_loop_contents(void) {
+  sim_advance_to(now_ns + SIM_SPIN_NS);
+}
+
+void __sev(void) {
+  // O evento chega aos dois núcleos; o outro, se estiver parado no __wfe, volta agora
+  for (uint core = 0; core < 2; ++core) {
+    event_pending[core] = true;
+    if (core1_launched && core != this_core && core_in_wfe[core])
+      core_wake_ns[core] = now_ns;
+  }
+}
+
+void __wfe(void) {
+  uint core = this_core;
+
+  if (!event_pending[core]) {
+    // Dorme até o próximo alarme (sem nenhum pendente, até o fim da simulação); o núcleo 1 não
+    // recebe as interrupções dos alarmes e só volta com um __sev
+    sim_timer_t *next = core == 0 ? timer_next() : NULL;
+    core_in_wfe[core] = true;
+    sim_advance_to(next ? next->at_ns : UINT64_MAX);
+    core_in_wfe[core] = false;
+  }
+  event_pending[core] = false;
+}
+
+void __wfi(void) {
+  sim_timer_t *next = timer_next();
+  sim_advance_to(next ? next->at_ns : UINT64_MAX);
+}
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+  sim_timer_t *t = timer_add(TIMER_ALARM, now_ns + us * 1000, next_id);
+  if (!t)
+    return PICO_ERROR_GENERIC;
+  t->alarm = callback;
+  t->arg = user_data;
+  return next_id++;
+}
+
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+  return add_alarm_in_us(ms * 1000ull, callback, user_data, fire_if_past);
+}
+
+bool cancel_alarm(alarm_id_t alarm_id) {
+  for (int i = 0; i < SIM_TIMERS; ++i) {
+    if (timers[i].kind != TIMER_FREE && timers[i].kind != TIMER_EVENT && timers[i].id == alarm_id) {
+      timers[i].kind = TIMER_FREE;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out) {
+  uint64_t delay = delay_us < 0 ? (uint64_t)-delay_us : (uint64_t)delay_us;
+  sim_timer_t *t = timer_add(TIMER_REPEATING, now_ns + delay * 1000, next_id);
+  if (!t)
+    return false;
+  out->delay_us = delay_us;
+  out->callback = callback;
+  out->user_data = user_data;
+  out->alarm_id = next_id++;
+  t->timer = out;
+  return true;
+}
+
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out) {
+  return add_repeating_timer_us(delay_ms * 1000ll, callback, user_data, out);
+}
+
+bool cancel_repeating_timer(repeating_timer_t *timer) {
+  return cancel_alarm(timer->alarm_id);
+}
+
+bool stdio_init_all(void) {
+  return true;
+}
+
+// Entrada da USB/UART: fila de caracteres escritos pelo cenário
+static char console_chars[SIM_CONSOLE_LEN];
+static uint console_head, console_len;
+
+void sim_console_push(char c) {
+  if (console_len == SIM_CONSOLE_LEN)
+    return; // Como a FIFO da UART cheia: o caractere se perde
+  console_chars[(console_head + console_len++) % SIM_CONSOLE_LEN] = c;
+}
+
+int getchar_timeout_us(uint32_t timeout_us) {
+  if (!console_len) {
+    if (timeout_us)
+      sim_advance_to(now_ns + timeout_us * 1000ull); // Não chega nada durante a espera
+    return PICO_ERROR_TIMEOUT;
+  }
+  char c = console_chars[console_head];
+  console_head = (console_head + 1) % SIM_CONSOLE_LEN;
+  --console_len;
+  return (unsigned char)c;
+}
@@ -0,0 +1,220 @@
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+#include "hardware/dma.h"
+#include "hardware/adc.h"
+#include "hardware/i2c.h"
+#include "hardware/pio.h"
+
+// Cada canal transfere no ritmo do seu DREQ (ADC, I2C ou PIO); DREQ_FORCE transfere tudo de uma vez
+typedef struct {
+  bool claimed;
+  bool busy;
+  dma_channel_config config;
+  uintptr_t read, write;
+  uint32_t reload;          // Contagem carregada a cada disparo (o registrador lido mostra o restante)
+  uint64_t next_ns;         // Próxima transferência
+  uint64_t transfers;       // Total desde o início
+} sim_channel_t;
+
+dma_hw_t sim_dma_regs;
+
+static sim_channel_t channels[NUM_DMA_CHANNELS];
+
+static void channel_trigger(uint ch, uint64_t t_ns);
+
+static uint64_t dreq_period_ns(uint dreq) {
+  if (dreq == DREQ_ADC)
+    return sim_adc_period_ns();
+  if (dreq == DREQ_I2C0_TX || dreq == DREQ_I2C1_TX)
+    return sim_i2c_byte_ns(dreq == DREQ_I2C1_TX);
+  if (dreq < DREQ_PIO1_TX0 + 4)
+    return sim_pio_word_ns(dreq >= DREQ_PIO1_TX0, dreq & 3);
+  return 0;
+}
+
+// Lê um elemento: a FIFO do ADC gera uma conversão, o resto é memória
+static uint32_t element_read(uintptr_t addr, uint size) {
+  uint32_t v = 0;
+
+  if (addr == (uintptr_t)&adc_hw->fifo)
+    return sim_adc_convert();
+  memcpy(&v, (const void *)addr, size);
+  return v;
+}
+
+// Escreve um elemento: registradores de periféricos vão para os modelos, o resto é memória
+static void element_write(uintptr_t addr, uint32_t v, uint size, uint64_t t_ns) {
+  for (uint i = 0; i < 2; ++i) {
+    if (addr == (uintptr_t)&i2c_get_hw(i ? i2c1 : i2c0)->data_cmd) {
+      sim_i2c_word(i, v);
+      return;
+    }
+    for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; ++sm) {
+      if (addr == (uintptr_t)&sim_pio_regs[i].txf[sm]) {
+        sim_pio_push(i, sm, v, t_ns);
+        return;
+      }
+    }
+  }
+  for (uint ch = 0; ch < NUM_DMA_CHANNELS; ++ch) {
+    if (addr == (uintptr_t)&dma_hw->ch[ch].al1_transfer_count_trig) {
+      // Canal de controle reiniciando outro canal: nova contagem com os endereços atuais
+      channels[ch].reload = v;
+      channel_trigger(ch, t_ns);
+      return;
+    }
+  }
+  memcpy((void *)addr, &v, size);
+}
+
+// Avança um endereço; com anel só os ring_bits de baixo mudam
+static uintptr_t advance(uintptr_t addr, uint size, uint ring_bits) {
+  uintptr_t mask = ((uintptr_t)1 << ring_bits) - 1;
+  return ring_bits ? (addr & ~mask) | ((addr + size) & mask) : addr + size;
+}
+
+static void channel_step(uint ch, uint64_t t_ns) {
+  sim_channel_t *c = &channels[ch];
+  uint size = 1u << c->config.size;
+  uint32_t v = element_read(c->read, size);
+
+  element_write(c->write, v, size, t_ns);
+  if (c->config.read_increment)
+    c->read = advance(c->read, size, c->config.ring_write ? 0 : c->config.ring_bits);
+  if (c->config.write_increment)
+    c->write = advance(c->write, size, c->config.ring_write ? c->config.ring_bits : 0);
+  ++c->transfers;
+
+  if (--dma_hw->ch[ch].transfer_count == 0) {
+    c->busy = false;
+    if (c->config.chain_to != ch)
+      channel_trigger(c->config.chain_to, t_ns);
+  }
+}
+
+static void channel_trigger(uint ch, uint64_t t_ns) {
+  sim_channel_t *c = &channels[ch];
+
+  dma_hw->ch[ch].transfer_count = c->reload;
+  if (c->reload == 0)
+    return;
+  c->busy = true;
+  if (c->config.dreq == DREQ_FORCE) {
+    // Sem DREQ: todas as transferências no mesmo instante
+    while (c->busy)
+      channel_step(ch, t_ns);
+    return;
+  }
+  c->next_ns = t_ns + dreq_period_ns(c->config.dreq);
+}
+
+void sim_dma_run(uint64_t t_ns) {
+  for (uint ch = 0; ch < NUM_DMA_CHANNELS; ++ch) {
+    sim_channel_t *c = &channels[ch];
+
+    while (c->busy && c->next_ns <= t_ns) {
+      uint64_t period = dreq_period_ns(c->config.dreq);
+      if (period == 0) { // Periférico parado (ADC desligado): o canal espera
+        c->next_ns = t_ns + 1;
+        break;
+      }
+      uint64_t at = c->next_ns;
+      c->next_ns += period; // Um reinício pelo encadeamento durante o passo recalcula o próximo
+      channel_step(ch, at);
+    }
+  }
+}
+
+int dma_claim_unused_channel(bool required) {
+  for (uint ch = 0; ch < NUM_DMA_CHANNELS; ++ch) {
+    if (!channels[ch].claimed) {
+      channels[ch].claimed = true;
+      return ch;
+    }
+  }
+  if (required) {
+    fprintf(stderr, "sim: nenhum canal de DMA livre\n");
+    exit(1);
+  }
+  return -1;
+}
+
+void dma_channel_claim(uint channel) {
+  channels[channel].claimed = true;
+}
+
+void dma_channel_unclaim(uint channel) {
+  channels[channel].claimed = false;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+  // Mesmos padrões do SDK: 32 bits, leitura incrementa, sem DREQ, encadeado a si mesmo (sem cadeia)
+  return (dma_channel_config){DMA_SIZE_32, true, false, DREQ_FORCE, 0, false, channel, true};
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint32_t transfer_count, bool trigger) {
+  sim_channel_t *c = &channels[channel];
+
+  c->config = *config;
+  c->write = (uintptr_t)write_addr;
+  c->read = (uintptr_t)read_addr;
+  c->reload = transfer_count;
+  dma_hw->ch[channel].transfer_count = transfer_count;
+  if (trigger)
+    channel_trigger(channel, sim_now_ns());
+}
+
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger) {
+  channels[channel].read = (uintptr_t)read_addr;
+  if (trigger)
+    channel_trigger(channel, sim_now_ns());
+}
+
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger) {
+  channels[channel].write = (uintptr_t)write_addr;
+  if (trigger)
+    channel_trigger(channel, sim_now_ns());
+}
+
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger) {
+  channels[channel].reload = trans_count;
+  if (trigger)
+    channel_trigger(channel, sim_now_ns());
+}
+
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count) {
+  channels[channel].read = (uintptr_t)read_addr;
+  channels[channel].reload = transfer_count;
+  channel_trigger(channel, sim_now_ns());
+}
+
+void dma_channel_start(uint channel) {
+  channel_trigger(channel, sim_now_ns());
+}
+
+void dma_channel_abort(uint channel) {
+  channels[channel].busy = false;
+  dma_hw->ch[channel].transfer_count = 0;
+  for (uint i = 0; i < 2; ++i) {
+    if (channels[channel].write == (uintptr_t)&i2c_get_hw(i ? i2c1 : i2c0)->data_cmd)
+      sim_i2c_clear_abort(i);
+  }
+}
+
+bool dma_channel_is_busy(uint channel) {
+  return channels[channel].busy;
+}
+
+void dma_channel_wait_for_finish_blocking(uint channel) {
+  while (channels[channel].busy)
+    tight_loop_contents();
+}
+
+void sim_dma_report(FILE *out) {
+  for (uint ch = 0; ch < NUM_DMA_CHANNELS; ++ch) {
+    if (channels[ch].claimed)
+      fprintf(out, "dma %u: %llu transferências\n", ch, (unsigned long long)channels[ch].transfers);
+  }
+}
@@ -0,0 +1,101 @@
+#include "sim.h"
+
+typedef struct {
+  bool out;             // Direção
+  bool value;           // Valor escrito com gpio_put
+  bool pull_up, pull_down;
+  int drive;            // Nível forçado de fora (-1: solto)
+  uint32_t irq_mask;
+} sim_pin_t;
+
+static sim_pin_t pins[NUM_BANK0_GPIOS];
+static bool pins_ready;
+static gpio_irq_callback_t irq_callback;
+static uint32_t irq_count;
+
+static sim_pin_t *pin(uint gpio) {
+  if (!pins_ready) {
+    for (uint i = 0; i < NUM_BANK0_GPIOS; ++i)
+      pins[i].drive = -1;
+    pins_ready = true;
+  }
+  return &pins[gpio % NUM_BANK0_GPIOS];
+}
+
+void gpio_init(uint gpio) {
+  sim_pin_t *p = pin(gpio);
+  p->out = false;
+  p->value = false;
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn) {
+  (void)pin(gpio);
+  (void)fn;
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+  pin(gpio)->out = out;
+}
+
+void gpio_pull_up(uint gpio) {
+  pin(gpio)->pull_up = true;
+  pin(gpio)->pull_down = false;
+}
+
+void gpio_pull_down(uint gpio) {
+  pin(gpio)->pull_up = false;
+  pin(gpio)->pull_down = true;
+}
+
+void gpio_disable_pulls(uint gpio) {
+  pin(gpio)->pull_up = false;
+  pin(gpio)->pull_down = false;
+}
+
+bool gpio_get(uint gpio) {
+  sim_pin_t *p = pin(gpio);
+
+  if (p->out)
+    return p->value;
+  if (p->drive >= 0)
+    return p->drive;
+  return p->pull_up; // Sem pull o pino flutua; aqui lê 0
+}
+
+void gpio_put(uint gpio, bool value) {
+  pin(gpio)->value = value;
+}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled) {
+  sim_pin_t *p = pin(gpio);
+
+  if (enabled)
+    p->irq_mask |= event_mask;
+  else
+    p->irq_mask &= ~event_mask;
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t callback) {
+  gpio_set_irq_enabled(gpio, event_mask, enabled);
+  irq_callback = callback; // Como no SDK, um único callback por núcleo
+}
+
+void sim_gpio_drive(uint gpio, int level) {
+  bool before = gpio_get(gpio);
+  sim_pin_t *p = pin(gpio);
+
+  p->drive = level;
+  bool after = gpio_get(gpio);
+  if (after == before || !irq_callback)
+    return;
+
+  uint32_t edge = after ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL;
+  if (p->irq_mask & edge) {
+    ++irq_count;
+    irq_callback(gpio, edge);
+  }
+}
+
+uint32_t sim_gpio_irqs(void) {
+  return irq_count;
+}
@@ -0,0 +1,222 @@
+#include <string.h>
+#include "sim.h"
+#include "hardware/i2c.h"
+
+#define SSD1306_ADDRESS 0x3C
+
+// Controlador SSD1306 no barramento: decodifica bytes de controle, comandos e dados para uma GRAM
+typedef struct {
+  uint8_t gram[8][128];
+  uint8_t col, page;
+  uint8_t col_start, col_end, page_start, page_end;
+  uint8_t mode;            // 0: horizontal, 1: vertical, 2: página
+  bool on;
+  uint8_t cmd[3];          // Comando em montagem (com argumentos)
+  uint8_t cmd_len;
+  bool expect_control;     // Próximo byte da transação é de controle
+  bool stream_data;        // Fluxo atual é de dados (senão, comandos)
+  bool single;             // Co = 1: só um byte antes do próximo controle
+  uint32_t data_bytes, command_bytes;
+} ssd1306_model_t;
+
+typedef struct {
+  uint baudrate;
+  bool in_transaction;
+  uint8_t address;
+  uint64_t transactions, bytes;
+  uint32_t nack_after;     // Bytes até o alvo não confirmar (0: sem falha programada)
+} sim_i2c_t;
+
+static i2c_hw_t regs[2];
+i2c_inst_t i2c0_inst = {&regs[0], 0}, i2c1_inst = {&regs[1], 1};
+
+static sim_i2c_t buses[2];
+static ssd1306_model_t display = {.col_end = 127, .page_end = 7};
+
+// Bytes de argumentos de cada comando do SSD1306
+static uint8_t command_args(uint8_t c) {
+  switch (c) {
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+      return 1;
+    case 0x21: case 0x22:
+      return 2;
+    default:
+      return 0;
+  }
+}
+
+static void display_command(ssd1306_model_t *d) {
+  uint8_t c = d->cmd[0];
+
+  if (c == 0x20) {
+    d->mode = d->cmd[1] & 3;
+  } else if (c == 0x21) {
+    d->col_start = d->col = d->cmd[1] & 127;
+    d->col_end = d->cmd[2] & 127;
+  } else if (c == 0x22) {
+    d->page_start = d->page = d->cmd[1] & 7;
+    d->page_end = d->cmd[2] & 7;
+  } else if (c == 0xAE || c == 0xAF) {
+    d->on = c & 1;
+  } else if (c >= 0xB0 && c <= 0xB7) {
+    d->page = c & 7;
+  } else if (c < 0x10) {
+    d->col = (d->col & 0xF0) | c;
+  } else if (c < 0x20) {
+    d->col = (d->col & 0x0F) | (c & 0x0F) << 4;
+  }
+}
+
+static void display_data(ssd1306_model_t *d, uint8_t v) {
+  d->gram[d->page][d->col] = v;
+  ++d->data_bytes;
+  if (d->mode == 2) { // Página: só a coluna avança
+    d->col = (d->col + 1) & 127;
+    return;
+  }
+  if (d->mode == 1) { // Vertical
+    if (d->page++ == d->page_end) {
+      d->page = d->page_start;
+      d->col = d->col == d->col_end ? d->col_start : d->col + 1;
+    }
+    return;
+  }
+  if (d->col++ == d->col_end) { // Horizontal
+    d->col = d->col_start;
+    d->page = d->page == d->page_end ? d->page_start : d->page + 1;
+  }
+}
+
+static void display_byte(ssd1306_model_t *d, uint8_t v) {
+  if (d->expect_control) {
+    d->single = v & 0x80;
+    d->stream_data = v & 0x40;
+    d->expect_control = false;
+    return;
+  }
+  if (d->stream_data) {
+    display_data(d, v);
+  } else {
+    ++d->command_bytes;
+    d->cmd[d->cmd_len++] = v;
+    if (d->cmd_len > command_args(d->cmd[0])) {
+      display_command(d);
+      d->cmd_len = 0;
+    }
+  }
+  if (d->single)
+    d->expect_control = true;
+}
+
+// Um byte no barramento; stop encerra a transação
+static void bus_byte(uint index, uint8_t v, bool stop) {
+  sim_i2c_t *bus = &buses[index];
+
+  // Depois de um NACK o controlador descarta a FIFO até o abort ser limpo
+  if (regs[index].raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS)
+    return;
+  if (bus->nack_after && !--bus->nack_after) {
+    regs[index].raw_intr_stat |= I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS;
+    bus->in_transaction = false;
+    return;
+  }
+  if (!bus->in_transaction) {
+    bus->in_transaction = true;
+    bus->address = regs[index].tar & 0x7F;
+    ++bus->transactions;
+    ++bus->bytes; // Byte de endereço
+    if (bus->address == SSD1306_ADDRESS) {
+      display.expect_control = true;
+      display.cmd_len = 0; // Comando cortado por uma transação abortada é descartado
+    }
+  }
+  ++bus->bytes;
+  if (bus->address == SSD1306_ADDRESS)
+    display_byte(&display, v);
+  if (stop)
+    bus->in_transaction = false;
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+  buses[i2c->index].baudrate = baudrate;
+  i2c->hw->status = I2C_IC_STATUS_TFE_BITS; // A FIFO só enche dentro de uma transferência do modelo
+  return baudrate;
+}
+
+uint64_t sim_i2c_byte_ns(uint index) {
+  uint baud = buses[index].baudrate ? buses[index].baudrate : 100000;
+  return 9ull * 1000000000ull / baud; // 8 bits + ACK
+}
+
+void sim_i2c_word(uint index, uint32_t data_cmd) {
+  bus_byte(index, data_cmd & 0xFF, data_cmd & I2C_IC_DATA_CMD_STOP_BITS);
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+  i2c->hw->tar = addr;
+  for (size_t i = 0; i < len; ++i)
+    bus_byte(i2c->index, src[i], !nostop && i == len - 1);
+  busy_wait_us((len + 1) * sim_i2c_byte_ns(i2c->index) / 1000);
+  return (int)len;
+}
+
+void sim_i2c_nack(uint index, uint32_t after_bytes) {
+  buses[index].nack_after = after_bytes;
+}
+
+void sim_i2c_clear_abort(uint index) {
+  regs[index].raw_intr_stat &= ~I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS;
+  buses[index].in_transaction = false;
+}
+
+uint64_t sim_i2c_transactions(uint index) {
+  return buses[index].transactions;
+}
+
+uint64_t sim_i2c_bytes(uint index) {
+  return buses[index].bytes;
+}
+
+uint32_t sim_display_command_bytes(void) {
+  return display.command_bytes;
+}
+
+uint32_t sim_display_data_bytes(void) {
+  return display.data_bytes;
+}
+
+bool sim_display_on(void) {
+  return display.on;
+}
+
+uint8_t sim_display_gram(uint page, uint col) {
+  return display.gram[page & 7][col & 127];
+}
+
+void sim_i2c_report(FILE *out, double seconds) {
+  for (uint i = 0; i < 2; ++i) {
+    sim_i2c_t *bus = &buses[i];
+    if (!bus->baudrate)
+      continue;
+    double busy = bus->bytes * sim_i2c_byte_ns(i) / 1e9;
+    fprintf(out, "i2c%u: %llu transações, %llu bytes (%.0f bytes/s, barramento ocupado %.1f%%)\n", i,
+            (unsigned long long)bus->transactions, (unsigned long long)bus->bytes, bus->bytes / seconds,
+            100.0 * busy / seconds);
+  }
+  fprintf(out, "ssd1306: %u bytes de dados, %u bytes de comandos\n", display.data_bytes, display.command_bytes);
+}
+
+void sim_display_dump(FILE *out) {
+  // Duas linhas de pixels por linha de texto
+  fprintf(out, "+--------------------------------------------------------------------------------------------------------------------------------+\n");
+  for (uint y = 0; y < 64; y += 2) {
+    fputc('|', out);
+    for (uint x = 0; x < 128; ++x) {
+      bool top = display.gram[y / 8][x] >> (y % 8) & 1;
+      bool bottom = display.gram[(y + 1) / 8][x] >> ((y + 1) % 8) & 1;
+      fputs(!display.on ? " " : top && bottom ? "█" : top ? "▀" : bottom ? "▄" : " ", out);
+    }
+    fputs("|\n", out);
+  }
+  fprintf(out, "+--------------------------------------------------------------------------------------------------------------------------------+\n");
+}
@@ -0,0 +1,39 @@
+#include "sim.h"
+#include "hardware/sync.h"
+#include "pico/multicore.h"
+
+#define SIM_FIFO_LEN 8 // Palavras em cada sentido, como no SIO
+
+// FIFOs entre os núcleos: fifo[n] é a que o núcleo n lê. Como no SDK, quem espera dorme no __wfe e
+// quem escreve ou lê acorda o outro lado com __sev
+typedef struct {
+  uint32_t data[SIM_FIFO_LEN];
+  uint head, count;
+} sim_fifo_t;
+
+static sim_fifo_t fifo[2];
+
+void multicore_launch_core1(void (*entry)(void)) {
+  sim_core1_launch(entry);
+}
+
+void multicore_fifo_push_blocking(uint32_t data) {
+  sim_fifo_t *f = &fifo[!get_core_num()];
+
+  while (f->count == SIM_FIFO_LEN)
+    __wfe();
+  f->data[(f->head + f->count++) % SIM_FIFO_LEN] = data;
+  __sev();
+}
+
+uint32_t multicore_fifo_pop_blocking(void) {
+  sim_fifo_t *f = &fifo[get_core_num()];
+
+  while (!f->count)
+    __wfe();
+  uint32_t data = f->data[f->head];
+  f->head = (f->head + 1) % SIM_FIFO_LEN;
+  --f->count;
+  __sev();
+  return data;
+}
@@ -0,0 +1,146 @@
+#include <stdlib.h>
+#include "sim.h"
+#include "hardware/pio.h"
+
+#define SIM_LEDS 64            // LEDs guardados por quadro
+#define WS2812_RESET_NS 50000  // Linha parada por 50 us trava o quadro
+
+// Matriz WS2812 ligada a uma máquina de estados. O programa desloca para a direita: cada palavra
+// sai pelos pull_bits bits de baixo, byte a byte a partir do menos significativo, e cada 3 bytes no
+// fio são o G, o R e o B de um LED
+typedef struct {
+  bool used;
+  uint pin;
+  uint pull_bits;              // Bits por palavra (autopull do programa)
+  uint64_t bit_ns;             // Um bit na frequência do programa
+  uint8_t pending[SIM_LEDS * 3];
+  uint count;                  // Bytes do quadro em andamento
+  uint64_t last_ns;            // Fim da última palavra
+  uint8_t wire[SIM_LEDS * 3];  // Último quadro travado, como saiu no fio
+  uint wire_count;
+  uint64_t frames, words;
+} sim_sm_t;
+
+pio_hw_t sim_pio_regs[2];
+
+static sim_sm_t machines[2][NUM_PIO_STATE_MACHINES];
+static uint8_t claimed[2];
+
+uint pio_add_program(PIO pio, const pio_program_t *program) {
+  (void)pio;
+  (void)program;
+  return 0;
+}
+
+int pio_claim_unused_sm(PIO pio, bool required) {
+  uint p = pio_get_index(pio);
+
+  for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; ++sm) {
+    if (!(claimed[p] & (1u << sm))) {
+      claimed[p] |= 1u << sm;
+      return sm;
+    }
+  }
+  if (required) {
+    fprintf(stderr, "sim: nenhuma máquina de estados livre\n");
+    exit(1);
+  }
+  return -1;
+}
+
+void ws2812_program_init(PIO pio, uint sm, uint offset, uint pin, float freq) {
+  sim_sm_t *m = &machines[pio_get_index(pio)][sm];
+
+  (void)offset;
+  m->used = true;
+  m->pin = pin;
+  m->pull_bits = 24; // sm_config_set_out_shift(&c, true, true, 24) do ws2812.pio
+  m->bit_ns = (uint64_t)(1e9 / freq);
+}
+
+void sim_pio_set_pull_bits(uint pio, uint sm, uint bits) {
+  machines[pio][sm].pull_bits = bits;
+}
+
+uint64_t sim_pio_word_ns(uint pio, uint sm) {
+  return machines[pio][sm].bit_ns * machines[pio][sm].pull_bits;
+}
+
+void sim_pio_push(uint pio, uint sm, uint32_t word, uint64_t t_ns) {
+  sim_sm_t *m = &machines[pio][sm];
+
+  sim_pio_run(t_ns); // Uma pausa longa antes desta palavra já travou o quadro anterior
+  for (uint bit = 0; bit < m->pull_bits; bit += 8) {
+    if (m->count < sizeof(m->pending))
+      m->pending[m->count] = (uint8_t)(word >> bit);
+    ++m->count;
+  }
+  ++m->words;
+  m->last_ns = t_ns + m->bit_ns * m->pull_bits;
+}
+
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) {
+  sim_pio_push(pio_get_index(pio), sm, data, sim_now_ns());
+  busy_wait_us(sim_pio_word_ns(pio_get_index(pio), sm) / 1000);
+}
+
+void sim_pio_run(uint64_t t_ns) {
+  for (uint p = 0; p < 2; ++p) {
+    for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; ++sm) {
+      sim_sm_t *m = &machines[p][sm];
+      if (!m->count || t_ns < m->last_ns + WS2812_RESET_NS)
+        continue;
+      m->wire_count = m->count < sizeof(m->wire) ? m->count : sizeof(m->wire);
+      for (uint i = 0; i < m->wire_count; ++i)
+        m->wire[i] = m->pending[i];
+      m->count = 0;
+      ++m->frames;
+    }
+  }
+}
+
+void sim_pio_report(FILE *out) {
+  for (uint p = 0; p < 2; ++p) {
+    for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; ++sm) {
+      sim_sm_t *m = &machines[p][sm];
+      if (m->used)
+        fprintf(out, "ws2812 (pio%u sm%u, gpio %u): %llu quadros, %llu palavras\n", p, sm, m->pin,
+                (unsigned long long)m->frames, (unsigned long long)m->words);
+    }
+  }
+}
+
+void sim_leds_dump(FILE *out) {
+  for (uint p = 0; p < 2; ++p) {
+    for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; ++sm) {
+      sim_sm_t *m = &machines[p][sm];
+      if (!m->used)
+        continue;
+      // Cores em RRGGBB, na ordem em que os LEDs estão encadeados
+      uint leds = m->wire_count / 3;
+      for (uint i = 0; i < leds; ++i) {
+        const uint8_t *grb = &m->wire[3 * i];
+        fprintf(out, "%02x%02x%02x%c", grb[1], grb[0], grb[2], i % 5 == 4 ? '\n' : ' ');
+      }
+      if (leds % 5)
+        fputc('\n', out);
+    }
+  }
+}
+
+uint sim_pio_wire(uint pio, uint sm, uint8_t *bytes, uint max) {
+  const sim_sm_t *m = &machines[pio][sm];
+  uint n = m->wire_count < max ? m->wire_count : max;
+
+  for (uint i = 0; i < n; ++i)
+    bytes[i] = m->wire[i];
+  return m->wire_count;
+}
+
+uint64_t sim_pio_frames(uint pio, uint sm) {
+  return machines[pio][sm].frames;
+}
+
+uint64_t sim_pio_words(uint pio, uint sm) {
+  return machines[pio][sm].words;
+}
@@ -0,0 +1,73 @@
+#include "sim.h"
+#include "hardware/pwm.h"
+
+typedef struct {
+  float div;
+  uint16_t wrap;
+  bool enabled;
+  uint16_t level[2];
+  uint gpio[2];         // Pino de cada canal (os slices se repetem nos GPIOs 16 a 29)
+  uint32_t writes[2];   // Escritas de nível (mesmo sem mudança de valor)
+  uint32_t changes[2];  // Escritas que mudaram o nível
+} sim_slice_t;
+
+static sim_slice_t slices[NUM_PWM_SLICES];
+
+void pwm_set_clkdiv(uint slice_num, float divider) {
+  slices[slice_num].div = divider;
+}
+
+void pwm_set_clkdiv_int_frac(uint slice_num, uint8_t integer, uint8_t fract) {
+  slices[slice_num].div = integer + fract / 16.0f;
+}
+
+void pwm_set_wrap(uint slice_num, uint16_t wrap) {
+  slices[slice_num].wrap = wrap;
+}
+
+void pwm_set_chan_level(uint slice_num, uint chan, uint16_t level) {
+  sim_slice_t *s = &slices[slice_num];
+
+  ++s->writes[chan];
+  if (s->level[chan] != level)
+    ++s->changes[chan];
+  s->level[chan] = level;
+}
+
+void pwm_set_gpio_level(uint gpio, uint16_t level) {
+  slices[pwm_gpio_to_slice_num(gpio)].gpio[pwm_gpio_to_channel(gpio)] = gpio;
+  pwm_set_chan_level(pwm_gpio_to_slice_num(gpio), pwm_gpio_to_channel(gpio), level);
+}
+
+void pwm_set_enabled(uint slice_num, bool enabled) {
+  slices[slice_num].enabled = enabled;
+}
+
+uint16_t sim_pwm_level(uint gpio) {
+  return slices[pwm_gpio_to_slice_num(gpio)].level[pwm_gpio_to_channel(gpio)];
+}
+
+uint32_t sim_pwm_top(uint gpio) {
+  return slices[pwm_gpio_to_slice_num(gpio)].wrap + 1u;
+}
+
+double sim_pwm_hz(uint gpio) {
+  sim_slice_t *p = &slices[pwm_gpio_to_slice_num(gpio)];
+  return 125e6 / (p->div ? p->div : 1) / (p->wrap + 1);
+}
+
+void sim_pwm_report(FILE *out) {
+  for (uint s = 0; s < NUM_PWM_SLICES; ++s) {
+    sim_slice_t *p = &slices[s];
+    if (!p->enabled)
+      continue;
+    double hz = 125e6 / (p->div ? p->div : 1) / (p->wrap + 1);
+    for (uint c = 0; c < 2; ++c) {
+      if (!p->writes[c])
+        continue;
+      fprintf(out, "pwm %u%c (gpio %u): nível %u/%u (%.1f%%) a %.1f Hz, %u escritas, %u mudanças\n", s, 'A' + c,
+              p->gpio[c], p->level[c], p->wrap + 1, 100.0 * p->level[c] / (p->wrap + 1), hz,
+              p->writes[c], p->changes[c]);
+    }
+  }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+
+// Relógio virtual em nanossegundos (o SDK só enxerga microssegundos)
+uint64_t sim_now_ns(void);
+
+// Avança o relógio até t_ns, processando as DMAs e disparando os alarmes vencidos pelo caminho
+void sim_advance_to(uint64_t t_ns);
+
+// Evento do cenário no instante t_ns (mesma fila dos alarmes do SDK)
+typedef void (*sim_event_fn)(void *arg);
+bool sim_at(uint64_t t_ns, sim_event_fn fn, void *arg);
+
+// Instante em que a simulação termina: on_end é chamado e o programa sai
+void sim_set_end(uint64_t t_ns, void (*on_end)(void));
+
+// Núcleo 1 em uma thread: os dois núcleos se alternam nas esperas do relógio virtual (sim_advance_to)
+void sim_core1_launch(void (*entry)(void));
+
+// Periféricos (chamados pelo relógio a cada avanço)
+void sim_dma_run(uint64_t t_ns);
+void sim_pio_run(uint64_t t_ns);
+
+// ADC
+void sim_adc_set(uint input, uint16_t value);
+void sim_adc_noise(uint input, uint16_t amplitude);
+uint16_t sim_adc_convert(void);    // Próxima conversão da varredura (leitura da FIFO pela DMA)
+uint64_t sim_adc_period_ns(void);  // 0 com o ADC parado
+
+// GPIO: nível forçado de fora (botões); -1 solta o pino para o pull-up/pull-down
+void sim_gpio_drive(uint gpio, int level);
+uint32_t sim_gpio_irqs(void);
+
+// I2C e display SSD1306
+uint64_t sim_i2c_byte_ns(uint index);
+void sim_i2c_word(uint index, uint32_t data_cmd); // Palavra escrita no IC_DATA_CMD
+
+// Falha programada: o alvo deixa de confirmar depois de after_bytes bytes (TX_ABRT, o resto é
+// descartado). A leitura de IC_CLR_TX_ABRT não tem efeito no modelo: o abort é limpo quando a DMA
+// que alimenta a FIFO é abortada, que é o que o driver faz logo antes da leitura
+void sim_i2c_nack(uint index, uint32_t after_bytes);
+void sim_i2c_clear_abort(uint index);
+void sim_i2c_report(FILE *out, double seconds);
+void sim_display_dump(FILE *out);
+
+// Contadores do barramento (transações e bytes, contando o byte de endereço) e a GRAM do display,
+// para os testes
+uint64_t sim_i2c_transactions(uint index);
+uint64_t sim_i2c_bytes(uint index);
+uint32_t sim_display_command_bytes(void);
+uint32_t sim_display_data_bytes(void);
+bool sim_display_on(void);
+uint8_t sim_display_gram(uint page, uint col);
+
+// PIO e matriz WS2812
+uint64_t sim_pio_word_ns(uint pio, uint sm);
+void sim_pio_push(uint pio, uint sm, uint32_t word, uint64_t t_ns);
+void sim_pio_report(FILE *out);
+void sim_leds_dump(FILE *out);
+
+// Programa com outro autopull (o ws2812.pio antigo mandava 8 bits por palavra)
+void sim_pio_set_pull_bits(uint pio, uint sm, uint bits);
+
+// Último quadro travado, byte a byte como saiu no fio (retorna quantos bytes tinha), e os
+// contadores de quadros e de palavras recebidas pela FIFO, para os testes
+uint sim_pio_wire(uint pio, uint sm, uint8_t *bytes, uint max);
+uint64_t sim_pio_frames(uint pio, uint sm);
+uint64_t sim_pio_words(uint pio, uint sm);
+
+// Entrada da USB/UART (lida pelo firmware com getchar_timeout_us)
+void sim_console_push(char c);
+
+// USB CDC (saída em arquivo; sem arquivo o terminal é considerado fechado)
+bool sim_usb_open(const char *path);
+void sim_usb_report(FILE *out);
+
+// Bytes que o computador lê da FIFO de transmissão da CDC por ms (0: parou de ler), tamanho da
+// FIFO (com ela vazia), bytes na FIFO e total escrito no arquivo, para os testes
+void sim_usb_set_rate(uint32_t bytes_per_ms);
+void sim_usb_set_fifo_size(uint32_t size);
+uint32_t sim_usb_fifo(void);
+uint64_t sim_usb_bytes(void);
+
+// PWM
+void sim_pwm_report(FILE *out);
+
+// Estado atual do canal do pino: nível, período em contagens (wrap + 1) e frequência, para os testes
+uint16_t sim_pwm_level(uint gpio);
+uint32_t sim_pwm_top(uint gpio);
+double sim_pwm_hz(uint gpio);
+
+// DMA
+void sim_dma_report(FILE *out);
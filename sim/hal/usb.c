@@ -0,0 +1,106 @@
+#include "sim.h"
+#include "pico/stdio_usb.h"
+#include "hardware/uart.h"
+#include "tusb.h"
+
+// USB CDC e UART: os bytes enviados pelo firmware vão para um arquivo, no formato em que chegariam
+// ao computador (sem a conversão de \n do printf)
+static FILE *usb_out;
+static uint64_t usb_bytes;
+
+// FIFO de transmissão da CDC (CFG_TUD_CDC_TX_BUFSIZE do stdio da USB no SDK): o computador lê
+// usb_rate bytes a cada quadro de 1 ms. Só a ocupação é modelada; os bytes vão para o arquivo na
+// escrita
+#define SIM_CDC_TX_BUFSIZE 256
+#define SIM_USB_FRAME_US 1000
+static uint32_t usb_rate = 640;   // 10 pacotes de 64 bytes por quadro
+static uint32_t usb_fifo_size = SIM_CDC_TX_BUFSIZE;
+static uint32_t usb_fifo;         // Bytes na FIFO
+static uint64_t usb_frame;        // Último quadro em que a FIFO foi esvaziada
+static uint64_t usb_refused;      // Bytes oferecidos pelo firmware que não couberam
+
+static void usb_out_chars(const char *buf, int len) {
+  if (!usb_out)
+    return;
+  fwrite(buf, 1, len, usb_out);
+  usb_bytes += len;
+}
+
+stdio_driver_t stdio_usb = { usb_out_chars };
+
+uart_inst_t sim_uart0 = { 0 };
+
+bool uart_is_writable(uart_inst_t *uart) {
+  return true;
+}
+
+void uart_putc_raw(uart_inst_t *uart, char c) {
+  usb_out_chars(&c, 1);
+}
+
+// Esvazia a FIFO pelos quadros que passaram desde a última consulta
+static void usb_fifo_run(void) {
+  uint64_t frame = time_us_64() / SIM_USB_FRAME_US;
+  uint64_t drained = (frame - usb_frame) * usb_rate;
+
+  usb_fifo = drained >= usb_fifo ? 0 : usb_fifo - (uint32_t)drained;
+  usb_frame = frame;
+}
+
+uint32_t tud_cdc_write_available(void) {
+  usb_fifo_run();
+  return usb_fifo_size - usb_fifo;
+}
+
+uint32_t tud_cdc_write(const void *buffer, uint32_t bufsize) {
+  uint32_t room = tud_cdc_write_available();
+  uint32_t n = bufsize < room ? bufsize : room;
+
+  usb_refused += bufsize - n;
+  usb_out_chars(buffer, (int)n);
+  usb_fifo += n;
+  return n;
+}
+
+// O envio agendado vira a gravação do arquivo
+uint32_t tud_cdc_write_flush(void) {
+  if (usb_out)
+    fflush(usb_out);
+  return 0;
+}
+
+void sim_usb_set_rate(uint32_t bytes_per_ms) {
+  usb_fifo_run();
+  usb_rate = bytes_per_ms;
+}
+
+void sim_usb_set_fifo_size(uint32_t size) {
+  usb_fifo_run();
+  usb_fifo_size = size;
+}
+
+uint32_t sim_usb_fifo(void) {
+  usb_fifo_run();
+  return usb_fifo;
+}
+
+uint64_t sim_usb_bytes(void) {
+  return usb_bytes;
+}
+
+bool stdio_usb_connected(void) {
+  return usb_out != NULL;
+}
+
+bool sim_usb_open(const char *path) {
+  usb_out = fopen(path, "wb");
+  return usb_out != NULL;
+}
+
+void sim_usb_report(FILE *out) {
+  if (usb_out) {
+    fflush(usb_out);
+    fprintf(out, "usb/uart: %llu bytes enviados, %llu recusados com a FIFO da CDC cheia\n",
+            (unsigned long long)usb_bytes, (unsigned long long)usb_refused);
+  }
+}
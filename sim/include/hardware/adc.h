@@ -0,0 +1,24 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+#define DREQ_ADC 36
+
+typedef struct {
+  volatile uint32_t cs, result, fcs, fifo, div, intr, inte, intf, ints;
+} adc_hw_t;
+
+extern adc_hw_t sim_adc_regs;
+#define adc_hw (&sim_adc_regs)
+
+void adc_init(void);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint input);
+uint adc_get_selected_input(void);
+void adc_set_round_robin(uint input_mask);
+void adc_set_temp_sensor_enabled(bool enable);
+uint16_t adc_read(void);
+void adc_run(bool run);
+void adc_set_clkdiv(float clkdiv);
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift);
+void adc_fifo_drain(void);
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+enum clock_index { clk_gpout0, clk_gpout1, clk_gpout2, clk_gpout3, clk_ref, clk_sys, clk_peri, clk_usb, clk_adc, clk_rtc };
+
+// Clocks padrão do SDK
+static inline uint32_t clock_get_hz(enum clock_index clk) {
+  return clk == clk_usb || clk == clk_adc ? 48000000 : clk == clk_ref ? 12000000 : 125000000;
+}
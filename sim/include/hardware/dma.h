@@ -0,0 +1,78 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+#define NUM_DMA_CHANNELS 12
+#define DREQ_FORCE 63
+
+enum dma_channel_transfer_size { DMA_SIZE_8 = 0, DMA_SIZE_16 = 1, DMA_SIZE_32 = 2 };
+
+// Os campos do CTRL que o modelo de DMA usa, em vez do registrador empacotado
+typedef struct {
+  enum dma_channel_transfer_size size;
+  bool read_increment, write_increment;
+  uint dreq;
+  uint ring_bits;
+  bool ring_write;
+  uint chain_to;
+  bool enable;
+} dma_channel_config;
+
+typedef struct {
+  volatile uint32_t read_addr, write_addr, transfer_count, ctrl_trig;
+  volatile uint32_t al1_ctrl, al1_read_addr, al1_write_addr, al1_transfer_count_trig;
+  volatile uint32_t al2_ctrl, al2_transfer_count, al2_read_addr, al2_write_addr_trig;
+  volatile uint32_t al3_ctrl, al3_write_addr, al3_transfer_count, al3_read_addr_trig;
+} dma_channel_hw_t;
+
+typedef struct {
+  dma_channel_hw_t ch[NUM_DMA_CHANNELS];
+} dma_hw_t;
+
+extern dma_hw_t sim_dma_regs;
+#define dma_hw (&sim_dma_regs)
+
+int dma_claim_unused_channel(bool required);
+void dma_channel_claim(uint channel);
+void dma_channel_unclaim(uint channel);
+dma_channel_config dma_channel_get_default_config(uint channel);
+
+static inline void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+  c->size = size;
+}
+
+static inline void channel_config_set_read_increment(dma_channel_config *c, bool incr) {
+  c->read_increment = incr;
+}
+
+static inline void channel_config_set_write_increment(dma_channel_config *c, bool incr) {
+  c->write_increment = incr;
+}
+
+static inline void channel_config_set_dreq(dma_channel_config *c, uint dreq) {
+  c->dreq = dreq;
+}
+
+static inline void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits) {
+  c->ring_write = write;
+  c->ring_bits = size_bits;
+}
+
+static inline void channel_config_set_chain_to(dma_channel_config *c, uint chain_to) {
+  c->chain_to = chain_to;
+}
+
+static inline void channel_config_set_enable(dma_channel_config *c, bool enable) {
+  c->enable = enable;
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint32_t transfer_count, bool trigger);
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger);
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger);
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger);
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count);
+void dma_channel_start(uint channel);
+void dma_channel_abort(uint channel);
+bool dma_channel_is_busy(uint channel);
+void dma_channel_wait_for_finish_blocking(uint channel);
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+#define I2C_IC_DATA_CMD_STOP_BITS 0x00000200u
+#define I2C_IC_STATUS_TFE_BITS 0x00000004u
+#define I2C_IC_STATUS_MST_ACTIVITY_BITS 0x00000020u
+#define I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS 0x00000040u
+
+#define DREQ_I2C0_TX 32
+#define DREQ_I2C1_TX 34
+
+typedef struct {
+  volatile uint32_t enable, tar, data_cmd, status, raw_intr_stat, clr_tx_abrt;
+} i2c_hw_t;
+
+typedef struct i2c_inst {
+  i2c_hw_t *hw;
+  uint index;
+} i2c_inst_t;
+
+extern i2c_inst_t i2c0_inst, i2c1_inst;
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+static inline i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c) {
+  return i2c->hw;
+}
+
+static inline uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx) {
+  return (i2c->index ? DREQ_I2C1_TX : DREQ_I2C0_TX) + (is_tx ? 0 : 1);
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
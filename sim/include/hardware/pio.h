@@ -0,0 +1,38 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+#define NUM_PIO_STATE_MACHINES 4
+
+// DREQ de transmissão da máquina sm: 0 a 3 no PIO0 e 8 a 11 no PIO1
+#define DREQ_PIO0_TX0 0
+#define DREQ_PIO1_TX0 8
+
+typedef struct pio_hw {
+  volatile uint32_t txf[NUM_PIO_STATE_MACHINES];
+  volatile uint32_t rxf[NUM_PIO_STATE_MACHINES];
+} pio_hw_t;
+
+typedef pio_hw_t *PIO;
+
+extern pio_hw_t sim_pio_regs[2];
+#define pio0 (&sim_pio_regs[0])
+#define pio1 (&sim_pio_regs[1])
+
+typedef struct pio_program {
+  const uint16_t *instructions;
+  uint8_t length;
+  int8_t origin;
+} pio_program_t;
+
+static inline uint pio_get_index(PIO pio) {
+  return pio == pio1;
+}
+
+static inline uint pio_get_dreq(PIO pio, uint sm, bool is_tx) {
+  return (pio == pio1 ? DREQ_PIO1_TX0 : DREQ_PIO0_TX0) + sm + (is_tx ? 0 : 4);
+}
+
+uint pio_add_program(PIO pio, const pio_program_t *program);
+int pio_claim_unused_sm(PIO pio, bool required);
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
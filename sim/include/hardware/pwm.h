@@ -0,0 +1,20 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+#define NUM_PWM_SLICES 8
+
+static inline uint pwm_gpio_to_slice_num(uint gpio) {
+  return (gpio >> 1u) & 7u;
+}
+
+static inline uint pwm_gpio_to_channel(uint gpio) {
+  return gpio & 1u;
+}
+
+void pwm_set_clkdiv(uint slice_num, float divider);
+void pwm_set_clkdiv_int_frac(uint slice_num, uint8_t integer, uint8_t fract);
+void pwm_set_wrap(uint slice_num, uint16_t wrap);
+void pwm_set_chan_level(uint slice_num, uint chan, uint16_t level);
+void pwm_set_gpio_level(uint gpio, uint16_t level);
+void pwm_set_enabled(uint slice_num, bool enabled);
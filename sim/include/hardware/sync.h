@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdint.h>
+
+// Os callbacks da simulação só rodam quando o relógio avança, então desligar as interrupções não
+// precisa fazer nada
+static inline uint32_t save_and_disable_interrupts(void) {
+  return 0;
+}
+
+static inline void restore_interrupts(uint32_t status) {
+  (void)status;
+}
+
+static inline void __dmb(void) {
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __mem_fence_acquire(void) {
+  __dmb();
+}
+
+static inline void __mem_fence_release(void) {
+  __dmb();
+}
+
+// __wfe avança o relógio virtual até o próximo alarme, a menos que um __sev esteja pendente
+void __sev(void);
+void __wfe(void);
+void __wfi(void);
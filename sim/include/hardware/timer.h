@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stdint.h>
+
+uint64_t time_us_64(void);
+
+static inline uint32_t time_us_32(void) {
+  return (uint32_t)time_us_64();
+}
+
+void busy_wait_us(uint64_t us);
+void busy_wait_ms(uint32_t ms);
@@ -0,0 +1,16 @@
+#pragma once
+
+// Substituto do hardware/uart.h: os bytes escritos direto na UART vão para o mesmo arquivo da USB
+// (-u), com a FIFO sempre com espaço
+#include "pico/stdlib.h"
+
+typedef struct uart_inst {
+  uint index;
+} uart_inst_t;
+
+extern uart_inst_t sim_uart0;
+#define uart0 (&sim_uart0)
+#define uart_default uart0
+
+bool uart_is_writable(uart_inst_t *uart);
+void uart_putc_raw(uart_inst_t *uart, char c);
@@ -0,0 +1,3 @@
+#pragma once
+
+// O rádio do Pico W não é usado pelo firmware nem simulado
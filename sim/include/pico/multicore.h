@@ -0,0 +1,8 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+// O núcleo 1 roda em uma thread da simulação, alternando com o núcleo 0 nas esperas do relógio virtual
+void multicore_launch_core1(void (*entry)(void));
+void multicore_fifo_push_blocking(uint32_t data);
+uint32_t multicore_fifo_pop_blocking(void);
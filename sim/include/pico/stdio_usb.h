@@ -0,0 +1,14 @@
+#pragma once
+
+// Substituto do pico/stdio_usb.h: o que o firmware escreve direto no driver da USB vai para o
+// arquivo passado em -u na simulação
+#include "pico/stdlib.h"
+
+typedef struct stdio_driver {
+  void (*out_chars)(const char *buf, int len);
+} stdio_driver_t;
+
+extern stdio_driver_t stdio_usb;
+
+// Verdadeiro com a saída da USB aberta (-u)
+bool stdio_usb_connected(void);
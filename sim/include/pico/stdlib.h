@@ -0,0 +1,28 @@
+#pragma once
+
+// Substituto do pico/stdlib.h para a simulação no computador: as mesmas assinaturas do SDK, com o
+// tempo vindo do relógio virtual de sim/hal/clock.c
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+typedef unsigned int uint;
+
+#define PICO_OK 0
+#define PICO_ERROR_TIMEOUT -1
+#define PICO_ERROR_GENERIC -2
+
+#include "hardware/gpio.h"
+#include "pico/time.h"
+
+bool stdio_init_all(void);
+
+// Caracteres chegam pelo comando console do cenário
+int getchar_timeout_us(uint32_t timeout_us);
+
+// No hardware é um nop; aqui cada volta de espera ativa consome tempo virtual
+void tight_loop_contents(void);
+
+// Núcleo da thread que chama (o núcleo 1 só existe depois do multicore_launch_core1)
+uint get_core_num(void);
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "pico/stdlib.h"
+#include "hardware/timer.h"
+
+typedef uint64_t absolute_time_t;
+
+absolute_time_t get_absolute_time(void);
+
+static inline uint32_t to_ms_since_boot(absolute_time_t t) {
+  return (uint32_t)(t / 1000);
+}
+
+static inline uint64_t to_us_since_boot(absolute_time_t t) {
+  return t;
+}
+
+static inline absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us) {
+  return t + us;
+}
+
+static inline absolute_time_t delayed_by_ms(absolute_time_t t, uint32_t ms) {
+  return t + ms * 1000ull;
+}
+
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) {
+  return delayed_by_ms(get_absolute_time(), ms);
+}
+
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+void sleep_until(absolute_time_t t);
+
+// Alarmes (disparam nos pontos em que o relógio virtual avança: esperas, __wfe, sleep)
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *user_data);
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past);
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past);
+bool cancel_alarm(alarm_id_t alarm_id);
+
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t *rt);
+
+struct repeating_timer {
+  int64_t delay_us;
+  alarm_id_t alarm_id;
+  repeating_timer_callback_t callback;
+  void *user_data;
+};
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out);
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out);
+bool cancel_repeating_timer(repeating_timer_t *timer);
@@ -0,0 +1,10 @@
+#pragma once
+
+// Substituto do tusb.h com só a escrita da CDC: uma FIFO de transmissão com a capacidade da do SDK,
+// esvaziada pelo computador a cada quadro da USB (sim/hal/usb.c). Os bytes vão para o arquivo
+// passado em -u
+#include "pico/stdlib.h"
+
+uint32_t tud_cdc_write_available(void);
+uint32_t tud_cdc_write(const void *buffer, uint32_t bufsize);
+uint32_t tud_cdc_write_flush(void);
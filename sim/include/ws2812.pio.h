@@ -0,0 +1,9 @@
+#pragma once
+
+// Substituto do header gerado pelo pioasm a partir de ws2812.pio: o programa não é executado, as
+// palavras que chegam à FIFO são decodificadas pelo modelo da matriz em sim/hal/pio.c
+#include "hardware/pio.h"
+
+static const pio_program_t ws2812_program = { NULL, 0, -1 };
+
+void ws2812_program_init(PIO pio, uint sm, uint offset, uint pin, float freq);
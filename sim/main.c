@@ -0,0 +1,216 @@
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "hal/sim.h"
+
+// Executa o firmware (Projeto_Controle_Ambiente.c compilado com main renomeado) sobre os modelos de
+// sim/hal, em tempo virtual, aplicando um cenário de entradas:
+//
+//   <tempo_ms> adc <entrada> <valor>     nível do ADC (0: eixo Y, 1: eixo X, 4: temperatura interna)
+//   <tempo_ms> noise <entrada> <amp>     ruído uniforme de ±amp somado às conversões da entrada
+//   <tempo_ms> press <gpio>              segura um botão (nível baixo)
+//   <tempo_ms> release <gpio>            solta um botão (volta ao pull-up)
+//   <tempo_ms> click <gpio> [ms]         aperta e solta depois de ms (padrão 100)
+//   <tempo_ms> screen | leds | report    mostra o display, a matriz ou o relatório naquele instante
+//   <tempo_ms> console <texto>           caracteres recebidos pela USB/UART (ex.: p com PROFILE=1)
+//
+// Linhas vazias e o que vem depois de # são ignorados.
+
+#define SIM_DEFAULT_MS 10000
+#define SIM_MAX_EVENTS 1024
+
+int firmware_main(void);
+
+typedef enum { CMD_ADC, CMD_NOISE, CMD_PRESS, CMD_RELEASE, CMD_SCREEN, CMD_LEDS, CMD_REPORT, CMD_CONSOLE } command_t;
+
+typedef struct {
+  command_t command;
+  uint a, b;
+} event_t;
+
+static event_t events[SIM_MAX_EVENTS];
+static uint event_count;
+static uint64_t scheduled_until_ns; // Os eventos entram na fila de alarmes aos poucos (ela é pequena)
+static uint64_t event_ns[SIM_MAX_EVENTS];
+static uint next_event;
+static bool quiet;
+static struct timespec wall_start;
+
+static void report(FILE *out) {
+  struct timespec wall_now;
+  clock_gettime(CLOCK_MONOTONIC, &wall_now);
+  double wall = (wall_now.tv_sec - wall_start.tv_sec) + (wall_now.tv_nsec - wall_start.tv_nsec) / 1e9;
+  double seconds = sim_now_ns() / 1e9;
+
+  fprintf(out, "tempo simulado: %.3f s (tempo real %.3f s, %.0fx)\n", seconds, wall, wall > 0 ? seconds / wall : 0);
+  sim_i2c_report(out, seconds > 0 ? seconds : 1);
+  sim_pio_report(out);
+  sim_pwm_report(out);
+  sim_dma_report(out);
+  sim_usb_report(out);
+  fprintf(out, "interrupções de gpio: %u\n", sim_gpio_irqs());
+}
+
+static void run_event(void *arg) {
+  event_t *e = arg;
+
+  switch (e->command) {
+    case CMD_ADC:
+      sim_adc_set(e->a, e->b);
+      break;
+    case CMD_NOISE:
+      sim_adc_noise(e->a, e->b);
+      break;
+    case CMD_PRESS:
+      sim_gpio_drive(e->a, 0);
+      break;
+    case CMD_RELEASE:
+      sim_gpio_drive(e->a, -1);
+      break;
+    case CMD_SCREEN:
+      printf("[%.3f s] display\n", sim_now_ns() / 1e9);
+      sim_display_dump(stdout);
+      break;
+    case CMD_LEDS:
+      printf("[%.3f s] matriz\n", sim_now_ns() / 1e9);
+      sim_leds_dump(stdout);
+      break;
+    case CMD_REPORT:
+      printf("[%.3f s] relatório\n", sim_now_ns() / 1e9);
+      report(stdout);
+      break;
+    case CMD_CONSOLE:
+      sim_console_push((char)e->a);
+      break;
+  }
+}
+
+// Agenda os próximos eventos do cenário; um evento de recarga fica sempre atrás do último agendado
+static void schedule_events(void *arg) {
+  (void)arg;
+  uint batch = 0;
+
+  while (next_event < event_count && batch < 16) {
+    if (!sim_at(event_ns[next_event], run_event, &events[next_event]))
+      break;
+    scheduled_until_ns = event_ns[next_event];
+    ++next_event;
+    ++batch;
+  }
+  if (next_event < event_count)
+    sim_at(scheduled_until_ns, schedule_events, NULL);
+}
+
+static void add_event(uint64_t t_ms, command_t command, uint a, uint b) {
+  if (event_count == SIM_MAX_EVENTS) {
+    fprintf(stderr, "sim: cenário com mais de %d eventos\n", SIM_MAX_EVENTS);
+    exit(1);
+  }
+  // Mantém a lista ordenada pelo tempo (estável para eventos no mesmo instante)
+  uint i = event_count++;
+  while (i > 0 && event_ns[i - 1] > t_ms * 1000000) {
+    events[i] = events[i - 1];
+    event_ns[i] = event_ns[i - 1];
+    --i;
+  }
+  events[i] = (event_t){command, a, b};
+  event_ns[i] = t_ms * 1000000;
+}
+
+static void load_scenario(const char *path) {
+  FILE *f = fopen(path, "r");
+  char line[256];
+  uint number = 0;
+
+  if (!f) {
+    perror(path);
+    exit(1);
+  }
+  while (fgets(line, sizeof(line), f)) {
+    char name[16], text[32];
+    unsigned long long t;
+    uint a = 0, b = 100;
+    int n;
+
+    ++number;
+    char *comment = strchr(line, '#');
+    if (comment)
+      *comment = 0;
+    n = sscanf(line, "%llu %15s %u %u", &t, name, &a, &b);
+    if (n <= 0)
+      continue;
+    if (n < 2)
+      goto invalid;
+    if (!strcmp(name, "adc") && n == 4)
+      add_event(t, CMD_ADC, a, b);
+    else if (!strcmp(name, "noise") && n == 4)
+      add_event(t, CMD_NOISE, a, b);
+    else if (!strcmp(name, "press") && n == 3)
+      add_event(t, CMD_PRESS, a, 0);
+    else if (!strcmp(name, "release") && n == 3)
+      add_event(t, CMD_RELEASE, a, 0);
+    else if (!strcmp(name, "click") && n >= 3) {
+      add_event(t, CMD_PRESS, a, 0);
+      add_event(t + b, CMD_RELEASE, a, 0);
+    } else if (!strcmp(name, "screen"))
+      add_event(t, CMD_SCREEN, 0, 0);
+    else if (!strcmp(name, "leds"))
+      add_event(t, CMD_LEDS, 0, 0);
+    else if (!strcmp(name, "report"))
+      add_event(t, CMD_REPORT, 0, 0);
+    else if (!strcmp(name, "console") && sscanf(line, "%*u %*s %31s", text) == 1) {
+      for (char *c = text; *c; ++c)
+        add_event(t, CMD_CONSOLE, (unsigned char)*c, 0);
+    }
+    else
+      goto invalid;
+    continue;
+invalid:
+    fprintf(stderr, "%s:%u: linha inválida\n", path, number);
+    exit(1);
+  }
+  fclose(f);
+}
+
+static void finish(void) {
+  printf("[%.3f s] fim\n", sim_now_ns() / 1e9);
+  report(stdout);
+  if (!quiet)
+    sim_display_dump(stdout);
+  fflush(stdout);
+}
+
+static void usage(const char *name) {
+  fprintf(stderr, "uso: %s [-t ms] [-s cenário] [-u arquivo] [-q]\n"
+                  "  -t ms       tempo simulado (padrão %d ms)\n"
+                  "  -s cenário  arquivo com os eventos de entrada\n"
+                  "  -u arquivo  grava o que o firmware envia pela USB/UART (registro de eventos, telemetria)\n"
+                  "  -q          não mostra o display no fim\n", name, SIM_DEFAULT_MS);
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  uint64_t duration_ms = SIM_DEFAULT_MS;
+
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "-t") && i + 1 < argc)
+      duration_ms = strtoull(argv[++i], NULL, 10);
+    else if (!strcmp(argv[i], "-s") && i + 1 < argc)
+      load_scenario(argv[++i]);
+    else if (!strcmp(argv[i], "-u") && i + 1 < argc) {
+      if (!sim_usb_open(argv[++i])) {
+        perror(argv[i]);
+        exit(1);
+      }
+    } else if (!strcmp(argv[i], "-q"))
+      quiet = true;
+    else
+      usage(argv[0]);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &wall_start);
+  schedule_events(NULL);
+  sim_set_end(duration_ms * 1000000, finish);
+  firmware_main(); // Não retorna: o relógio encerra o programa em sim_set_end
+  return 0;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// Verificações dos testes no computador: a primeira que falha mostra o local e os valores e encerra
+// o teste com erro (o ctest mostra a saída com --output-on-failure)
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+      fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond); \
+      exit(1); \
+    } \
+  } while (0)
+
+#define CHECK_EQ(a, b) do { \
+    long long check_a = (long long)(a), check_b = (long long)(b); \
+    if (check_a != check_b) { \
+      fprintf(stderr, "%s:%d: falhou: %s == %s (%lld != %lld)\n", __FILE__, __LINE__, #a, #b, check_a, check_b); \
+      exit(1); \
+    } \
+  } while (0)
+
+// Intervalo fechado [lo, hi]
+#define CHECK_RANGE(v, lo, hi) do { \
+    long long check_v = (long long)(v); \
+    if (check_v < (long long)(lo) || check_v > (long long)(hi)) { \
+      fprintf(stderr, "%s:%d: falhou: %s = %lld fora de [%lld, %lld]\n", __FILE__, __LINE__, #v, check_v, \
+              (long long)(lo), (long long)(hi)); \
+      exit(1); \
+    } \
+  } while (0)
@@ -0,0 +1,32 @@
+# Roda o firmware com um e com dois núcleos sobre o mesmo cenário e compara o que os periféricos
+# mostraram (display, matriz e relatório dos periféricos): com o mesmo período de renderização a
+# saída é a mesma. O tempo real e o perfil dos estágios (medidos no relógio do computador) ficam de fora.
+#
+#   cmake -DSINGLE=<exe> -DDUAL=<exe> -DSCENARIO=<arquivo> -DTIME_MS=<ms> -P compare_output.cmake
+
+function(run_firmware exe out)
+  execute_process(COMMAND ${exe} -t ${TIME_MS} -s ${SCENARIO}
+                  OUTPUT_VARIABLE output RESULT_VARIABLE result)
+  if (NOT result EQUAL 0)
+    message(FATAL_ERROR "${exe} terminou com ${result}")
+  endif()
+  string(REPLACE ";" "," output "${output}")
+  string(REPLACE "\n" ";" output "${output}")
+  set(lines "")
+  foreach(line IN LISTS output)
+    if (line MATCHES "^(\\[|\\||\\+|i2c|ssd1306|ws2812|pwm|dma|interrupções)")
+      string(APPEND lines "${line}\n")
+    endif()
+  endforeach()
+  set(${out} "${lines}" PARENT_SCOPE)
+endfunction()
+
+run_firmware(${SINGLE} single)
+run_firmware(${DUAL} dual)
+if (NOT single STREQUAL dual)
+  file(WRITE single.txt "${single}")
+  file(WRITE dual_core.txt "${dual}")
+  message(FATAL_ERROR "saídas diferentes: compare single.txt e dual_core.txt")
+endif()
+string(LENGTH "${single}" length)
+message("mesma saída com um e dois núcleos (${length} caracteres)")
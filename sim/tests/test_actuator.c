@@ -0,0 +1,201 @@
+#include "hal/sim.h"
+#include "inc/actuator.h"
+#include "tests/check.h"
+
+// Ventilador e umidificador com as configurações do firmware sobre séries de temperatura e umidade
+// com ruído, a cada 10 ms como o controle: trocas de nível e escritas no PWM contra a comparação
+// direta com os limites que o firmware fazia antes, tempo mínimo em cada nível e a rampa da saída
+
+#define TICK_MS 10
+#define RED_LED 13
+#define BLUE_LED 12
+#define LED_RAMP_PER_MS 8
+#define FAN_HYSTERESIS 1
+#define FAN_MIN_DWELL_MS 2000
+#define HUMIDIFIER_HYSTERESIS 2
+#define HUMIDIFIER_MIN_DWELL_MS 5000
+
+static const actuator_config_t fan_config = {
+  RED_LED, 3, false, FAN_HYSTERESIS, FAN_MIN_DWELL_MS, FAN_MIN_DWELL_MS, LED_RAMP_PER_MS,
+  {0, 1365, 2730, 4095},
+};
+static const actuator_config_t humidifier_config = {
+  BLUE_LED, 1, true, HUMIDIFIER_HYSTERESIS, HUMIDIFIER_MIN_DWELL_MS, HUMIDIFIER_MIN_DWELL_MS, LED_RAMP_PER_MS,
+  {0, 1365},
+};
+static const int16_t fan_limits[] = {26, 30, 34};
+static const int16_t humidifier_limits[] = {60};
+
+static uint32_t seed = 11;
+
+// Ruído uniforme em [-amplitude, amplitude]
+static int16_t noise(int16_t amplitude) {
+  seed = seed * 1103515245u + 12345u;
+  return (int16_t)((seed >> 16) % (2 * amplitude + 1)) - amplitude;
+}
+
+// Nível pela comparação direta, como o firmware fazia antes do atuador
+static uint8_t old_level(const actuator_config_t *cfg, int16_t value, const int16_t *limits) {
+  uint8_t level = 0;
+  while (level < cfg->levels && (cfg->falling ? value <= limits[level] : value >= limits[level]))
+    ++level;
+  return level;
+}
+
+// Série: valor em cada tick (rampa linear de from a to, depois parado em to) mais o ruído
+typedef struct {
+  int16_t from, to;
+  uint32_t ramp_ms, total_ms;
+  int16_t noise;
+} trace_t;
+
+typedef struct {
+  uint32_t switches, writes;       // Atuador
+  uint32_t old_switches, old_writes; // Comparação direta (escrevia o PWM a cada tick)
+  uint8_t final_level;
+} result_t;
+
+static result_t run(const actuator_config_t *cfg, const int16_t *limits, const trace_t *trace) {
+  actuator_t a;
+  result_t r = {0};
+  uint32_t now_ms = 1000, start_ms = now_ms;
+  uint32_t last_change_ms = now_ms;
+  uint8_t level = 0, old = 0;
+  uint16_t pwm = cfg->pwm[0];
+
+  actuator_init(&a, cfg, now_ms);
+  for (uint32_t t = 0; t <= trace->total_ms; t += TICK_MS) {
+    now_ms = start_ms + t;
+    int32_t base = t >= trace->ramp_ms ? trace->to
+                 : trace->from + (int32_t)(trace->to - trace->from) * (int32_t)t / (int32_t)trace->ramp_ms;
+    int16_t value = (int16_t)base + noise(trace->noise);
+
+    uint8_t next = actuator_update(&a, value, limits, now_ms);
+    actuator_output(&a, now_ms);
+
+    // Mudança só depois do tempo mínimo no nível anterior
+    if (next != level) {
+      CHECK(now_ms - last_change_ms >= (level ? cfg->min_on_ms : cfg->min_off_ms));
+      last_change_ms = now_ms;
+      level = next;
+    }
+
+    // Rampa: no máximo ramp_per_ms por ms em direção ao alvo, e o PWM simulado igual ao do atuador
+    uint16_t step = (uint16_t)(TICK_MS * cfg->ramp_per_ms);
+    CHECK(a.pwm <= pwm + step && a.pwm + step >= pwm);
+    CHECK_EQ(sim_pwm_level(cfg->gpio), a.pwm);
+    pwm = a.pwm;
+
+    uint8_t o = old_level(cfg, value, limits);
+    if (o != old)
+      ++r.old_switches;
+    old = o;
+    ++r.old_writes;
+  }
+  // Parado no fim: a saída chega ao PWM do nível
+  CHECK_EQ(a.pwm, cfg->pwm[a.level]);
+  r.switches = a.switches;
+  r.writes = a.writes;
+  r.final_level = a.level;
+  return r;
+}
+
+static void report(const char *name, const result_t *r) {
+  printf("%-28s trocas %4u (antes %4u), escritas no PWM %5u (antes %5u)\n", name, r->switches, r->old_switches,
+         r->writes, r->old_writes);
+}
+
+static void test_fan_on_threshold(void) {
+  // 1 minuto parado no limite da velocidade baixa com ±1 °C: sobe uma vez e não desce (a
+  // histerese cobre o ruído)
+  static const trace_t trace = {26, 26, 0, 60000, 1};
+  result_t r = run(&fan_config, fan_limits, &trace);
+
+  report("ventilador no limite", &r);
+  CHECK_EQ(r.switches, 1);
+  CHECK_EQ(r.final_level, 1);
+  CHECK(r.old_switches > 1000);
+  CHECK(r.writes < 100);
+}
+
+static void test_fan_sweep(void) {
+  // 20 -> 40 °C em 2 min e de volta, com ±1 °C (6 s em cada grau). Nos 6 s em que a temperatura
+  // fica um grau abaixo de um limite o ruído atravessa a banda de histerese e só o tempo mínimo
+  // segura as trocas: além de uma por limite, no máximo uma a cada 2 s nesses trechos
+  static const trace_t up = {20, 40, 120000, 150000, 1};
+  static const trace_t down = {40, 20, 120000, 150000, 1};
+  const uint32_t flapping = 3 * 6000 / FAN_MIN_DWELL_MS;
+  result_t r = run(&fan_config, fan_limits, &up);
+
+  report("ventilador subindo", &r);
+  CHECK_RANGE(r.switches, 3, 3 + flapping);
+  CHECK_EQ(r.final_level, 3);
+  CHECK(r.old_switches > 50 * r.switches);
+
+  // A descida começa desligada: vai direto ao máximo depois do tempo mínimo desligado
+  r = run(&fan_config, fan_limits, &down);
+  report("ventilador descendo", &r);
+  CHECK_RANGE(r.switches, 4, 4 + flapping);
+  CHECK_EQ(r.final_level, 0);
+  CHECK(r.old_switches > 50 * r.switches);
+}
+
+static void test_fan_noisy(void) {
+  // Ruído de ±3 °C, maior que a histerese: o tempo mínimo limita as trocas a uma a cada 2 s
+  static const trace_t trace = {30, 30, 0, 60000, 3};
+  result_t r = run(&fan_config, fan_limits, &trace);
+
+  report("ventilador com ruído", &r);
+  CHECK(r.switches <= 60000 / FAN_MIN_DWELL_MS);
+  CHECK(r.old_switches > 20 * r.switches);
+}
+
+static void test_humidifier(void) {
+  // Umidade parada no limite com ±2 %: liga uma vez e fica ligado
+  static const trace_t still = {60, 60, 0, 60000, 2};
+  // Secando de 70 a 50 % com ±2 % (3 s em cada %): liga uma vez, mais no máximo duas trocas nos 6 s
+  // em que o ruído atravessa a banda de histerese (61 e 62 %), com o tempo mínimo de 5 s
+  static const trace_t drying = {70, 50, 60000, 90000, 2};
+  // Ruído de ±5 %: no máximo uma troca a cada 5 s
+  static const trace_t noisy = {61, 61, 0, 60000, 5};
+  result_t r = run(&humidifier_config, humidifier_limits, &still);
+
+  report("umidificador no limite", &r);
+  CHECK_EQ(r.switches, 1);
+  CHECK_EQ(r.final_level, 1);
+  CHECK(r.old_switches > 1000);
+
+  r = run(&humidifier_config, humidifier_limits, &drying);
+  report("umidificador secando", &r);
+  CHECK_RANGE(r.switches, 1, 3);
+  CHECK_EQ(r.final_level, 1);
+
+  r = run(&humidifier_config, humidifier_limits, &noisy);
+  report("umidificador com ruído", &r);
+  CHECK(r.switches <= 60000 / HUMIDIFIER_MIN_DWELL_MS);
+  CHECK(r.old_switches > 50 * r.switches);
+}
+
+static void test_force(void) {
+  actuator_t a;
+
+  // A pré-visualização não conta como troca nem reinicia o tempo mínimo: a primeira avaliação
+  // depois dela volta ao nível medido
+  actuator_init(&a, &fan_config, 0);
+  CHECK_EQ(actuator_update(&a, 31, fan_limits, 3000), 2);
+  actuator_force(&a, 3);
+  CHECK_EQ(a.level, 3);
+  actuator_force(&a, 9);
+  CHECK_EQ(a.level, 3);
+  CHECK_EQ(a.switches, 1);
+  CHECK_EQ(actuator_update(&a, 31, fan_limits, 5000), 2);
+}
+
+int main(void) {
+  test_fan_on_threshold();
+  test_fan_sweep();
+  test_fan_noisy();
+  test_humidifier();
+  test_force();
+  return 0;
+}
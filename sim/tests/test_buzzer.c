@@ -0,0 +1,179 @@
+#include "hal/sim.h"
+#include "inc/buzzer.h"
+#include "tests/check.h"
+
+// Sequenciador dos buzzers sobre o PWM simulado e o relógio virtual: o buzzer_play volta na hora,
+// cada passo liga o buzzer certo com a nota e o ciclo pedidos no instante exato, e o anterior
+// desliga na troca
+
+enum { BUZ_A, BUZ_B };
+static const uint pins[] = { [BUZ_A] = 21, [BUZ_B] = 10 };
+
+// Trecho da linha do tempo com a saída constante (buzzer -1: silêncio)
+typedef struct {
+  uint32_t t_us;
+  int8_t buzzer;
+  uint8_t note;
+  uint8_t duty;
+} segment_t;
+
+static const uint32_t note_chz[NOTE_COUNT] = {
+  [NOTE_C4] = 26163, [NOTE_D4] = 29366, [NOTE_E4] = 32963, [NOTE_F4] = 34923, [NOTE_G4] = 39200,
+  [NOTE_A4] = 44000, [NOTE_B4] = 49388, [NOTE_C5] = 52325, [NOTE_D5] = 58733, [NOTE_E5] = 65926,
+  [NOTE_F5] = 69846, [NOTE_G5] = 78399, [NOTE_A5] = 88000, [NOTE_B5] = 98777,
+};
+
+static segment_t timeline[64];
+static uint segments;
+
+// Saída atual: no máximo um buzzer ligado, e a nota dele identificada pela frequência
+static segment_t output(uint32_t t_us) {
+  segment_t s = {t_us, -1, NOTE_REST, 0};
+
+  for (uint b = 0; b < 2; ++b) {
+    if (!sim_pwm_level(pins[b]))
+      continue;
+    CHECK_EQ(s.buzzer, -1);
+    s.buzzer = b;
+    s.duty = (sim_pwm_level(pins[b]) * 256u + sim_pwm_top(pins[b]) / 2) / sim_pwm_top(pins[b]);
+    for (uint n = NOTE_C4; n < NOTE_COUNT; ++n) {
+      if (sim_pwm_hz(pins[b]) * 100 > note_chz[n] * 0.999 && sim_pwm_hz(pins[b]) * 100 < note_chz[n] * 1.001)
+        s.note = n;
+    }
+    CHECK(s.note != NOTE_REST);
+  }
+  return s;
+}
+
+// Grava as trocas da saída a cada us até end_us depois de start
+static void record(uint64_t start, uint32_t end_us) {
+  segments = 0;
+  for (;;) {
+    uint32_t t_us = (uint32_t)(time_us_64() - start);
+    segment_t s = output(t_us);
+    if (!segments || s.buzzer != timeline[segments - 1].buzzer || s.note != timeline[segments - 1].note ||
+        s.duty != timeline[segments - 1].duty) {
+      CHECK(segments < sizeof(timeline) / sizeof(timeline[0]));
+      timeline[segments++] = s;
+    }
+    if (t_us >= end_us)
+      break;
+    sleep_us(1);
+  }
+}
+
+static void check_timeline(const segment_t *expected, uint count) {
+  CHECK_EQ(segments, count);
+  for (uint i = 0; i < count; ++i) {
+    CHECK_EQ(timeline[i].t_us, expected[i].t_us);
+    CHECK_EQ(timeline[i].buzzer, expected[i].buzzer);
+    CHECK_EQ(timeline[i].note, expected[i].note);
+    CHECK_EQ(timeline[i].duty, expected[i].duty);
+  }
+}
+
+static uint64_t play(const buzzer_step_t *steps, uint8_t count) {
+  uint64_t start = time_us_64();
+
+  // Enfileirar não espera o som: o relógio não anda dentro do buzzer_play
+  CHECK(buzzer_play(steps, count));
+  CHECK_EQ(time_us_64(), start);
+  return start;
+}
+
+static void test_timeline(void) {
+  static const buzzer_step_t steps[] = {
+    {BUZ_A, NOTE_C4, 128, 120}, {BUZ_B, NOTE_B4, 128, 120}, {BUZ_A, NOTE_REST, 128, 50},
+    {BUZ_B, NOTE_A5, 64, 30}, {BUZ_B, NOTE_E4, 200, 10},
+  };
+  static const segment_t expected[] = {
+    {0, BUZ_A, NOTE_C4, 128}, {120000, BUZ_B, NOTE_B4, 128}, {240000, -1, NOTE_REST, 0},
+    {290000, BUZ_B, NOTE_A5, 64}, {320000, BUZ_B, NOTE_E4, 200}, {330000, -1, NOTE_REST, 0},
+  };
+
+  uint64_t start = play(steps, sizeof(steps) / sizeof(steps[0]));
+  CHECK(buzzer_playing());
+  record(start, 400000);
+  check_timeline(expected, sizeof(expected) / sizeof(expected[0]));
+  CHECK(!buzzer_playing());
+}
+
+static const buzzer_step_t second[] = {{BUZ_A, NOTE_G5, 128, 40}};
+
+static void play_second(void *arg) {
+  (void)arg;
+  CHECK(buzzer_play(second, 1));
+}
+
+static void test_append(void) {
+  static const buzzer_step_t first[] = {{BUZ_A, NOTE_C4, 128, 100}, {BUZ_B, NOTE_B4, 128, 100}};
+  static const segment_t expected[] = {
+    {0, BUZ_A, NOTE_C4, 128}, {100000, BUZ_B, NOTE_B4, 128}, {200000, BUZ_A, NOTE_G5, 128},
+    {240000, -1, NOTE_REST, 0},
+  };
+
+  // Outra sequência no meio da primeira entra no fim da fila, sem intervalo entre as duas
+  uint64_t start = play(first, 2);
+  CHECK(sim_at(sim_now_ns() + 150000000, play_second, NULL));
+  record(start, 300000);
+  check_timeline(expected, sizeof(expected) / sizeof(expected[0]));
+}
+
+static void test_zero_duration(void) {
+  static const buzzer_step_t steps[] = {{BUZ_A, NOTE_C4, 128, 0}, {BUZ_B, NOTE_D5, 128, 20}};
+  static const segment_t expected[] = {{0, BUZ_A, NOTE_C4, 128}, {1, BUZ_B, NOTE_D5, 128}, {20001, -1, NOTE_REST, 0}};
+
+  // Duração 0 ainda passa pelo alarme: 1 us
+  uint64_t start = play(steps, 2);
+  record(start, 30000);
+  check_timeline(expected, sizeof(expected) / sizeof(expected[0]));
+}
+
+static void test_notes(void) {
+  static buzzer_step_t steps[NOTE_COUNT - 1];
+  static segment_t expected[NOTE_COUNT];
+
+  // Todas as notas da tabela a 0,1% da frequência pedida (a conferência fica no output)
+  for (uint n = NOTE_C4; n < NOTE_COUNT; ++n) {
+    steps[n - 1] = (buzzer_step_t){n % 2, n, 128, 5};
+    expected[n - 1] = (segment_t){(n - 1) * 5000, n % 2, n, 128};
+  }
+  expected[NOTE_COUNT - 1] = (segment_t){(NOTE_COUNT - 1) * 5000, -1, NOTE_REST, 0};
+  uint64_t start = play(steps, NOTE_COUNT - 1);
+  record(start, NOTE_COUNT * 5000);
+  check_timeline(expected, NOTE_COUNT);
+}
+
+static void test_queue_full(void) {
+  static buzzer_step_t steps[BUZZER_QUEUE];
+
+  for (uint i = 0; i < BUZZER_QUEUE; ++i)
+    steps[i] = (buzzer_step_t){BUZ_A, NOTE_C4, 128, 10};
+
+  // O primeiro passo sai da fila na hora: cabem mais um, depois nada, e nada é enfileirado pela metade
+  uint64_t start = play(steps, BUZZER_QUEUE);
+  CHECK(buzzer_play(steps, 1));
+  CHECK(!buzzer_play(steps, 1));
+  CHECK(!buzzer_play(steps, 2));
+  sleep_ms(15);
+  CHECK(!buzzer_play(steps, 2));
+  CHECK(buzzer_play(steps, 1));
+  while (buzzer_playing())
+    sleep_ms(1);
+  CHECK_EQ(time_us_64() - start, (BUZZER_QUEUE + 2) * 10000);
+  CHECK_EQ(sim_pwm_level(pins[BUZ_A]), 0);
+}
+
+int main(void) {
+  buzzer_init(pins, 2);
+  CHECK(!buzzer_playing());
+  CHECK_EQ(sim_pwm_level(pins[BUZ_A]), 0);
+  CHECK_EQ(sim_pwm_level(pins[BUZ_B]), 0);
+
+  test_timeline();
+  test_append();
+  test_zero_duration();
+  test_notes();
+  test_queue_full();
+  return 0;
+}
@@ -0,0 +1,128 @@
+#include "inc/calib.h"
+#include "tests/check.h"
+
+// Curva de calibração: todos os 4096 códigos do ADC comparados com a conta exata em frações (sem o
+// arredondamento das inclinações), para a calibração padrão do firmware e para calibrações
+// aleatórias, invertidas, com o centro fora dos extremos e com a faixa inteira do int16
+
+#define CODES 4096
+
+static uint32_t seed = 13;
+
+static uint32_t next_random(void) {
+  seed = seed * 1103515245u + 12345u;
+  return seed >> 8;
+}
+
+// Divisão arredondando para baixo também com numerador negativo
+static int64_t floor_div(int64_t num, int64_t den) {
+  return num / den - (num % den != 0 && (num < 0) != (den < 0));
+}
+
+// Valor exato arredondado para o inteiro mais próximo (empate para cima), a partir dos pontos e das
+// saídas que calib_set calculou
+static int reference(const calib_t *c, uint16_t code) {
+  if (code <= c->point[0])
+    return c->base[0] >> CALIB_FRAC_BITS;
+  if (code >= c->point[3])
+    return c->base[3] >> CALIB_FRAC_BITS;
+  uint i = code < c->point[1] ? 0 : code < c->point[2] ? 1 : 2;
+  int64_t width = c->point[i + 1] - c->point[i];
+  int64_t num = (int64_t)c->base[i] * width + (int64_t)(code - c->point[i]) * ((int64_t)c->base[i + 1] - c->base[i]);
+  return (int)floor_div(num + (width << (CALIB_FRAC_BITS - 1)), width << CALIB_FRAC_BITS);
+}
+
+static void check_all_codes(uint16_t low, uint16_t middle_low, uint16_t middle_high, uint16_t high,
+                            int16_t out_min, int16_t out_max) {
+  calib_t c;
+  int lo = out_min < out_max ? out_min : out_max, hi = out_min < out_max ? out_max : out_min;
+
+  calib_set(&c, low, middle_low, middle_high, high, out_min, out_max);
+  CHECK(c.point[0] <= c.point[1] && c.point[1] <= c.point[2] && c.point[2] <= c.point[3]);
+  CHECK_EQ(c.base[1], ((out_min + out_max) / 2) << CALIB_FRAC_BITS);
+  CHECK_EQ(c.base[1], c.base[2]);
+
+  int previous = calib_apply(&c, 0);
+  for (uint code = 0; code < CODES; ++code) {
+    int value = calib_apply(&c, code);
+    if (value != reference(&c, code)) {
+      fprintf(stderr, "curva %u %u %u %u (%d..%d), código %u: %d != %d\n", low, middle_low, middle_high, high,
+              out_min, out_max, code, value, reference(&c, code));
+      exit(1);
+    }
+    CHECK_RANGE(value, lo, hi);
+    // Monotônica no sentido do eixo
+    CHECK(c.base[0] <= c.base[3] ? value >= previous : value <= previous);
+    previous = value;
+  }
+}
+
+static void test_default(void) {
+  calib_t c;
+
+  // Calibração de fábrica do firmware: centro sem largura em 2047
+  check_all_codes(0, 2047, 2047, 4095, -15, 50);
+  check_all_codes(0, 2047, 2047, 4095, 0, 100);
+
+  // Joystick parado no meio com ruído de ±30 códigos: sempre o mesmo valor (17, não 17 e 18)
+  calib_set(&c, 0, 2047, 2047, 4095, -15, 50);
+  for (uint code = 2047 - 30; code <= 2047 + 30; ++code)
+    CHECK_EQ(calib_apply(&c, code), 17);
+  CHECK_EQ(calib_apply(&c, 0), -15);
+  CHECK_EQ(calib_apply(&c, 4095), 50);
+
+  // Com zona morta o centro inteiro vale em toda ela
+  calib_set(&c, 100, 1900, 2200, 4000, -15, 50);
+  for (uint code = 1900; code <= 2200; ++code)
+    CHECK_EQ(calib_apply_q16(&c, code), 17 << CALIB_FRAC_BITS);
+}
+
+static void test_random(void) {
+  static const int16_t ranges[][2] = {{-15, 50}, {0, 100}, {50, -15}, {-100, 100}, {-7, 8}, {0, 1}, {-1000, 3000}};
+
+  for (uint n = 0; n < 2000; ++n) {
+    uint16_t points[4];
+    for (uint i = 0; i < 4; ++i)
+      points[i] = next_random() % CODES;
+    const int16_t *range = ranges[n % (sizeof(ranges) / sizeof(ranges[0]))];
+    // Pontos em qualquer ordem: o calib_set inverte o eixo e ajusta o centro
+    check_all_codes(points[0], points[1], points[2], points[3], range[0], range[1]);
+  }
+
+  // Extremos que se encontram, trechos sem largura
+  check_all_codes(0, 0, 0, 4095, -15, 50);
+  check_all_codes(0, 4095, 4095, 4095, -15, 50);
+  check_all_codes(2000, 2000, 2000, 2000, -15, 50);
+  check_all_codes(4095, 2047, 2047, 0, -15, 50);
+}
+
+static void test_extremes(void) {
+  // Faixa inteira do int16: a subida de um extremo ao outro passa de 2^31 em Q16 e as inclinações só
+  // cabem calculadas em 64 bits, também com trechos de um código só e o eixo invertido
+  check_all_codes(0, 2047, 2048, 4095, INT16_MIN, INT16_MAX);
+  check_all_codes(0, 2047, 2047, 4095, INT16_MIN, INT16_MAX);
+  check_all_codes(0, 1, 4094, 4095, INT16_MIN, INT16_MAX);
+  check_all_codes(0, 1, 1, 2, INT16_MIN, INT16_MAX);
+  check_all_codes(0, 0, 0, 4095, INT16_MIN, INT16_MAX);
+  check_all_codes(0, 4095, 4095, 4095, INT16_MIN, INT16_MAX);
+  check_all_codes(4095, 2048, 2047, 0, INT16_MIN, INT16_MAX);
+  check_all_codes(4095, 4094, 1, 0, INT16_MAX, INT16_MIN);
+  check_all_codes(0, 2047, 2048, 4095, INT16_MAX, INT16_MIN);
+  check_all_codes(0, 2047, 2048, 4095, INT16_MIN, INT16_MIN + 1);
+  check_all_codes(0, 2047, 2048, 4095, INT16_MAX - 1, INT16_MAX);
+
+  for (uint n = 0; n < 500; ++n) {
+    uint16_t points[4];
+    for (uint i = 0; i < 4; ++i)
+      points[i] = next_random() % CODES;
+    check_all_codes(points[0], points[1], points[2], points[3], n % 2 ? INT16_MIN : INT16_MAX,
+                    n % 2 ? INT16_MAX : INT16_MIN);
+  }
+}
+
+int main(void) {
+  test_default();
+  test_random();
+  test_extremes();
+  return 0;
+}
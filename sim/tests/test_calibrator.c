@@ -0,0 +1,259 @@
+#include "inc/calibrator.h"
+#include "tests/check.h"
+
+// Calibração do joystick como máquina de estados, sobre um relógio de ms falso: instantes dos
+// avisos e das amostras, extremos, média e desvio padrão de cada passo contra a conta exata, passo
+// repetido com leituras instáveis, aborto, ticks atrasados e a volta do contador de ms
+
+#define SETTLE_MS 2000
+#define SAMPLES 300
+#define INTERVAL_MS 10
+#define MAX_STDDEV 20
+#define STEP_MS (SETTLE_MS + (SAMPLES - 1) * INTERVAL_MS) // Do aviso de um passo ao aviso do próximo
+
+static uint16_t results[4];
+static const calibrator_step_t steps[] = {
+  {10, 0, CALIBRATOR_KEEP_MIN, &results[0]},
+  {11, 0, CALIBRATOR_KEEP_MAX, &results[1]},
+  {12, 1, CALIBRATOR_KEEP_MAX, &results[2]},
+  {13, 1, CALIBRATOR_KEEP_MIN, &results[3]},
+};
+#define STEP_COUNT (sizeof(steps) / sizeof(steps[0]))
+
+static calibrator_t cal;
+static uint32_t now_ms;
+static uint32_t seed = 5;
+
+// Leituras de cada passo: nível do passo com ruído uniforme de ±noise[passo] (limitado à faixa do
+// ADC), guardando os extremos, as somas e os instantes da tentativa atual do passo
+static uint16_t levels[STEP_COUNT] = {4000, 2100, 60, 1990};
+static uint16_t noise[STEP_COUNT];
+static uint16_t seen_min[STEP_COUNT], seen_max[STEP_COUNT];
+static uint32_t reads[STEP_COUNT], first_read_ms[STEP_COUNT], last_read_ms[STEP_COUNT];
+static uint64_t sum[STEP_COUNT], sum_sq[STEP_COUNT];
+
+static uint16_t read_input(uint8_t input) {
+  uint8_t step = cal.step;
+  CHECK_EQ(input, steps[step].input);
+  seed = seed * 1103515245u + 12345u;
+  int32_t value = levels[step] + (int32_t)((seed >> 8) % (2u * noise[step] + 1)) - noise[step];
+  value = value < 0 ? 0 : value > 4095 ? 4095 : value;
+  if (!reads[step]++)
+    first_read_ms[step] = now_ms;
+  last_read_ms[step] = now_ms;
+  if (value < seen_min[step])
+    seen_min[step] = value;
+  if (value > seen_max[step])
+    seen_max[step] = value;
+  sum[step] += value;
+  sum_sq[step] += (uint32_t)value * value;
+  return value;
+}
+
+static void reset_step(uint i) {
+  seen_min[i] = UINT16_MAX;
+  seen_max[i] = 0;
+  reads[i] = 0;
+  sum[i] = 0;
+  sum_sq[i] = 0;
+}
+
+static void reset_reads(void) {
+  for (uint i = 0; i < STEP_COUNT; ++i) {
+    reset_step(i);
+    noise[i] = 20;
+  }
+}
+
+// Média e desvio padrão da população arredondados a menos de 1/64 de código além do meio código:
+// o Q8 do calibrador arredonda a média a cada amostra
+static void check_stats(uint i) {
+  const calibrator_stats_t *s = &cal.stats[i];
+  double n = reads[i];
+  double mean = sum[i] / n;
+  double variance = sum_sq[i] / n - mean * mean;
+  double lo = s->stddev - 0.5 - 1.0 / 64, hi = s->stddev + 0.5 + 1.0 / 64;
+
+  CHECK_EQ(s->count, reads[i]);
+  if (s->mean - mean > 0.5 + 1.0 / 64 || mean - s->mean > 0.5 + 1.0 / 64) {
+    fprintf(stderr, "passo %u: média %u, exata %.3f\n", i, s->mean, mean);
+    exit(1);
+  }
+  if ((lo > 0 && variance < lo * lo) || variance > hi * hi) {
+    fprintf(stderr, "passo %u: desvio %u, variância exata %.3f\n", i, s->stddev, variance);
+    exit(1);
+  }
+}
+
+// Roda a sequência com um tick a cada tick_ms e confere os instantes de cada evento
+static void run_sequence(uint32_t start_ms, uint32_t tick_ms) {
+  uint8_t prompts = 0;
+
+  reset_reads();
+  now_ms = start_ms;
+  calibrator_start(&cal, now_ms);
+  CHECK(calibrator_running(&cal));
+  for (;;) {
+    calibrator_event_t event = calibrator_tick(&cal, now_ms);
+    if (event == CALIBRATOR_EV_PROMPT) {
+      CHECK_EQ(calibrator_prompt(&cal), 10 + prompts);
+      if (tick_ms == 1)
+        CHECK_EQ(now_ms - start_ms, prompts * STEP_MS);
+      ++prompts;
+    } else if (event == CALIBRATOR_EV_DONE) {
+      break;
+    } else {
+      CHECK_EQ(event, CALIBRATOR_EV_NONE);
+    }
+    now_ms += tick_ms;
+    CHECK(now_ms - start_ms < 10 * STEP_COUNT * STEP_MS);
+  }
+  CHECK_EQ(prompts, STEP_COUNT);
+  CHECK(!calibrator_running(&cal));
+  if (tick_ms == 1)
+    CHECK_EQ(now_ms - start_ms, STEP_COUNT * STEP_MS);
+
+  for (uint i = 0; i < STEP_COUNT; ++i) {
+    // Todas as amostras, só depois da espera, e o extremo pedido de cada passo
+    CHECK_EQ(reads[i], SAMPLES);
+    CHECK_EQ(cal.stats[i].count, SAMPLES);
+    CHECK(first_read_ms[i] - start_ms >= i * STEP_MS + SETTLE_MS);
+    CHECK(last_read_ms[i] - first_read_ms[i] >= (SAMPLES - 1) * INTERVAL_MS);
+    CHECK_EQ(cal.stats[i].min, seen_min[i]);
+    CHECK_EQ(cal.stats[i].max, seen_max[i]);
+    CHECK_EQ(*steps[i].result, steps[i].keep == CALIBRATOR_KEEP_MIN ? seen_min[i] : seen_max[i]);
+    check_stats(i);
+    CHECK(cal.stats[i].stddev <= MAX_STDDEV);
+  }
+}
+
+static void test_timeline(void) {
+  run_sequence(1000, 1);
+
+  // Ticks mais lentos que o intervalo: no máximo uma amostra por tick, nenhuma perdida
+  run_sequence(50000, 7);
+  run_sequence(200000, 25);
+
+  // Contador de ms dando a volta no meio da sequência
+  run_sequence(UINT32_MAX - 5000, 1);
+}
+
+static void test_stats(void) {
+  static const uint16_t saved[STEP_COUNT] = {4000, 2100, 60, 1990};
+
+  // Leituras paradas nos extremos do ADC: média exata e desvio zero
+  reset_reads();
+  levels[0] = 4095;
+  levels[1] = 0;
+  noise[0] = noise[1] = 0;
+  now_ms = 0;
+  calibrator_start(&cal, now_ms);
+  while (calibrator_tick(&cal, now_ms) != CALIBRATOR_EV_DONE)
+    ++now_ms;
+  CHECK_EQ(cal.stats[0].mean, 4095);
+  CHECK_EQ(cal.stats[0].stddev, 0);
+  CHECK_EQ(cal.stats[1].mean, 0);
+  CHECK_EQ(cal.stats[1].stddev, 0);
+  for (uint i = 0; i < STEP_COUNT; ++i)
+    check_stats(i);
+
+  // Ruído grande sem limite de desvio: a média e o desvio continuam exatos (±2000 códigos: ~1155)
+  calibrator_init(&cal, steps, STEP_COUNT, SETTLE_MS, SAMPLES, INTERVAL_MS, 0, read_input);
+  reset_reads();
+  levels[0] = 2048;
+  noise[0] = 2000;
+  calibrator_start(&cal, now_ms);
+  while (calibrator_tick(&cal, now_ms) != CALIBRATOR_EV_DONE)
+    ++now_ms;
+  CHECK_RANGE(cal.stats[0].stddev, 1100, 1200);
+  for (uint i = 0; i < STEP_COUNT; ++i)
+    check_stats(i);
+
+  for (uint i = 0; i < STEP_COUNT; ++i)
+    levels[i] = saved[i];
+  calibrator_init(&cal, steps, STEP_COUNT, SETTLE_MS, SAMPLES, INTERVAL_MS, MAX_STDDEV, read_input);
+}
+
+static void test_noisy_step(void) {
+  uint8_t prompts = 0, retries = 0;
+  uint32_t start_ms = 500000;
+
+  // Joystick mexendo no segundo passo (±100 códigos, desvio ~58): o passo é rejeitado no fim da
+  // coleta, o mesmo aviso volta e a tentativa seguinte, parada, é a que vale
+  reset_reads();
+  noise[1] = 100;
+  now_ms = start_ms;
+  calibrator_start(&cal, now_ms);
+  for (;;) {
+    calibrator_event_t event = calibrator_tick(&cal, now_ms);
+    if (event == CALIBRATOR_EV_RETRY) {
+      CHECK_EQ(cal.step, 1);
+      CHECK_EQ(calibrator_prompt(&cal), 11);
+      CHECK_EQ(now_ms - start_ms, 2 * STEP_MS);
+      CHECK(cal.stats[1].stddev > MAX_STDDEV);
+      CHECK_EQ(cal.stats[1].min, seen_min[1]);
+      CHECK_EQ(cal.stats[1].max, seen_max[1]);
+      check_stats(1);
+      ++retries;
+      reset_step(1);
+      noise[1] = 20;
+    } else if (event == CALIBRATOR_EV_PROMPT) {
+      CHECK_EQ(calibrator_prompt(&cal), 10 + prompts);
+      ++prompts;
+    } else if (event == CALIBRATOR_EV_DONE) {
+      break;
+    }
+    ++now_ms;
+  }
+  CHECK_EQ(retries, 1);
+  CHECK_EQ(prompts, STEP_COUNT);
+  CHECK_EQ(now_ms - start_ms, (STEP_COUNT + 1) * STEP_MS);
+  for (uint i = 0; i < STEP_COUNT; ++i) {
+    CHECK_EQ(reads[i], SAMPLES);
+    check_stats(i);
+    CHECK_EQ(*steps[i].result, steps[i].keep == CALIBRATOR_KEEP_MIN ? seen_min[i] : seen_max[i]);
+  }
+}
+
+static void test_abort(void) {
+  uint16_t before[STEP_COUNT];
+
+  for (uint i = 0; i < STEP_COUNT; ++i)
+    before[i] = results[i] = 1000 + i;
+
+  // Aborto no meio do terceiro passo: o evento sai no tick seguinte e os resultados ficam
+  reset_reads();
+  now_ms = 0;
+  calibrator_start(&cal, now_ms);
+  while (now_ms < 2 * STEP_MS + SETTLE_MS + 50)
+    calibrator_tick(&cal, now_ms++);
+  CHECK_EQ(cal.step, 2);
+  calibrator_abort(&cal);
+  CHECK(calibrator_running(&cal));
+  CHECK_EQ(calibrator_tick(&cal, now_ms), CALIBRATOR_EV_ABORTED);
+  CHECK(!calibrator_running(&cal));
+  CHECK_EQ(calibrator_tick(&cal, ++now_ms), CALIBRATOR_EV_NONE);
+  for (uint i = 0; i < STEP_COUNT; ++i)
+    CHECK_EQ(results[i], before[i]);
+
+  // Abortar parado não faz nada, e a sequência recomeça do primeiro passo
+  calibrator_abort(&cal);
+  CHECK_EQ(calibrator_tick(&cal, now_ms), CALIBRATOR_EV_NONE);
+  run_sequence(now_ms, 1);
+
+  // Abortar logo depois de iniciar, antes do primeiro aviso
+  calibrator_start(&cal, now_ms);
+  calibrator_abort(&cal);
+  CHECK_EQ(calibrator_tick(&cal, now_ms), CALIBRATOR_EV_ABORTED);
+}
+
+int main(void) {
+  calibrator_init(&cal, steps, STEP_COUNT, SETTLE_MS, SAMPLES, INTERVAL_MS, MAX_STDDEV, read_input);
+  CHECK_EQ(calibrator_tick(&cal, 0), CALIBRATOR_EV_NONE);
+
+  test_timeline();
+  test_stats();
+  test_noisy_step();
+  test_abort();
+  return 0;
+}
@@ -0,0 +1,74 @@
+#include "hal/sim.h"
+#include "hardware/sync.h"
+#include "tests/check.h"
+
+// Relógio virtual da simulação: ordem dos alarmes, repetição e cancelamento como no SDK
+
+static uint order[8];
+static uint fired;
+static uint64_t fired_ns[8];
+
+static int64_t alarm_mark(alarm_id_t id, void *arg) {
+  (void)id;
+  fired_ns[fired] = sim_now_ns();
+  order[fired++] = (uint)(uintptr_t)arg;
+  return 0;
+}
+
+static uint ticks;
+static uint64_t tick_ns[4];
+
+static bool tick(repeating_timer_t *rt) {
+  (void)rt;
+  if (ticks < 4)
+    tick_ns[ticks] = sim_now_ns();
+  return ++ticks < 4;
+}
+
+static void event_mark(void *arg) {
+  order[fired++] = (uint)(uintptr_t)arg;
+}
+
+int main(void) {
+  // Disparam pelo instante e, no mesmo instante, na ordem em que foram criados
+  add_alarm_in_us(300, alarm_mark, (void *)3, false);
+  add_alarm_in_us(100, alarm_mark, (void *)1, false);
+  add_alarm_in_us(200, alarm_mark, (void *)2, false);
+  add_alarm_in_us(200, alarm_mark, (void *)4, false);
+  alarm_id_t cancelled = add_alarm_in_us(250, alarm_mark, (void *)9, false);
+  CHECK(cancel_alarm(cancelled));
+  sleep_us(1000);
+  CHECK_EQ(fired, 4);
+  CHECK_EQ(order[0], 1);
+  CHECK_EQ(order[1], 2);
+  CHECK_EQ(order[2], 4);
+  CHECK_EQ(order[3], 3);
+  CHECK_EQ(fired_ns[0], 100000);
+  CHECK_EQ(fired_ns[3], 300000);
+  CHECK_EQ(time_us_64(), 1000);
+
+  // Atraso negativo conta entre inícios: sem deriva
+  repeating_timer_t timer;
+  CHECK(add_repeating_timer_us(-500, tick, NULL, &timer));
+  sleep_ms(10);
+  CHECK_EQ(ticks, 4);
+  for (uint i = 0; i < 4; ++i)
+    CHECK_EQ(tick_ns[i], 1000000 + (i + 1) * 500000ull);
+
+  // Eventos do cenário na mesma fila
+  fired = 0;
+  CHECK(sim_at(sim_now_ns() + 5000, event_mark, (void *)7));
+  tight_loop_contents();
+  CHECK_EQ(fired, 0);
+  sleep_us(5);
+  CHECK_EQ(fired, 1);
+  CHECK_EQ(order[0], 7);
+
+  // __wfe dorme até o próximo alarme
+  uint64_t before = sim_now_ns();
+  add_alarm_in_ms(3, alarm_mark, (void *)5, false);
+  __wfe();
+  CHECK_EQ(sim_now_ns(), before + 3000000);
+  CHECK_EQ(order[1], 5);
+  return 0;
+}
@@ -0,0 +1,276 @@
+#include <string.h>
+#include <time.h>
+#include "hal/sim.h"
+#include "inc/ssd1306.h"
+#include "bench/reference.h"
+#include "sprites.h"
+#include "tests/check.h"
+
+// Primitivas de desenho por página, texto e rostinhos comparados com o desenho antigo pixel a pixel
+// (bench/reference.c): depois de cada operação os dois buffers têm que ser iguais byte a byte. No
+// fim, uma medição rápida das duas versões (só informativa: o teste não depende do tempo)
+
+#define RANDOM_OPS 20000
+
+static ssd1306_t ssd;
+static uint8_t ref[1 + WIDTH * HEIGHT / 8];
+static uint32_t seed = 12345;
+
+static uint32_t next_random(void) {
+  seed = seed * 1103515245u + 12345u;
+  return seed >> 8;
+}
+
+static uint8_t random_below(uint32_t n) {
+  return (uint8_t)(next_random() % n);
+}
+
+static void check_same(const char *what, uint32_t op) {
+  if (memcmp(&ssd.ram_buffer[1], &ref[1], WIDTH * HEIGHT / 8)) {
+    for (uint i = 1; i <= WIDTH * HEIGHT / 8; ++i) {
+      if (ssd.ram_buffer[i] != ref[i]) {
+        fprintf(stderr, "%s (operação %u): página %u coluna %u: %02x != %02x\n", what, op, (i - 1) / WIDTH,
+                (i - 1) % WIDTH, ssd.ram_buffer[i], ref[i]);
+        break;
+      }
+    }
+    exit(1);
+  }
+}
+
+// Fundo aleatório igual nos dois buffers, para as máscaras das páginas parciais serem exercitadas
+static void random_background(void) {
+  for (uint i = 1; i <= WIDTH * HEIGHT / 8; ++i)
+    ref[i] = ssd.ram_buffer[i] = (uint8_t)next_random();
+}
+
+static void test_primitives(void) {
+  uint8_t bitmap[32 * 4];
+
+  random_background();
+  for (uint32_t op = 0; op < RANDOM_OPS; ++op) {
+    bool value = next_random() & 1;
+    // Posições e tamanhos até um pouco além das bordas, para o corte ser comparado também
+    uint8_t x = random_below(WIDTH), y = random_below(HEIGHT);
+    uint8_t w = 1 + random_below(40), h = 1 + random_below(40);
+
+    switch (random_below(7)) {
+      case 0:
+        ssd1306_hline(&ssd, x, x + w - 1, y, value);
+        ref_hline(ref, x, x + w - 1, y, value);
+        check_same("hline", op);
+        break;
+      case 1:
+        ssd1306_vline(&ssd, x, y, y + h - 1, value);
+        ref_vline(ref, x, y, y + h - 1, value);
+        check_same("vline", op);
+        break;
+      case 2:
+        ssd1306_fill_rect(&ssd, y, x, w, h, value);
+        ref_rect(ref, y, x, w, h, value, true);
+        check_same("fill_rect", op);
+        break;
+      case 3:
+        ssd1306_rect(&ssd, y, x, w, h, value, false);
+        ref_rect(ref, y, x, w, h, value, false);
+        check_same("rect", op);
+        break;
+      case 4:
+        ssd1306_rect(&ssd, y, x, w, h, value, true);
+        ref_rect(ref, y, x, w, h, value, true);
+        check_same("rect cheio", op);
+        break;
+      case 5: {
+        uint8_t bw = 1 + random_below(32), bh = 1 + random_below(32);
+        for (uint i = 0; i < sizeof(bitmap); ++i)
+          bitmap[i] = (uint8_t)next_random();
+        ssd1306_blit(&ssd, bitmap, x, y, bw, bh);
+        ref_blit(ref, bitmap, x, y, bw, bh);
+        check_same("blit", op);
+        break;
+      }
+      default:
+        if (random_below(50) == 0) { // A tela inteira raramente, para não apagar o resto do teste
+          ssd1306_fill(&ssd, value);
+          ref_fill(ref, value);
+          check_same("fill", op);
+          random_background();
+        } else {
+          ssd1306_pixel(&ssd, x, y, value);
+          ref_pixel(ref, x, y, value);
+          check_same("pixel", op);
+        }
+        break;
+    }
+  }
+}
+
+static void test_text(void) {
+  static const char charset[] = " 0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz:?*%-";
+
+  // Cada caractere da fonte em posições alinhadas e desalinhadas às páginas, até a borda
+  random_background();
+  for (uint32_t op = 0; op < RANDOM_OPS; ++op) {
+    char c = charset[random_below(sizeof(charset) - 1)];
+    uint8_t x = random_below(WIDTH), y = random_below(HEIGHT);
+    ssd1306_draw_char(&ssd, c, x, y);
+    ref_draw_char(ref, c, x, y);
+    check_same("draw_char", op);
+  }
+
+  // Textos da tela com a quebra de linha e o corte no fim do display
+  static const char *const texts[] = {"T: 25C*", "Vent: Medio", "Umid: Liga", "Lim 1: -15C*", charset};
+  for (uint i = 0; i < sizeof(texts) / sizeof(texts[0]); ++i) {
+    for (uint8_t y = 0; y < 40; y += 3) {
+      ssd1306_draw_string(&ssd, texts[i], 6 + y, y);
+      ref_draw_string(ref, texts[i], 6 + y, y);
+      check_same("draw_string", i);
+    }
+  }
+
+  // Fora da fonte: o desenho antigo deixava em branco, o novo mostra '?'
+  ssd1306_draw_char(&ssd, '#', 20, 20);
+  ref_draw_char(ref, '?', 20, 20);
+  check_same("caractere desconhecido", 0);
+}
+
+// Matrizes 22x22 dos rostinhos de antes dos bitmaps gerados de sprites.txt, desenhadas pixel a pixel
+static const char *const old_faces[3][22] = {
+  { // draw_happy
+    "........######........",
+    "......##########......",
+    "....####......####....",
+    "...###..........###...",
+    "..###............###..",
+    "..##..............##..",
+    ".##................##.",
+    ".##....##....##....##.",
+    "##.....##....##.....##",
+    "##..................##",
+    "##..................##",
+    "##..................##",
+    "##..................##",
+    "##....##......##....##",
+    ".##....##....##....##.",
+    ".##.....######.....##.",
+    "..##..............##..",
+    "..###............###..",
+    "...###..........###...",
+    "....####......####....",
+    "......##########......",
+    "........######........",
+  },
+  { // draw_neutral
+    "........######........",
+    "......##########......",
+    "....####......####....",
+    "...###..........###...",
+    "..###............###..",
+    "..##..............##..",
+    ".##................##.",
+    ".##....##....##....##.",
+    "##.....##....##.....##",
+    "##..................##",
+    "##..................##",
+    "##..................##",
+    "##..................##",
+    "##..................##",
+    ".##.....######.....##.",
+    ".##................##.",
+    "..##..............##..",
+    "..###............###..",
+    "...###..........###...",
+    "....####......####....",
+    "......##########......",
+    "........######........",
+  },
+  { // draw_sad
+    "........######........",
+    "......##########......",
+    "....####......####....",
+    "...###..........###...",
+    "..###............###..",
+    "..##..............##..",
+    ".##................##.",
+    ".##....##....##....##.",
+    "##.....##....##.....##",
+    "##..................##",
+    "##..................##",
+    "##..................##",
+    "##..................##",
+    "##......######......##",
+    ".##....##....##....##.",
+    ".##...##......##...##.",
+    "..##..............##..",
+    "..###............###..",
+    "...###..........###...",
+    "....####......####....",
+    "......##########......",
+    "........######........",
+  },
+};
+
+static const sprite_t *const new_faces[3] = {&face_happy, &face_neutral, &face_sad};
+
+// Rostinho antigo: um ssd1306_pixel por posição da matriz
+static void ref_face(const char *const *rows, uint8_t x0, uint8_t y0) {
+  for (uint8_t y = 0; y < 22; ++y)
+    for (uint8_t x = 0; x < 22; ++x)
+      ref_pixel(ref, x0 + x, y0 + y, rows[y][x] == '#');
+}
+
+static void test_faces(void) {
+  // Posição da tela principal, as duas paridades de y e o corte nas bordas
+  static const uint8_t positions[][2] = {{84, 6}, {84, 7}, {84, 8}, {0, 0}, {110, 50}, {3, 45}};
+
+  for (uint f = 0; f < 3; ++f) {
+    CHECK_EQ(new_faces[f]->width, 22);
+    CHECK_EQ(new_faces[f]->height, 22);
+    for (uint p = 0; p < sizeof(positions) / sizeof(positions[0]); ++p) {
+      random_background();
+      sprite_draw(&ssd, new_faces[f], positions[p][0], positions[p][1]);
+      ref_face(old_faces[f], positions[p][0], positions[p][1]);
+      check_same("rostinho", f * 16 + p);
+    }
+  }
+}
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+#define MEASURE(label, iterations, new_call, ref_call) do { \
+    uint64_t t0 = now_ns(); \
+    for (uint32_t i = 0; i < (iterations); ++i) { new_call; } \
+    uint64_t t1 = now_ns(); \
+    for (uint32_t i = 0; i < (iterations); ++i) { ref_call; } \
+    uint64_t t2 = now_ns(); \
+    printf("%-12s por página %8.1f ns   pixel a pixel %8.1f ns\n", label, (double)(t1 - t0) / (iterations), \
+           (double)(t2 - t1) / (iterations)); \
+  } while (0)
+
+static void measure_primitives(void) {
+  static const uint8_t bitmap[22 * 3] = {0xFF, 0x81, 0x42, 0x24, 0x18};
+
+  MEASURE("fill", 2000, ssd1306_fill(&ssd, i & 1), ref_fill(ref, i & 1));
+  MEASURE("hline", 200000, ssd1306_hline(&ssd, 0, 127, i & 63, i & 64), ref_hline(ref, 0, 127, i & 63, i & 64));
+  MEASURE("vline", 200000, ssd1306_vline(&ssd, i & 127, 0, 63, i & 128), ref_vline(ref, i & 127, 0, 63, i & 128));
+  MEASURE("fill_rect", 20000, ssd1306_fill_rect(&ssd, 3, 5, 100, 50, i & 1), ref_rect(ref, 3, 5, 100, 50, i & 1, true));
+  MEASURE("draw_string", 100000, ssd1306_draw_string(&ssd, i & 1 ? "Vent: Alto" : "Umid: Liga", 6, 37 + (i & 2)),
+          ref_draw_string(ref, i & 1 ? "Vent: Alto" : "Umid: Liga", 6, 37 + (i & 2)));
+  MEASURE("rostinho", 100000, sprite_draw(&ssd, new_faces[i % 3], 84, 6), ref_face(old_faces[i % 3], 84, 6));
+  MEASURE("blit 22x22", 100000, ssd1306_blit(&ssd, bitmap, 84, 6 + (i & 1), 22, 22),
+          ref_blit(ref, bitmap, 84, 6 + (i & 1), 22, 22));
+}
+
+int main(void) {
+  ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, i2c1);
+
+  test_primitives();
+  test_text();
+  test_faces();
+  measure_primitives();
+  return 0;
+}
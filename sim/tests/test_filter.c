@@ -0,0 +1,140 @@
+#include "hal/sim.h"
+#include "hardware/adc.h"
+#include "inc/sampler.h"
+#include "inc/filter.h"
+#include "tests/check.h"
+
+// Filtro dos eixos: sequências sintéticas pela filter_step (mediana, EMA, acomodação) e o filtro do
+// firmware sobre o ruído do ADC simulado, sempre com as mesmas entradas
+
+#define Q4(code) ((uint16_t)((code) << FILTER_FRAC_BITS))
+
+static uint32_t variance16(const uint16_t *v, uint n) {
+  int64_t sum = 0, sum_sq = 0;
+  for (uint i = 0; i < n; ++i) {
+    sum += v[i];
+    sum_sq += (int64_t)v[i] * v[i];
+  }
+  return (uint32_t)((16 * (sum_sq * n - sum * sum)) / ((int64_t)n * n));
+}
+
+static void test_constant(void) {
+  static const filter_config_t config = {0, 5, 3};
+  filter_t f;
+
+  // A primeira leitura inicializa a EMA: sem rampa a partir de zero
+  filter_init(&f, &config, 0);
+  for (uint i = 0; i < 100; ++i)
+    CHECK_EQ(filter_step(&f, Q4(1234)), Q4(1234));
+  CHECK_EQ(filter_value(&f), 1234);
+
+  filter_reset(&f);
+  CHECK_EQ(filter_step(&f, Q4(10)), Q4(10));
+}
+
+static void test_median(void) {
+  static const filter_config_t median5 = {0, 5, 0}, median3 = {0, 3, 0};
+  filter_t f;
+
+  // Com a janela de 5 cheia, picos para cima isolados e pares de picos para baixo não aparecem na
+  // saída (no máximo 2 valores fora de cada lado da mediana)
+  filter_init(&f, &median5, 0);
+  for (uint i = 0; i < 5; ++i)
+    filter_step(&f, Q4(2000));
+  for (uint i = 0; i < 200; ++i) {
+    uint16_t code = 2000 + (i % 7 == 3 ? 900 : 0) - (i % 13 == 8 || i % 13 == 9 ? 800 : 0);
+    CHECK_EQ(filter_step(&f, Q4(code)), Q4(2000));
+  }
+
+  // Com a janela de 3, dois picos seguidos passam: a mediana só segura um
+  filter_init(&f, &median3, 0);
+  filter_step(&f, Q4(2000));
+  filter_step(&f, Q4(2000));
+  CHECK_EQ(filter_step(&f, Q4(3000)), Q4(2000));
+  CHECK_EQ(filter_step(&f, Q4(3000)), Q4(3000));
+
+  // Degrau: a mediana de 5 atrasa 2 leituras
+  filter_init(&f, &median5, 0);
+  for (uint i = 0; i < 5; ++i)
+    filter_step(&f, Q4(1000));
+  CHECK_EQ(filter_step(&f, Q4(2000)), Q4(1000));
+  CHECK_EQ(filter_step(&f, Q4(2000)), Q4(1000));
+  CHECK_EQ(filter_step(&f, Q4(2000)), Q4(2000));
+}
+
+static void test_settling(void) {
+  static const filter_config_t config = {0, 1, 3}; // Só a EMA, alfa 1/8
+  filter_t f;
+  uint steps = 0;
+  uint16_t last;
+
+  // Degrau de 1000 códigos: o erro cai 7/8 por leitura, sem ultrapassar o valor final
+  filter_init(&f, &config, 0);
+  filter_step(&f, Q4(1000));
+  last = filter_output(&f);
+  while (filter_value(&f) != 2000) {
+    uint16_t out = filter_step(&f, Q4(2000));
+    CHECK(out >= last);
+    CHECK(out <= Q4(2000));
+    last = out;
+    ++steps;
+    CHECK(steps < 200);
+  }
+  // ln(0.5 / 1000) / ln(7/8) = 57 leituras até o erro ficar abaixo de meio código
+  CHECK_RANGE(steps, 54, 60);
+
+  // Com a entrada parada a saída fica exatamente no valor (o acumulador não perde o arredondamento)
+  for (uint i = 0; i < 200; ++i)
+    filter_step(&f, Q4(2000));
+  CHECK_EQ(filter_output(&f), Q4(2000));
+
+  // E desce da mesma forma
+  steps = 0;
+  while (filter_value(&f) != 1000) {
+    filter_step(&f, Q4(1000));
+    CHECK(++steps < 200);
+  }
+  CHECK_RANGE(steps, 54, 60);
+}
+
+static void test_noise_replay(void) {
+  // O filtro do firmware (4x4 amostras, mediana de 3, EMA de 1/4) a 1 kHz sobre o ADC com ruído de
+  // ±80 códigos: a saída fica perto do nível e com variância bem menor que a das amostras
+  static const filter_config_t jsk_filter = {2, 3, 2};
+  static uint16_t raw[2000], out[2000];
+  filter_t f;
+
+  adc_init();
+  sim_adc_set(0, 3100);
+  sim_adc_noise(0, 80);
+  CHECK(sampler_init(0x03, 8000));
+  filter_init(&f, &jsk_filter, 0);
+  for (uint i = 0; i < 2000; ++i) {
+    sleep_ms(1);
+    raw[i] = sampler_latest(0);
+    out[i] = filter_update(&f);
+    CHECK_RANGE(out[i], 3100 - 40, 3100 + 40);
+  }
+  uint32_t raw_var = variance16(raw, 2000), out_var = variance16(out, 2000);
+  printf("variância: amostra %.1f, filtro %.1f\n", raw_var / 16.0, out_var / 16.0);
+  CHECK(out_var * 30 < raw_var);
+
+  // Acomodação depois de um degrau do joystick, com o ruído
+  sim_adc_set(0, 1000);
+  uint ms = 0;
+  while (filter_update(&f) > 1000 + 20) {
+    sleep_ms(1);
+    CHECK(++ms < 100);
+  }
+  printf("acomodação do degrau: %u ms\n", ms);
+  CHECK_RANGE(ms, 5, 30);
+  sim_adc_noise(0, 0);
+}
+
+int main(void) {
+  test_constant();
+  test_median();
+  test_settling();
+  test_noise_replay();
+  return 0;
+}
@@ -0,0 +1,75 @@
+#include <string.h>
+#include "inc/fmt.h"
+#include "tests/check.h"
+
+// Formatação sem printf comparada com o snprintf da biblioteca C ("%*u" e "%*d"): todos os valores
+// de 0 a 2^17 (toda a faixa da divisão por multiplicação e a passagem para a divisão), toda a faixa
+// de int16 com sinal, as bordas de 32 bits e valores espalhados, em todas as larguras
+
+static uint32_t seed = 99;
+
+static uint32_t next_random(void) {
+  seed = seed * 1664525u + 1013904223u;
+  return seed;
+}
+
+static void check_uint(uint32_t value, uint8_t width) {
+  char expected[16], got[16];
+  snprintf(expected, sizeof(expected), "%*u", width, value);
+  *fmt_uint(got, value, width) = '\0';
+  if (strcmp(expected, got)) {
+    fprintf(stderr, "fmt_uint(%u, %u): \"%s\" != \"%s\"\n", value, width, got, expected);
+    exit(1);
+  }
+}
+
+static void check_int(int32_t value, uint8_t width) {
+  char expected[16], got[16];
+  snprintf(expected, sizeof(expected), "%*d", width, value);
+  *fmt_int(got, value, width) = '\0';
+  if (strcmp(expected, got)) {
+    fprintf(stderr, "fmt_int(%d, %u): \"%s\" != \"%s\"\n", value, width, got, expected);
+    exit(1);
+  }
+}
+
+int main(void) {
+  static const uint32_t edges[] = {
+    9, 10, 99, 100, 81919, 81920, 81921, 99999, 100000, 999999999, 1000000000,
+    2147483647u, 2147483648u, 4294967294u, 4294967295u,
+  };
+
+  for (uint32_t v = 0; v <= 1u << 17; ++v)
+    for (uint8_t width = 0; width <= 7; ++width)
+      check_uint(v, width);
+
+  for (int32_t v = INT16_MIN; v <= INT16_MAX; ++v)
+    for (uint8_t width = 0; width <= 7; ++width)
+      check_int(v, width);
+
+  for (uint i = 0; i < sizeof(edges) / sizeof(edges[0]); ++i) {
+    for (uint8_t width = 0; width <= 12; ++width) {
+      check_uint(edges[i], width);
+      check_int((int32_t)edges[i], width);
+      check_int(-(int32_t)(edges[i] & 0x7FFFFFFF), width);
+    }
+  }
+  check_int(INT32_MIN, 0);
+  check_int(INT32_MIN, 12);
+
+  for (uint i = 0; i < 1000000; ++i) {
+    uint32_t v = next_random() >> (next_random() & 31);
+    check_uint(v, i % 12);
+    check_int((int32_t)v, i % 12);
+    check_int(-(int32_t)(v >> 1), i % 12);
+  }
+
+  // Textos e preenchimento
+  char text[32];
+  char *end = fmt_fill(fmt_str(text, "T:"), '.', 3);
+  *fmt_str(end, "C*") = '\0';
+  CHECK(!strcmp(text, "T:...C*"));
+  *fmt_fill(text, ' ', 0) = '\0';
+  CHECK(!strcmp(text, ""));
+  return 0;
+}
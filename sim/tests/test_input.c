@@ -0,0 +1,212 @@
+#include "hal/sim.h"
+#include "inc/input.h"
+#include "inc/trace.h"
+#include "tests/check.h"
+
+// Eventos dos botões a partir de gravações de bordas (com trepidação) reproduzidas pela input_edge,
+// como a interrupção faria, com o input_poll a cada 1 ms no relógio simulado. O nível do pino
+// acompanha a gravação só para a conferência do input_poll depois do debounce; as interrupções dos
+// pinos ficam desligadas para as bordas não entrarem duas vezes
+
+#define DEBOUNCE_MS 50
+#define LONG_PRESS_MS 1000
+#define DOUBLE_PRESS_MS 400
+
+enum { BTN_A, BTN_B };
+static const input_config_t buttons[] = {
+  [BTN_A] = {5, DEBOUNCE_MS, LONG_PRESS_MS, DOUBLE_PRESS_MS},
+  [BTN_B] = {6, DEBOUNCE_MS, LONG_PRESS_MS, DOUBLE_PRESS_MS},
+};
+
+// Borda gravada, em us a partir do início da gravação
+typedef struct {
+  uint32_t t_us;
+  uint8_t button;
+  bool pressed;
+} edge_t;
+
+static uint32_t start_us;
+
+static uint32_t elapsed_us(void) {
+  return time_us_32() - start_us;
+}
+
+// Avança até t_us chamando o input_poll a cada ms cheio
+static void run_to(uint32_t t_us) {
+  while (elapsed_us() < t_us) {
+    uint32_t next_poll = (elapsed_us() / 1000 + 1) * 1000;
+    if (next_poll > t_us) {
+      sleep_us(t_us - elapsed_us());
+      break;
+    }
+    sleep_us(next_poll - elapsed_us());
+    input_poll(time_us_32());
+  }
+}
+
+// Reproduz a gravação depois de 1 s parado, para não formar gestos com a gravação anterior
+static void replay(const edge_t *edges, uint count, uint32_t end_us) {
+  start_us = time_us_32();
+  run_to(1000000);
+  start_us = time_us_32();
+  for (uint i = 0; i < count; ++i) {
+    run_to(edges[i].t_us);
+    sim_gpio_drive(buttons[edges[i].button].gpio, !edges[i].pressed);
+    input_edge(edges[i].button, edges[i].pressed, time_us_32());
+  }
+  run_to(end_us);
+}
+
+// Próximo evento: botão, tipo e instante (ms desde o início da gravação, com tolerância)
+static void expect(uint8_t button, input_type_t type, uint32_t min_ms, uint32_t max_ms) {
+  input_event_t event;
+
+  CHECK(input_get(&event));
+  CHECK_EQ(event.button, button);
+  CHECK_EQ(event.type, type);
+  CHECK_EQ(event.count, 1);
+  CHECK_RANGE(event.time_us - start_us, min_ms * 1000, max_ms * 1000);
+}
+
+static void expect_none(void) {
+  input_event_t event;
+  CHECK(!input_get(&event));
+}
+
+static void test_clean_click(void) {
+  static const edge_t edges[] = {{10000, BTN_A, true}, {150000, BTN_A, false}};
+
+  replay(edges, 2, 300000);
+  expect(BTN_A, INPUT_PRESS, 10, 10);
+  expect(BTN_A, INPUT_RELEASE, 150, 150);
+  expect_none();
+}
+
+static void test_bounce(void) {
+  // Contato trepidando por ~1 ms ao apertar e ao soltar: um evento para cada lado
+  static const edge_t edges[] = {
+    {10000, BTN_A, true}, {10150, BTN_A, false}, {10300, BTN_A, true}, {10420, BTN_A, false},
+    {10600, BTN_A, true}, {10900, BTN_A, false}, {11000, BTN_A, true},
+    {200000, BTN_A, false}, {200100, BTN_A, true}, {200250, BTN_A, false}, {200500, BTN_A, true},
+    {200800, BTN_A, false},
+  };
+
+  replay(edges, sizeof(edges) / sizeof(edges[0]), 700000);
+  expect(BTN_A, INPUT_PRESS, 10, 10);
+  expect(BTN_A, INPUT_RELEASE, 200, 200);
+  expect_none();
+}
+
+static void test_glitch(void) {
+  // Pulso de 1 ms: a borda de volta cai no debounce e o estado só é corrigido pelo nível do pino
+  // depois do debounce
+  static const edge_t edges[] = {{10000, BTN_B, true}, {11000, BTN_B, false}};
+
+  replay(edges, 2, 600000);
+  expect(BTN_B, INPUT_PRESS, 10, 10);
+  expect(BTN_B, INPUT_RELEASE, 10 + DEBOUNCE_MS, 10 + DEBOUNCE_MS + 1);
+  expect_none();
+}
+
+static void test_long_press(void) {
+  // Segurado 1,5 s (com trepidação no começo): um toque longo só, e ele não forma toque duplo com o
+  // toque seguinte
+  static const edge_t edges[] = {
+    {10000, BTN_A, true}, {10200, BTN_A, false}, {10400, BTN_A, true},
+    {1510000, BTN_A, false},
+    {1700000, BTN_A, true}, {1800000, BTN_A, false},
+  };
+
+  replay(edges, sizeof(edges) / sizeof(edges[0]), 2500000);
+  expect(BTN_A, INPUT_PRESS, 10, 10);
+  expect(BTN_A, INPUT_LONG_PRESS, 10 + LONG_PRESS_MS, 10 + LONG_PRESS_MS + 1);
+  expect(BTN_A, INPUT_RELEASE, 1510, 1510);
+  expect(BTN_A, INPUT_PRESS, 1700, 1700);
+  expect(BTN_A, INPUT_RELEASE, 1800, 1800);
+  expect_none();
+}
+
+static void test_double_press(void) {
+  // Dois toques em 300 ms formam um toque duplo e o terceiro começa um novo par (a fila de eventos
+  // tem 8 posições: cada gravação gera no máximo isso)
+  static const edge_t pair[] = {
+    {10000, BTN_B, true}, {100000, BTN_B, false},
+    {310000, BTN_B, true}, {400000, BTN_B, false},
+    {500000, BTN_B, true}, {560000, BTN_B, false},
+  };
+  // Segundo toque fora da janela
+  static const edge_t late[] = {{10000, BTN_B, true}, {60000, BTN_B, false}, {460000, BTN_B, true}, {520000, BTN_B, false}};
+
+  replay(pair, sizeof(pair) / sizeof(pair[0]), 1000000);
+  expect(BTN_B, INPUT_PRESS, 10, 10);
+  expect(BTN_B, INPUT_RELEASE, 100, 100);
+  expect(BTN_B, INPUT_PRESS, 310, 310);
+  expect(BTN_B, INPUT_DOUBLE_PRESS, 310, 310);
+  expect(BTN_B, INPUT_RELEASE, 400, 400);
+  expect(BTN_B, INPUT_PRESS, 500, 500);
+  expect(BTN_B, INPUT_RELEASE, 560, 560);
+  expect_none();
+
+  replay(late, sizeof(late) / sizeof(late[0]), 1000000);
+  expect(BTN_B, INPUT_PRESS, 10, 10);
+  expect(BTN_B, INPUT_RELEASE, 60, 60);
+  expect(BTN_B, INPUT_PRESS, 460, 460);
+  expect(BTN_B, INPUT_RELEASE, 520, 520);
+  expect_none();
+}
+
+static void test_two_buttons(void) {
+  // O botão A trepidando não atrasa nem filtra as bordas do B
+  static const edge_t edges[] = {
+    {10000, BTN_A, true}, {10100, BTN_B, true}, {10200, BTN_A, false}, {10300, BTN_A, true},
+    {10400, BTN_B, false}, {10450, BTN_B, true}, {10500, BTN_A, false}, {10600, BTN_A, true},
+    {100000, BTN_B, false}, {100050, BTN_A, false},
+  };
+
+  replay(edges, sizeof(edges) / sizeof(edges[0]), 300000);
+  expect(BTN_A, INPUT_PRESS, 10, 10);
+  expect(BTN_B, INPUT_PRESS, 10, 11);
+  expect(BTN_B, INPUT_RELEASE, 100, 100);
+  expect(BTN_A, INPUT_RELEASE, 100, 101);
+  expect_none();
+}
+
+static void test_overflow(void) {
+  static edge_t edges[40];
+  input_event_t event;
+
+  // 20 toques sem ler os eventos: a fila fica com os 8 mais recentes
+  for (uint i = 0; i < 20; ++i) {
+    edges[2 * i] = (edge_t){10000 + i * 1000000, BTN_A, true};
+    edges[2 * i + 1] = (edge_t){110000 + i * 1000000, BTN_A, false};
+  }
+  replay(edges, 40, 20 * 1000000 + 500000);
+  for (uint i = 0; i < INPUT_EVENT_QUEUE; ++i) {
+    CHECK(input_get(&event));
+    CHECK_EQ(event.type, i % 2 ? INPUT_RELEASE : INPUT_PRESS);
+    CHECK_EQ(event.time_us - start_us, (i % 2 ? 110000 : 10000) + (16 + i / 2) * 1000000);
+  }
+  expect_none();
+}
+
+int main(void) {
+  for (uint i = 0; i < 2; ++i) {
+    gpio_init(buttons[i].gpio);
+    gpio_set_dir(buttons[i].gpio, GPIO_IN);
+    gpio_pull_up(buttons[i].gpio);
+  }
+  sleep_ms(100);
+  trace_init();
+  input_init(buttons, 2);
+  for (uint i = 0; i < 2; ++i)
+    gpio_set_irq_enabled(buttons[i].gpio, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, false);
+
+  test_clean_click();
+  test_bounce();
+  test_glitch();
+  test_long_press();
+  test_double_press();
+  test_two_buttons();
+  test_overflow();
+  return 0;
+}
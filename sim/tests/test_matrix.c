@@ -0,0 +1,171 @@
+#include <string.h>
+#include "hal/sim.h"
+#include "hardware/pio.h"
+#include "ws2812.pio.h"
+#include "tests/check.h"
+
+// Matriz WS2812: o quadro enviado pela DMA (uma palavra de 24 bits por LED) tem que sair no fio
+// byte a byte igual ao envio antigo, com um pio_sm_put_blocking de 8 bits por cor. Os dois caminhos
+// usam máquinas de estados diferentes do modelo do PIO e os bytes travados são comparados. Os
+// quadros prontos da flash (np_frames) são comparados com os desenhos antigos montados pela npDraw
+
+#define LED_COUNT 25
+#define MATRIX_PIN 7
+#define NP_GRB(r, g, b) ((uint32_t)(g) | ((uint32_t)(r) << 8) | ((uint32_t)(b) << 16))
+
+// Do firmware (Projeto_Controle_Ambiente.c, compilado junto com o teste)
+extern uint sm;
+void npInit(uint pin);
+void npWrite(const uint32_t *frame);
+void npShowFrame(uint frame); // np_frame_t, na ordem de FRAME_CLEAR a FRAME_MIDDLE
+
+// Caminho antigo: ws2812.pio com autopull de 8 bits, os LEDs em G, R, B e 100 us de reset no fim
+typedef struct {
+  uint8_t G, R, B;
+} old_pixel_t;
+
+static old_pixel_t old_leds[LED_COUNT];
+static uint old_sm;
+static uint32_t seed = 2025;
+
+static uint32_t next_random(void) {
+  seed = seed * 1103515245u + 12345u;
+  return seed >> 8;
+}
+
+static void old_init(void) {
+  old_sm = pio_claim_unused_sm(pio0, true);
+  ws2812_program_init(pio0, old_sm, 0, MATRIX_PIN + 1, 800000.f);
+  sim_pio_set_pull_bits(0, old_sm, 8);
+}
+
+static void old_write(void) {
+  for (uint i = 0; i < LED_COUNT; ++i) {
+    pio_sm_put_blocking(pio0, old_sm, old_leds[i].G);
+    pio_sm_put_blocking(pio0, old_sm, old_leds[i].R);
+    pio_sm_put_blocking(pio0, old_sm, old_leds[i].B);
+  }
+  sleep_us(100);
+}
+
+// Mapeamento em zigue-zague da npDraw antiga
+static void old_draw(const char *const r[5], const char *const g[5], const char *const b[5]) {
+  for (int i = 0; i < 5; i++) {
+    int idx = (4 - i) * 5;
+    for (int j = 0; j < 5; j++) {
+      int col = (i % 2 == 0) ? (4 - j) : j;
+      old_leds[idx + col] = (old_pixel_t){g[i][j] - '0', r[i][j] - '0', b[i][j] - '0'};
+    }
+  }
+}
+
+// Bytes do último quadro das duas máquinas, iguais e com 3 bytes por LED
+static void check_same_wire(void) {
+  uint8_t wire[LED_COUNT * 3], old_wire[LED_COUNT * 3];
+
+  CHECK_EQ(sim_pio_wire(0, sm, wire, sizeof(wire)), LED_COUNT * 3);
+  CHECK_EQ(sim_pio_wire(0, old_sm, old_wire, sizeof(old_wire)), LED_COUNT * 3);
+  CHECK(!memcmp(wire, old_wire, sizeof(wire)));
+}
+
+static void test_random_frames(void) {
+  static uint32_t frame[LED_COUNT];
+
+  for (uint n = 0; n < 200; ++n) {
+    for (uint i = 0; i < LED_COUNT; ++i) {
+      uint8_t r = (uint8_t)next_random(), g = (uint8_t)next_random(), b = (uint8_t)next_random();
+      old_leds[i] = (old_pixel_t){g, r, b};
+      frame[i] = NP_GRB(r, g, b);
+    }
+    uint64_t frames = sim_pio_frames(0, sm), words = sim_pio_words(0, sm);
+    uint64_t old_words = sim_pio_words(0, old_sm);
+
+    // O envio pela DMA retorna logo; o antigo prende o processador durante o quadro inteiro
+    uint64_t start = sim_now_ns();
+    npWrite(frame);
+    CHECK(sim_now_ns() - start < 1000);
+    start = sim_now_ns();
+    old_write();
+    CHECK(sim_now_ns() - start >= LED_COUNT * 24 * 1250);
+    sleep_us(500);
+
+    check_same_wire();
+    CHECK_EQ(sim_pio_frames(0, sm), frames + 1);
+    CHECK_EQ(sim_pio_words(0, sm), words + LED_COUNT);
+    CHECK_EQ(sim_pio_words(0, old_sm), old_words + 3 * LED_COUNT);
+  }
+}
+
+static void test_back_to_back(void) {
+  static uint32_t first[LED_COUNT], second[LED_COUNT];
+
+  // Dois quadros seguidos: o segundo npWrite espera o primeiro e o tempo de reset, e os dois são
+  // travados separadamente
+  for (uint i = 0; i < LED_COUNT; ++i) {
+    first[i] = NP_GRB(i, 0, 255 - i);
+    second[i] = NP_GRB(0, 3 * i, 1);
+    old_leds[i] = (old_pixel_t){3 * i, 0, 1};
+  }
+  uint64_t frames = sim_pio_frames(0, sm);
+  npWrite(first);
+  npWrite(second);
+  old_write();
+  sleep_us(500);
+  CHECK_EQ(sim_pio_frames(0, sm), frames + 2);
+  check_same_wire();
+}
+
+// Matrizes vetorR, vetorG e vetorB das funções de desenho antigas, na ordem de np_frame_t
+#define ZERO {"00000", "00000", "00000", "00000", "00000"}
+
+static const char *const old_frames[][3][5] = {
+  {ZERO, ZERO, ZERO}, // npClear
+  { // humidifier_matrix
+    {"10000", "01000", "00100", "00010", "00001"},
+    ZERO,
+    {"00100", "00110", "11011", "11101", "01110"},
+  },
+  { // temperature_screen
+    {"11111", "10101", "00100", "00100", "01110"},
+    ZERO,
+    ZERO,
+  },
+  { // humidifier_screen
+    ZERO,
+    ZERO,
+    {"10001", "10001", "10001", "10001", "11111"},
+  },
+  { // calibration_screen
+    {"00000", "01110", "01010", "01110", "00000"},
+    {"00000", "01110", "01010", "01110", "00000"},
+    ZERO,
+  },
+  {ZERO, {"00100", "01110", "10101", "00100", "00100"}, ZERO}, // seta_cima
+  {ZERO, {"00100", "00100", "10101", "01110", "00100"}, ZERO}, // seta_baixo
+  {ZERO, {"00100", "01000", "11111", "01000", "00100"}, ZERO}, // seta_esquerda
+  {ZERO, {"00100", "00010", "11111", "00010", "00100"}, ZERO}, // seta_direita
+  {ZERO, {"00000", "01110", "01010", "01110", "00000"}, ZERO}, // meio
+};
+
+static void test_frames(void) {
+  // Cada quadro duas vezes, em ordens diferentes, para um quadro não depender do anterior
+  for (uint n = 0; n < 2 * 10; ++n) {
+    uint f = n < 10 ? n : 19 - n;
+    old_draw(old_frames[f][0], old_frames[f][1], old_frames[f][2]);
+    npShowFrame(f);
+    old_write();
+    sleep_us(500);
+    check_same_wire();
+  }
+}
+
+int main(void) {
+  npInit(MATRIX_PIN);
+  old_init();
+  CHECK(old_sm != sm);
+
+  test_random_frames();
+  test_back_to_back();
+  test_frames();
+  return 0;
+}
@@ -0,0 +1,88 @@
+#include "hal/sim.h"
+#include "hardware/adc.h"
+#include "inc/sampler.h"
+#include "tests/check.h"
+
+// Amostragem contínua do ADC em round-robin para o anel de DMA: cada entrada lê as próprias
+// conversões, as médias batem com os níveis e o ruído diminui com o número de amostras
+
+#define RATE_HZ 8000
+
+// Variância (x16, para não perder a parte fracionária) de uma série de leituras
+static uint32_t variance16(const uint16_t *v, uint n) {
+  int64_t sum = 0, sum_sq = 0;
+  for (uint i = 0; i < n; ++i) {
+    sum += v[i];
+    sum_sq += (int64_t)v[i] * v[i];
+  }
+  return (uint32_t)((16 * (sum_sq * n - sum * sum)) / ((int64_t)n * n));
+}
+
+static void test_round_robin(void) {
+  // Três entradas com níveis diferentes: nenhuma amostra pode ir para a entrada errada
+  sim_adc_set(0, 1000);
+  sim_adc_set(1, 3000);
+  sim_adc_set(4, 876);
+  CHECK(sampler_init(0x13, RATE_HZ));
+  CHECK_EQ(sampler_depth(), SAMPLER_RING_LEN / 3 - 1);
+  for (uint step = 0; step < 2000; ++step) {
+    sleep_us(37 + step % 101); // Leituras em fases diferentes da varredura e várias voltas do anel
+    CHECK_EQ(sampler_latest(0), 1000);
+    CHECK_EQ(sampler_latest(1), 3000);
+    CHECK_EQ(sampler_latest(4), 876);
+    CHECK_EQ(sampler_mean(1, 255), 3000);
+  }
+
+  // Duas entradas, como no firmware
+  CHECK(sampler_init(0x03, RATE_HZ));
+  CHECK_EQ(sampler_depth(), SAMPLER_RING_LEN / 2 - 1);
+  CHECK_EQ(sampler_sum(0, 16), 16 * 1000);
+  CHECK_EQ(sampler_sum(1, 16), 16 * 3000);
+
+  // Entradas ou taxas inválidas
+  CHECK(!sampler_init(0, RATE_HZ));
+  CHECK(!sampler_init(0x03, 0));
+  CHECK(!sampler_init(0x03, 48000000 / 95));
+}
+
+static void test_step_latency(void) {
+  // Depois de um degrau, a média de n amostras só mostra o valor novo quando as n forem novas:
+  // no máximo n varreduras de 2 entradas a 8 kHz (250 us cada)
+  CHECK(sampler_init(0x03, RATE_HZ));
+  sleep_ms(5);
+  sim_adc_set(0, 2000);
+  uint64_t start = sim_now_ns();
+  while (sampler_mean(0, 16) != 2000)
+    sleep_us(10);
+  CHECK_RANGE(sim_now_ns() - start, 15 * 250000, 17 * 250000);
+  CHECK_EQ(sampler_latest(1), 3000);
+}
+
+static void test_noise(void) {
+  // Ruído uniforme de ±60 códigos: a média de 16 amostras tem variância ~16 vezes menor
+  static uint16_t latest[1000], mean[1000];
+
+  sim_adc_set(0, 2048);
+  sim_adc_noise(0, 60);
+  CHECK(sampler_init(0x03, RATE_HZ));
+  for (uint i = 0; i < 1000; ++i) {
+    sleep_ms(5);
+    latest[i] = sampler_latest(0);
+    mean[i] = sampler_mean(0, 16);
+    CHECK_RANGE(latest[i], 2048 - 60, 2048 + 60);
+    CHECK_EQ(sampler_latest(1), 3000); // O ruído de uma entrada não passa para a outra
+  }
+  uint32_t raw = variance16(latest, 1000), averaged = variance16(mean, 1000);
+  printf("variância: amostra %.1f, média de 16 %.1f\n", raw / 16.0, averaged / 16.0);
+  CHECK_RANGE(raw / 16, 1000, 1400);  // (2 * 60 + 1)^2 / 12 = 1220
+  CHECK(averaged * 10 < raw);
+  sim_adc_noise(0, 0);
+}
+
+int main(void) {
+  adc_init();
+  test_round_robin();
+  test_step_latency();
+  test_noise();
+  return 0;
+}
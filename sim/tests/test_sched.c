@@ -0,0 +1,174 @@
+#include <string.h>
+#include "hal/sim.h"
+#include "inc/sched.h"
+#include "tests/check.h"
+
+// Escalonador cooperativo: ordem de prioridade, fase das tarefas, períodos perdidos e estouro de
+// orçamento com um relógio falso, e a cadência do laço principal com o alarme do relógio simulado
+
+static uint64_t fake_us;
+static char order[64];
+static uint order_len;
+
+static uint64_t fake_now(void) {
+  return fake_us;
+}
+
+// Cada tarefa anota a própria letra e gasta o tempo do argumento
+typedef struct {
+  char letter;
+  uint32_t cost_us;
+} work_t;
+
+static void run_fake(void *arg) {
+  work_t *w = arg;
+  if (order_len < sizeof(order) - 1)
+    order[order_len++] = w->letter;
+  fake_us += w->cost_us;
+}
+
+static void check_order(const char *expected) {
+  order[order_len] = '\0';
+  if (strcmp(order, expected)) {
+    fprintf(stderr, "ordem \"%s\" != \"%s\"\n", order, expected);
+    exit(1);
+  }
+  order_len = 0;
+}
+
+static void test_dispatch(void) {
+  static work_t a = {'a', 100}, b = {'b', 300}, c = {'c', 0};
+  sched_task_t tasks[] = {
+    SCHED_TASK("a", 1000, 200, run_fake, &a),
+    SCHED_TASK("b", 2000, 200, run_fake, &b),
+    SCHED_TASK("c", 5000, 200, run_fake, &c),
+  };
+  sched_t s;
+
+  fake_us = 10000;
+  sched_init(&s, tasks, 3, fake_now);
+
+  // Todas vencem no início e rodam na ordem da tabela
+  CHECK_EQ(sched_dispatch(&s, fake_us), 3);
+  check_order("abc");
+
+  // Nada vence antes do período
+  CHECK_EQ(sched_dispatch(&s, 10999), 0);
+  CHECK_EQ(sched_dispatch(&s, 11000), 1);
+  CHECK_EQ(sched_dispatch(&s, 12000), 2);
+  CHECK_EQ(sched_dispatch(&s, 13000), 1);
+  CHECK_EQ(sched_dispatch(&s, 14000), 2);
+  CHECK_EQ(sched_dispatch(&s, 15000), 2);
+  check_order("aabaabac");
+
+  // A fase não depende do instante do dispatch: atrasado 700 us, o próximo continua no milhar
+  CHECK_EQ(sched_dispatch(&s, 16700), 2);
+  CHECK_EQ(sched_dispatch(&s, 16999), 0);
+  CHECK_EQ(sched_dispatch(&s, 17000), 1);
+  check_order("aba");
+  CHECK_EQ(tasks[0].missed, 0);
+
+  // Atraso de vários períodos: roda uma vez só, conta os perdidos e volta para a mesma fase
+  CHECK_EQ(sched_dispatch(&s, 20500), 3);
+  check_order("abc");
+  CHECK_EQ(tasks[0].missed, 2); // 18000 rodou em 20500; 19000 e 20000 perdidos
+  CHECK_EQ(tasks[0].next_us, 21000);
+  CHECK_EQ(tasks[1].missed, 1); // 18000 rodou em 20500; 20000 perdido
+  CHECK_EQ(tasks[1].next_us, 22000);
+  CHECK_EQ(tasks[2].next_us, 25000);
+
+  // Duração medida com o relógio da tarefa
+  CHECK_EQ(tasks[0].runs, 9);
+  CHECK_EQ(tasks[0].overruns, 0);
+  CHECK_EQ(tasks[0].max_us, 100);
+  CHECK_EQ(tasks[1].overruns, tasks[1].runs);
+  CHECK_EQ(tasks[1].max_us, 300);
+  CHECK_EQ(tasks[2].max_us, 0);
+
+  sched_reset_stats(&s);
+  for (uint i = 0; i < 3; ++i) {
+    CHECK_EQ(tasks[i].runs, 0);
+    CHECK_EQ(tasks[i].overruns, 0);
+    CHECK_EQ(tasks[i].missed, 0);
+    CHECK_EQ(tasks[i].max_us, 0);
+  }
+}
+
+// Tarefas do relógio simulado: guardam os intervalos entre execuções. A primeira execução é no
+// primeiro tick depois do sched_init, então o primeiro intervalo é mais curto e fica de fora
+typedef struct {
+  uint32_t calls;
+  uint64_t last_us;
+  uint32_t max_gap_us, min_gap_us;
+  uint32_t cost_us;
+} timed_t;
+
+static void run_timed(void *arg) {
+  timed_t *t = arg;
+  uint64_t now = time_us_64();
+
+  if (++t->calls > 2) {
+    uint32_t gap = (uint32_t)(now - t->last_us);
+    if (gap > t->max_gap_us)
+      t->max_gap_us = gap;
+    if (gap < t->min_gap_us)
+      t->min_gap_us = gap;
+  }
+  t->last_us = now;
+  busy_wait_us(t->cost_us);
+}
+
+static void test_loop(void) {
+  static timed_t fast = {0, 0, 0, UINT32_MAX, 50}, slow = {0, 0, 0, UINT32_MAX, 400};
+  static timed_t rare = {0, 0, 0, UINT32_MAX, 0};
+  sched_task_t tasks[] = {
+    SCHED_TASK("fast", 1000, 200, run_timed, &fast),
+    SCHED_TASK("slow", 10000, 500, run_timed, &slow),
+    SCHED_TASK("rare", 100000, 100, run_timed, &rare),
+  };
+  sched_t s;
+
+  uint64_t phase = time_us_64() % 1000;
+  sched_init(&s, tasks, 3, time_us_64);
+  CHECK(sched_start(&s, 1000));
+  // Primeiro tick: as tarefas venceram no sched_init e a rápida conta o período do próprio tick
+  sched_run(&s);
+  CHECK_EQ(tasks[0].missed, 1);
+  sched_reset_stats(&s);
+
+  // Um segundo de laço principal: o tempo só passa dormindo no __wfe e dentro das tarefas
+  uint64_t start = time_us_64();
+  while (time_us_64() - start < 1000000)
+    sched_run(&s);
+  CHECK_RANGE(tasks[0].runs, 999, 1001);
+  CHECK_RANGE(tasks[1].runs, 99, 101);
+  CHECK_RANGE(tasks[2].runs, 10, 11);
+
+  // Cadência exata: os ticks caem na fase das tarefas e os custos não acumulam atraso
+  CHECK_EQ(fast.min_gap_us, 1000);
+  CHECK_EQ(fast.max_gap_us, 1000);
+  CHECK_EQ(slow.min_gap_us, 10000);
+  CHECK_EQ(slow.max_gap_us, 10000);
+  CHECK_EQ(rare.min_gap_us, 100000);
+  CHECK_EQ(tasks[0].missed, 0);
+  CHECK_EQ(tasks[0].overruns, 0);
+  CHECK_EQ(tasks[1].max_us, 400);
+
+  // Uma tarefa que passa do tick: a rápida perde um período a cada vez mas não sai de fase
+  slow.cost_us = 2500;
+  sched_reset_stats(&s);
+  start = time_us_64();
+  while (time_us_64() - start < 100000)
+    sched_run(&s);
+  CHECK_EQ(tasks[1].overruns, tasks[1].runs);
+  CHECK_EQ(tasks[1].max_us, 2500);
+  CHECK_RANGE(tasks[0].missed, tasks[1].runs - 1, tasks[1].runs); // A última pode ser contada depois do laço
+  CHECK_EQ(tasks[0].next_us % 1000, phase);
+  cancel_repeating_timer(&s.timer);
+}
+
+int main(void) {
+  test_dispatch();
+  test_loop();
+  return 0;
+}
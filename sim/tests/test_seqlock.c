@@ -0,0 +1,74 @@
+#include <pthread.h>
+#include <sched.h>
+#include "inc/seqlock.h"
+#include "tests/check.h"
+
+// Seqlock com o escritor e o leitor em threads de verdade: o escritor publica sem parar um estado
+// em que todos os campos dependem da versão, e nenhuma cópia lida pode misturar duas versões. O
+// estado é bem maior que o do firmware para a cópia demorar e as threads se cruzarem no meio dela
+// mesmo com um processador só
+
+#define WRITES 100000
+#define VALUES 2048
+
+typedef struct {
+  uint32_t version;
+  int16_t values[VALUES];
+  uint32_t check;
+} state_t;
+
+static state_t shared;
+static seqlock_t lock = SEQLOCK_INIT;
+static volatile bool writer_done;
+
+static void make_state(state_t *s, uint32_t version) {
+  s->version = version;
+  for (uint i = 0; i < VALUES; ++i)
+    s->values[i] = (int16_t)(version * 31 + i);
+  s->check = ~version;
+}
+
+static void *writer(void *arg) {
+  state_t s;
+  (void)arg;
+  for (uint32_t version = 1; version <= WRITES; ++version) {
+    make_state(&s, version);
+    seqlock_write(&lock, &shared, &s, sizeof(s));
+  }
+  writer_done = true;
+  return NULL;
+}
+
+int main(void) {
+  pthread_t thread;
+  state_t s, expected;
+  uint32_t reads = 0, last_version = 0, last_seq = 0;
+
+  make_state(&s, 0);
+  seqlock_write(&lock, &shared, &s, sizeof(s));
+  CHECK(!pthread_create(&thread, NULL, writer, NULL));
+  for (;;) {
+    bool done = writer_done;
+    uint32_t seq = seqlock_read(&lock, &s, &shared, sizeof(s));
+
+    // Versão inteira, nunca para trás, e o contador retornado par e acompanhando a versão
+    make_state(&expected, s.version);
+    if (memcmp(&s, &expected, sizeof(s))) {
+      fprintf(stderr, "leitura rasgada na versão %u (leitura %u)\n", s.version, reads);
+      exit(1);
+    }
+    CHECK(s.version >= last_version);
+    CHECK_EQ(seq & 1, 0);
+    CHECK_EQ(seq, 2 * (s.version + 1));
+    CHECK(seq >= last_seq);
+    last_version = s.version;
+    last_seq = seq;
+    ++reads;
+    if (done)
+      break;
+  }
+  pthread_join(thread, NULL);
+  CHECK_EQ(last_version, WRITES);
+  printf("%u leituras durante %u escritas\n", reads, WRITES);
+  return 0;
+}
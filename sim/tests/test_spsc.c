@@ -0,0 +1,123 @@
+#include <pthread.h>
+#include <sched.h>
+#include "inc/spsc.h"
+#include "tests/check.h"
+
+// Fila sem travas com o produtor e o consumidor em threads de verdade (como os dois núcleos ou uma
+// interrupção e o laço principal): os elementos chegam em ordem, inteiros e sem perda quando o
+// produtor espera espaço, e as perdas contadas batem com os push recusados
+
+#define CAPACITY 8         // Pequena para a fila encher e dar a volta o tempo todo
+#define ELEMENTS 500000
+
+typedef struct {
+  uint32_t seq;
+  uint32_t data[6];        // Derivados de seq: uma cópia rasgada não bate
+} elem_t;
+
+static elem_t slots[CAPACITY];
+static spsc_t queue;
+static volatile bool producer_done;
+static uint32_t refused;
+
+static void fill(elem_t *e, uint32_t seq) {
+  e->seq = seq;
+  for (uint i = 0; i < 6; ++i)
+    e->data[i] = seq * 2654435761u + i;
+}
+
+static void check_elem(const elem_t *e) {
+  for (uint i = 0; i < 6; ++i) {
+    if (e->data[i] != e->seq * 2654435761u + i) {
+      fprintf(stderr, "elemento %u rasgado (palavra %u)\n", e->seq, i);
+      exit(1);
+    }
+  }
+}
+
+// Produtor que espera espaço: nenhum elemento pode se perder
+static void *produce_all(void *arg) {
+  elem_t e;
+  (void)arg;
+  for (uint32_t seq = 0; seq < ELEMENTS; ++seq) {
+    fill(&e, seq);
+    while (!spsc_push(&queue, &e)) {
+      ++refused;
+      sched_yield();
+    }
+  }
+  producer_done = true;
+  return NULL;
+}
+
+// Produtor que descarta com a fila cheia, como as interrupções do firmware
+static void *produce_lossy(void *arg) {
+  elem_t e;
+  (void)arg;
+  for (uint32_t seq = 0; seq < ELEMENTS; ++seq) {
+    fill(&e, seq);
+    if (!spsc_push(&queue, &e))
+      ++refused;
+  }
+  producer_done = true;
+  return NULL;
+}
+
+static void start(pthread_t *thread, void *(*producer)(void *)) {
+  spsc_init(&queue, slots, sizeof(elem_t), CAPACITY);
+  producer_done = false;
+  refused = 0;
+  CHECK(!pthread_create(thread, NULL, producer, NULL));
+}
+
+static void test_in_order(void) {
+  pthread_t thread;
+  elem_t e;
+  uint32_t expected = 0;
+
+  start(&thread, produce_all);
+  while (expected < ELEMENTS) {
+    if (!spsc_pop(&queue, &e)) {
+      sched_yield(); // Com um processador só o produtor precisa de vez
+      continue;
+    }
+    check_elem(&e);
+    CHECK_EQ(e.seq, expected);
+    ++expected;
+  }
+  pthread_join(thread, NULL);
+  CHECK(!spsc_pop(&queue, &e));
+  CHECK_EQ(queue.dropped, refused);
+  printf("em ordem: %u elementos, %u push recusados com a fila cheia\n", ELEMENTS, refused);
+}
+
+static void test_lossy(void) {
+  pthread_t thread;
+  elem_t e;
+  uint32_t received = 0, last = 0;
+
+  // Com perdas os elementos continuam em ordem crescente e inteiros; recebidos + descartados = todos
+  start(&thread, produce_lossy);
+  for (;;) {
+    bool done = producer_done;
+    if (spsc_pop(&queue, &e)) {
+      check_elem(&e);
+      CHECK(!received || e.seq > last);
+      last = e.seq;
+      ++received;
+    } else if (done) {
+      break;
+    } else {
+      sched_yield();
+    }
+  }
+  pthread_join(thread, NULL);
+  CHECK_EQ(received + queue.dropped, ELEMENTS);
+  CHECK_EQ(queue.dropped, refused);
+}
+
+int main(void) {
+  test_in_order();
+  test_lossy();
+  return 0;
+}
@@ -0,0 +1,145 @@
+#include <string.h>
+#include "hal/sim.h"
+#include "inc/ssd1306.h"
+#include "tests/check.h"
+
+// Envio do display pelo I2C simulado: bytes e transações de cada envio e conteúdo da GRAM
+
+#define FULL_FRAME_BYTES (2 + 6 + 2 + 128 * 8) // Endereço, controle e 6 comandos + endereço, controle e dados
+
+static ssd1306_t ssd;
+static uint64_t flush_transactions;
+
+// Envia as regiões alteradas e retorna os bytes que passaram pelo barramento
+static uint64_t flush(void) {
+  uint64_t bytes = sim_i2c_bytes(1), transactions = sim_i2c_transactions(1);
+  ssd1306_send_data(&ssd);
+  flush_transactions = sim_i2c_transactions(1) - transactions;
+  return sim_i2c_bytes(1) - bytes;
+}
+
+// Depois de um envio a GRAM do display tem que ser igual ao buffer
+static void check_gram(void) {
+  for (uint page = 0; page < 8; ++page)
+    for (uint x = 0; x < 128; ++x)
+      CHECK_EQ(sim_display_gram(page, x), ssd.ram_buffer[page * 128 + x + 1]);
+}
+
+static void test_partial_flush(void) {
+  // Primeiro envio: quadro completo
+  CHECK_EQ(flush(), FULL_FRAME_BYTES);
+  CHECK_EQ(flush_transactions, 2);
+  check_gram();
+
+  // Nada mudou: nada vai para o barramento
+  CHECK(!ssd1306_send_data_async(&ssd));
+  CHECK_EQ(flush(), 0);
+
+  // Um glifo alinhado a página: uma janela só com as 7 colunas desenhadas do 'A' (a oitava é o
+  // espaçamento, que já estava apagado)
+  ssd1306_draw_char(&ssd, 'A', 16, 24);
+  CHECK_EQ(flush(), 2 + 6 + 2 + 7);
+  CHECK_EQ(flush_transactions, 2);
+  check_gram();
+
+  // O mesmo glifo de novo não altera nenhum byte
+  ssd1306_draw_char(&ssd, 'A', 16, 24);
+  CHECK_EQ(flush(), 0);
+
+  // Glifo entre duas páginas: as faixas das duas páginas (6 e 2 colunas do '7') viram uma janela
+  // de 6 colunas por 2 páginas, mais barata que duas janelas
+  ssd1306_draw_char(&ssd, '7', 40, 36);
+  CHECK_EQ(flush(), 2 + 6 + 2 + 6 * 2);
+  CHECK_EQ(flush_transactions, 2);
+  check_gram();
+
+  // Um pixel em cantos opostos: duas janelas de uma coluna
+  ssd1306_pixel(&ssd, 0, 0, true);
+  ssd1306_pixel(&ssd, 127, 63, true);
+  CHECK_EQ(flush(), 2 * (2 + 6 + 2 + 1));
+  CHECK_EQ(flush_transactions, 4);
+  check_gram();
+}
+
+static void test_full_frame_fallback(void) {
+  // Faixas deslocadas em páginas alternadas não se juntam (a união custa mais que as duas), mas as 8
+  // janelas somadas (8 x 130 bytes) custam mais que o quadro inteiro: vai o quadro completo
+  for (uint8_t page = 0; page < 8; ++page) {
+    if (page & 1)
+      ssd1306_hline(&ssd, 8, 127, page * 8 + 3, true);
+    else
+      ssd1306_hline(&ssd, 0, 119, page * 8 + 3, true);
+  }
+  CHECK_EQ(flush(), FULL_FRAME_BYTES);
+  CHECK_EQ(flush_transactions, 2);
+  check_gram();
+
+  // Uma faixa a menos já fica mais barata em janelas
+  for (uint8_t page = 0; page < 7; ++page)
+    ssd1306_hline(&ssd, page & 1 ? 8 : 0, page & 1 ? 127 : 119, page * 8 + 5, true);
+  CHECK_EQ(flush(), 7 * (2 + 6 + 2 + 120));
+  CHECK_EQ(flush_transactions, 14);
+  check_gram();
+
+  ssd1306_invalidate(&ssd);
+  CHECK_EQ(flush(), FULL_FRAME_BYTES);
+  check_gram();
+}
+
+static void test_abort_resends(void) {
+  // O alvo para de confirmar no meio da segunda janela: o resto do envio se perde
+  ssd1306_draw_string(&ssd, "AB", 0, 0);
+  ssd1306_draw_string(&ssd, "CD", 64, 56);
+  sim_i2c_nack(1, 2 + 6 + 2 + 16 + 4);
+  ssd1306_send_data(&ssd);
+  CHECK(!ssd1306_busy(&ssd));
+  CHECK(sim_display_gram(7, 64) != ssd.ram_buffer[7 * 128 + 64 + 1]);
+
+  // O envio seguinte manda o quadro completo e o display volta a ficar igual ao buffer
+  CHECK_EQ(flush(), FULL_FRAME_BYTES);
+  check_gram();
+  CHECK_EQ(flush(), 0);
+}
+
+static void test_batched_commands(void) {
+  // A inicialização inteira é uma transação: endereço, controle 0x00 e os 25 comandos/argumentos
+  uint64_t bytes = sim_i2c_bytes(1), transactions = sim_i2c_transactions(1);
+  uint32_t commands = sim_display_command_bytes();
+  ssd1306_config(&ssd);
+  CHECK_EQ(sim_i2c_transactions(1) - transactions, 1);
+  CHECK_EQ(sim_i2c_bytes(1) - bytes, 2 + 25);
+  CHECK_EQ(sim_display_command_bytes() - commands, 25);
+  CHECK(sim_display_on());
+
+  // Um lote maior que SSD1306_BATCH_MAX é dividido em transações cheias
+  transactions = sim_i2c_transactions(1);
+  ssd1306_batch_begin(&ssd);
+  for (uint i = 0; i < SSD1306_BATCH_MAX + 1; ++i)
+    ssd1306_batch_add(&ssd, SET_NORM_INV);
+  ssd1306_batch_send(&ssd);
+  CHECK_EQ(sim_i2c_transactions(1) - transactions, 2);
+
+  // Lote vazio não vai para o barramento
+  transactions = sim_i2c_transactions(1);
+  ssd1306_batch_begin(&ssd);
+  ssd1306_batch_send(&ssd);
+  CHECK_EQ(sim_i2c_transactions(1), transactions);
+
+  // Os 6 comandos de cada janela vão juntos: 2 transações por janela, não 7
+  commands = sim_display_command_bytes();
+  CHECK_EQ(flush(), FULL_FRAME_BYTES);
+  CHECK_EQ(flush_transactions, 2);
+  CHECK_EQ(sim_display_command_bytes() - commands, 6);
+  ssd1306_invalidate(&ssd);
+}
+
+int main(void) {
+  i2c_init(i2c1, 400 * 1000);
+  ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, i2c1);
+
+  test_batched_commands();
+  test_partial_flush();
+  test_full_frame_fallback();
+  test_abort_resends();
+  return 0;
+}
@@ -0,0 +1,89 @@
+#include <string.h>
+#include "inc/telemetry.h"
+#include "tests/check.h"
+
+// Fluxo de telemetria com os campos do esquema 1 do firmware por um canal que aceita poucos bytes
+// por flush (escritas parciais) e que para de ler no meio: o anel entrega os bytes em ordem, os
+// quadros que não couberam consomem o número de sequência e o seguinte é completo. O fluxo gravado
+// em test_telemetry.bin é corrompido e decodificado pelo tools/telemetry_parse.py no teste
+// telemetry_parse (sim/tests/test_telemetry_parse.py), com os mesmos valores por período
+
+#define FIELDS 12
+#define PERIOD_MS 100
+#define KEYFRAME_EVERY 10
+#define PERIODS 200
+
+static const char *path = "test_telemetry.bin";
+
+static uint8_t capture[16384];
+static uint32_t captured;
+static uint32_t room; // Bytes que o canal ainda aceita neste flush
+
+static uint32_t channel_write(const uint8_t *data, uint32_t len) {
+  if (len > room)
+    len = room;
+  CHECK(captured + len <= sizeof(capture));
+  memcpy(&capture[captured], data, len);
+  captured += len;
+  room -= len;
+  return len;
+}
+
+static const telemetry_config_t config = {1, FIELDS, PERIOD_MS, KEYFRAME_EVERY, channel_write};
+
+// Campo i no período k: muda a cada i + 1 períodos, com sinal alternado (o mesmo no teste em Python)
+static void values_at(uint32_t k, int16_t *values) {
+  for (uint i = 0; i < FIELDS; ++i)
+    values[i] = (int16_t)(k / (i + 1)) * (i % 2 ? -1 : 1);
+}
+
+// Um quadro por período (o campo 0 sempre muda), com budget bytes aceitos em cada flush
+static void run(telemetry_t *t, uint32_t from, uint32_t to, uint32_t budget) {
+  int16_t values[FIELDS];
+
+  for (uint32_t k = from; k < to; ++k) {
+    values_at(k, values);
+    telemetry_sample(t, values, k * PERIOD_MS);
+    room = budget;
+    telemetry_flush(t);
+    CHECK_EQ(captured, t->tail);
+    CHECK(t->head - t->tail <= TELEMETRY_RING_LEN);
+  }
+}
+
+int main(void) {
+  static telemetry_t t;
+  FILE *f;
+
+  // CRC-16/CCITT-FALSE, o mesmo do crc16 do parser
+  CHECK_EQ(telemetry_crc((const uint8_t *)"123456789", 9), 0x29B1);
+
+  telemetry_init(&t, &config, 0);
+
+  // Canal mais lento que um quadro completo (38 bytes), mais rápido que a média: os quadros saem
+  // aos pedaços e nenhum é perdido
+  run(&t, 0, 100, 24);
+  CHECK_EQ(t.frames, 100);
+  CHECK_EQ(t.dropped, 0);
+
+  // O computador para de ler: o anel enche e os quadros seguintes são descartados
+  run(&t, 100, 150, 0);
+  CHECK(t.dropped > 0);
+  CHECK(t.keyframe);
+  CHECK_EQ(t.frames + t.dropped, 150);
+
+  // Voltou: o anel esvazia em ordem e o primeiro quadro depois da perda é completo
+  run(&t, 150, PERIODS, 64);
+  room = sizeof(capture);
+  telemetry_flush(&t);
+  CHECK_EQ(t.head, t.tail);
+  CHECK_EQ(captured, t.head);
+  CHECK_EQ(t.frames + t.dropped, PERIODS);
+  printf("%u quadros, %u descartados, %u bytes\n", t.frames, t.dropped, captured);
+
+  f = fopen(path, "wb");
+  CHECK(f);
+  CHECK_EQ(fwrite(capture, 1, captured, f), captured);
+  fclose(f);
+  return 0;
+}
@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+# Decodificação do fluxo gravado pelo test_telemetry com o tools/telemetry_parse.py: o fluxo inteiro,
+# byte a byte e com bytes trocados, removidos ou inseridos. Confere os quadros, as perdas contadas
+# pelo número de sequência, os descartes pelo CRC e que o estado só volta em um quadro completo.
+# Uso: test_telemetry_parse.py test_telemetry.bin
+
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "tools"))
+from telemetry_parse import HEADER_LEN, SCHEMAS, Parser, crc16  # noqa: E402
+
+FIELDS = SCHEMAS[1]
+PERIOD_MS = 100  # Os mesmos do test_telemetry.c
+PERIODS = 200
+
+
+def check(cond, message):
+    if not cond:
+        sys.exit(f"falhou: {message}")
+
+
+def check_eq(a, b, message):
+    check(a == b, f"{message} ({a} != {b})")
+
+
+def expected(k):
+    """Estado no período k (values_at do test_telemetry.c)."""
+    return {name: (k // (i + 1)) * (-1 if i % 2 else 1) for i, name in enumerate(FIELDS)}
+
+
+def parse(data, step=None):
+    parser = Parser()
+    step = step or len(data) or 1
+    records = []
+    for i in range(0, len(data), step):
+        records += parser.feed(data[i:i + step])
+    return parser, records
+
+
+def frames_in(data):
+    """Início e fim de cada quadro do fluxo sem corrupção (só quadros, um depois do outro)."""
+    frames, pos = [], 0
+    while pos < len(data):
+        check(data[pos:pos + 2] == b"\xa5M", f"quadro em {pos}")
+        end = pos + HEADER_LEN + data[pos + 4] + 2
+        frames.append((pos, end))
+        pos = end
+    return frames
+
+
+def check_records(records):
+    for r in records:
+        check_eq(r["time_ms"] % PERIOD_MS, 0, "instante do quadro")
+        check_eq(r["state"], expected(r["time_ms"] // PERIOD_MS), f"estado do quadro #{r['seq']}")
+
+
+def test_clean(data):
+    parser, records = parse(data)
+    # Os quadros descartados pelo firmware com o anel cheio aparecem como perdas, e o quadro seguinte
+    # é completo: todo quadro recebido é mostrado
+    check(parser.lost > 0, "perdas no fluxo")
+    check_eq(parser.frames + parser.lost, PERIODS, "quadros + perdidos")
+    check_eq(parser.crc_errors, 0, "descartes pelo CRC")
+    check_eq(len(records), parser.frames, "quadros mostrados")
+    check(records[0]["keyframe"], "primeiro quadro completo")
+    for prev, r in zip(records, records[1:]):
+        if r["seq"] != (prev["seq"] + 1) & 0xFF:
+            check(r["keyframe"], f"quadro #{r['seq']} depois da perda completo")
+    check_records(records)
+
+    # Entregue aos poucos (como a leitura da porta serial) dá o mesmo resultado
+    for step in (1, 7, 64):
+        p, r = parse(data, step)
+        check_eq((p.frames, p.lost, p.crc_errors), (parser.frames, parser.lost, parser.crc_errors),
+                 f"contagens com blocos de {step} bytes")
+        check_eq(r, records, f"quadros com blocos de {step} bytes")
+    return parser, records
+
+
+def check_resync(name, data, clean, clean_records, index, lost, crc_errors):
+    """O quadro index se perdeu: o estado só volta no próximo quadro completo e segue igual ao limpo."""
+    parser, records = parse(data)
+    check_eq(parser.lost, clean.lost + lost, f"{name}: perdidos")
+    check_eq(parser.crc_errors, crc_errors, f"{name}: descartes pelo CRC")
+    check_eq(parser.frames, clean.frames - lost, f"{name}: quadros")
+    check_records(records)
+
+    lost_seq = clean_records[index]["seq"]
+    resync = next(r for r in clean_records[index + 1:] if r["keyframe"])
+    expected_records = [r for r in clean_records
+                        if r["seq"] < lost_seq or r["seq"] >= resync["seq"]]
+    check_eq([r["seq"] for r in records], [r["seq"] for r in expected_records], f"{name}: quadros mostrados")
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit("uso: test_telemetry_parse.py test_telemetry.bin")
+    with open(sys.argv[1], "rb") as f:
+        data = f.read()
+
+    check_eq(crc16(b"123456789"), 0x29B1, "CRC-16/CCITT")
+    clean, clean_records = test_clean(data)
+    frames = frames_in(data)
+    check_eq(len(frames), clean.frames, "quadros no fluxo")
+
+    # Quadro de diferença no meio de um intervalo entre quadros completos
+    index = 23
+    check(not clean_records[index]["keyframe"], "quadro escolhido é de diferença")
+    start, end = frames[index]
+
+    # Um bit trocado em um valor: o CRC descarta o quadro e a próxima sequência acusa a perda
+    flipped = bytearray(data)
+    flipped[end - 3] ^= 0x10
+    check_resync("bit trocado", bytes(flipped), clean, clean_records, index, 1, 1)
+
+    # Bytes removidos do meio: o quadro engole o começo do seguinte, o CRC falha e a busca pelo magic
+    # recomeça do byte seguinte, achando o próximo quadro inteiro
+    check_resync("bytes removidos", data[:start + 8] + data[start + 11:], clean, clean_records, index, 1, 1)
+
+    # Magic cortado: o quadro inteiro é pulado como lixo, sem erro de CRC
+    check_resync("magic cortado", data[:start] + data[start + 1:], clean, clean_records, index, 1, 0)
+
+    # Quadro completo perdido: as diferenças seguintes não mostram nada até o próximo completo
+    keyframe = next(i for i, r in enumerate(clean_records) if r["keyframe"] and i > index)
+    start, end = frames[keyframe]
+    check_resync("quadro completo removido", data[:start] + data[end:], clean, clean_records, keyframe, 1, 0)
+
+    # Texto e um magic falso entre dois quadros (outro fluxo na mesma porta): um descarte pelo CRC,
+    # nenhuma perda e os mesmos quadros
+    start, end = frames[index]
+    noise = b"texto\r\n\xa5M\x01\x07\x09lixo\xa5"
+    parser, records = parse(data[:end] + noise + data[end:])
+    check_eq((parser.frames, parser.lost, parser.crc_errors), (clean.frames, clean.lost, 1), "lixo entre quadros")
+    check_eq(records, clean_records, "quadros com lixo entre eles")
+
+    print(f"{clean.frames} quadros, {clean.lost} perdidos no fluxo limpo")
+
+
+if __name__ == "__main__":
+    main()
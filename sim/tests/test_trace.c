@@ -0,0 +1,115 @@
+#include <string.h>
+#include "hal/sim.h"
+#include "inc/telemetry.h"
+#include "inc/trace.h"
+#include "tests/check.h"
+
+// Registro de eventos saindo pela FIFO da USB CDC simulada: o trace_drain não espera o computador,
+// só retira do anel os registros que cabem na FIFO e os que sobram saem depois, em ordem. Os blocos
+// gravados no arquivo da USB são lidos de volta como o tools/trace_decode.py faz, e o arquivo é
+// misturado com a telemetria e corrompido no teste trace_decode (sim/tests/test_trace_decode.py)
+
+#define EVENTS 100
+
+static const char *path = "test_trace.bin";
+
+// Lê os blocos do arquivo: retorna quantos eventos TRACE_SCALED chegaram, conferindo que os
+// valores só crescem, e soma os avisos de perda
+static uint32_t decode(uint32_t *dropped) {
+  static uint8_t data[16384];
+  FILE *f = fopen(path, "rb");
+  size_t len, pos = 0;
+  uint32_t received = 0;
+  int32_t last = -1;
+
+  CHECK(f);
+  len = fread(data, 1, sizeof(data), f);
+  fclose(f);
+  *dropped = 0;
+  while (pos < len) {
+    CHECK(pos + TRACE_HEADER_LEN <= len);
+    CHECK_EQ(data[pos], TRACE_MAGIC0);
+    CHECK_EQ(data[pos + 1], TRACE_MAGIC1);
+    uint8_t count = data[pos + 2];
+    CHECK(count > 0 && count <= TRACE_CHUNK_RECORDS);
+    size_t end = pos + TRACE_HEADER_LEN + count * 6u;
+    CHECK(end + TRACE_CRC_LEN <= len);
+    CHECK_EQ(telemetry_crc(&data[pos + 1], end - pos - 1), data[end] | data[end + 1] << 8);
+    pos += TRACE_HEADER_LEN;
+    for (uint8_t i = 0; i < count; ++i, pos += 6) {
+      uint8_t event = data[pos + 2];
+      int16_t value = (int16_t)(data[pos + 4] | data[pos + 5] << 8);
+      if (event == TRACE_DROPPED) {
+        *dropped += value;
+        continue;
+      }
+      if (event == TRACE_TIME)
+        continue;
+      CHECK_EQ(event, TRACE_SCALED);
+      CHECK(value > last);
+      last = value;
+      ++received;
+    }
+    pos += TRACE_CRC_LEN;
+  }
+  return received;
+}
+
+// Drena como a tarefa do firmware, a cada 10 ms, até o anel esvaziar
+static void drain_all(void) {
+  uint64_t bytes;
+  do {
+    bytes = sim_usb_bytes();
+    sleep_ms(10);
+    trace_drain();
+  } while (sim_usb_bytes() != bytes);
+}
+
+static void test_backpressure(void) {
+  uint32_t dropped;
+
+  // O computador parou de ler: cabem 2 blocos cheios e um parcial na FIFO de 256 bytes
+  sim_usb_set_rate(0);
+  for (uint i = 0; i < EVENTS; ++i)
+    trace_emit(TRACE_SCALED, 0, (int16_t)i);
+  for (uint i = 0; i < 10; ++i) {
+    uint64_t t = time_us_64();
+    trace_drain();
+    CHECK_EQ(time_us_64(), t); // Não espera a FIFO
+  }
+  CHECK_EQ(sim_usb_bytes(), 2 * (TRACE_HEADER_LEN + 16 * 6 + TRACE_CRC_LEN) + TRACE_HEADER_LEN + 6 * 6 + TRACE_CRC_LEN);
+  CHECK(sim_usb_fifo() <= 256);
+
+  // Voltou a ler: o resto sai em ordem, sem perda
+  sim_usb_set_rate(64);
+  drain_all();
+  CHECK_EQ(decode(&dropped), EVENTS);
+  CHECK_EQ(dropped, 0);
+}
+
+static void test_ring_full(void) {
+  uint32_t dropped;
+
+  // Parado por mais tempo que o anel aguenta: os que não couberam são contados em um TRACE_DROPPED,
+  // gravado junto com o próximo evento
+  sim_usb_set_rate(0);
+  for (uint i = 0; i < TRACE_RING_LEN + 50; ++i)
+    trace_emit(TRACE_SCALED, 0, (int16_t)(EVENTS + i));
+  sim_usb_set_rate(64);
+  drain_all();
+  trace_emit(TRACE_SCALED, 0, (int16_t)(EVENTS + TRACE_RING_LEN + 50));
+  drain_all();
+  uint32_t received = decode(&dropped);
+  CHECK(dropped >= 50);
+  CHECK_EQ(received + dropped, EVENTS + TRACE_RING_LEN + 51);
+}
+
+int main(void) {
+  CHECK(sim_usb_open(path));
+  trace_init();
+
+  test_backpressure();
+  test_ring_full();
+  sim_usb_report(stdout);
+  return 0;
+}
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+# Decodificação do registro de eventos gravado pelo test_trace com o tools/trace_decode.py, sozinho e
+# misturado com a telemetria do test_telemetry na mesma porta (como a USB do firmware). Cada
+# decodificador pula os bytes do outro fluxo, e um bloco corrompido é descartado pelo CRC sem levar
+# junto os blocos e quadros vizinhos.
+# Uso: test_trace_decode.py test_trace.bin test_telemetry.bin
+
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "tools"))
+from telemetry_parse import HEADER_LEN, Parser  # noqa: E402
+from trace_decode import CRC, HEADER, RECORD, Decoder  # noqa: E402
+
+
+def check(cond, message):
+    if not cond:
+        sys.exit(f"falhou: {message}")
+
+
+def check_eq(a, b, message):
+    check(a == b, f"{message} ({a} != {b})")
+
+
+def split(data, magic, length):
+    """Partes de um fluxo sem corrupção (só blocos ou só quadros, um depois do outro)."""
+    parts, pos = [], 0
+    while pos < len(data):
+        check(data[pos:pos + 2] == magic, f"{magic} em {pos}")
+        end = pos + length(data, pos)
+        parts.append(data[pos:end])
+        pos = end
+    return parts
+
+
+def chunk_len(data, pos):
+    return HEADER.size + data[pos + 2] * RECORD.size + CRC.size
+
+
+def frame_len(data, pos):
+    return HEADER_LEN + data[pos + 4] + 2
+
+
+def decode(data, step=None):
+    decoder = Decoder()
+    step = step or len(data) or 1
+    events = []
+    for i in range(0, len(data), step):
+        events += decoder.feed(data[i:i + step])
+    return decoder, events
+
+
+def parse(data):
+    parser = Parser()
+    return parser, parser.feed(data)
+
+
+def mix(chunks, frames, noise=b""):
+    """Um bloco, um quadro e o ruído, alternados, e o que sobrar de um dos fluxos no fim."""
+    out = []
+    for i in range(max(len(chunks), len(frames))):
+        out += chunks[i:i + 1] + frames[i:i + 1] + [noise]
+    return b"".join(out)
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("uso: test_trace_decode.py test_trace.bin test_telemetry.bin")
+    with open(sys.argv[1], "rb") as f:
+        trace = f.read()
+    with open(sys.argv[2], "rb") as f:
+        telemetry = f.read()
+
+    chunks = split(trace, b"\xa5T", chunk_len)
+    frames = split(telemetry, b"\xa5M", frame_len)
+    per_chunk = [decode(c)[1] for c in chunks]
+
+    # Sozinho: todos os blocos, nenhum descarte, e o mesmo resultado entregue aos poucos
+    clean, events = decode(trace)
+    check_eq((clean.chunks, clean.crc_errors), (len(chunks), 0), "blocos no fluxo limpo")
+    check_eq(events, [e for c in per_chunk for e in c], "eventos do fluxo limpo")
+    for step in (1, 7, 64):
+        check_eq(decode(trace, step)[1], events, f"eventos com blocos de {step} bytes")
+    telemetry_clean, records = parse(telemetry)
+
+    # Misturado com a telemetria e com texto: cada um acha só os seus
+    for noise in (b"", b"texto\r\n\xa5T\x02lixo\xa5"):
+        mixed = mix(chunks, frames, noise)
+        for step in (1, 64, None):
+            decoder, mixed_events = decode(mixed, step)
+            check_eq(mixed_events, events, f"eventos misturados (ruído {len(noise)}, blocos de {step})")
+            check_eq(decoder.chunks, len(chunks), "blocos misturados")
+        parser, mixed_records = parse(mixed)
+        check_eq(mixed_records, records, f"quadros misturados (ruído {len(noise)})")
+        check_eq((parser.frames, parser.lost), (telemetry_clean.frames, telemetry_clean.lost),
+                 "quadros e perdas misturados")
+
+    # Um bit trocado em um registro ou bytes removidos do meio do bloco: o CRC descarta só esse bloco
+    index = len(chunks) // 2
+    damaged = [bytearray(c) for c in chunks]
+    damaged[index][HEADER.size + 2] ^= 0x10
+    cut = list(chunks)
+    cut[index] = cut[index][:HEADER.size + 3] + cut[index][HEADER.size + 9:]
+    for name, parts in (("bit trocado", [bytes(c) for c in damaged]), ("bytes removidos", cut)):
+        mixed = mix(parts, frames)
+        decoder, mixed_events = decode(mixed)
+        expected = [e for i, c in enumerate(per_chunk) if i != index for e in c]
+        check_eq(mixed_events, expected, f"{name}: eventos")
+        check_eq(decoder.chunks, len(chunks) - 1, f"{name}: blocos")
+        check(decoder.crc_errors >= 1, f"{name}: descarte pelo CRC")
+        check_eq(parse(mixed)[1], records, f"{name}: quadros")
+
+    print(f"{len(chunks)} blocos, {len(events)} eventos, {len(frames)} quadros de telemetria")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,104 @@
+#include <string.h>
+#include "hal/sim.h"
+#include "inc/ui.h"
+#include "inc/fmt.h"
+#include "sprites.h"
+#include "tests/check.h"
+
+// Campos da tela com detecção de mudança: depois de cada atualização o buffer tem que ser igual ao
+// de redesenhar a tela inteira, e só os caracteres que mudaram vão para o display
+
+static ssd1306_t ssd, full;
+static uint32_t seed = 7;
+
+static uint32_t next_random(void) {
+  seed = seed * 1103515245u + 12345u;
+  return seed >> 8;
+}
+
+// Bytes no barramento para enviar o que mudou desde o último envio
+static uint64_t flush(void) {
+  uint64_t bytes = sim_i2c_bytes(1);
+  ssd1306_send_data(&ssd);
+  return sim_i2c_bytes(1) - bytes;
+}
+
+#define check_same() CHECK(!memcmp(&ssd.ram_buffer[1], &full.ram_buffer[1], WIDTH * HEIGHT / 8))
+
+// Tela de referência redesenhada do zero
+static void redraw_full(const char *number, const char *label, const sprite_t *icon) {
+  ssd1306_fill(&full, false);
+  ssd1306_draw_string(&full, number, 6, 7);
+  ssd1306_draw_string(&full, label, 6, 37);
+  if (icon)
+    sprite_draw(&full, icon, 84, 6);
+}
+
+int main(void) {
+  static const char *const labels[] = {"Vent: Desl", "Vent: Baixo", "Vent: Medio", "Vent: Alto", "Umid: Liga", ""};
+  static const sprite_t *const faces[] = {&face_happy, &face_neutral, &face_sad};
+  ui_number_t number = UI_NUMBER(6, 7, "T:", 3, "C*");
+  ui_label_t label = UI_LABEL(6, 37);
+  ui_icon_t icon = UI_ICON(84, 6);
+
+  i2c_init(i2c1, 400 * 1000);
+  ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, i2c1);
+  ssd1306_init(&full, WIDTH, HEIGHT, false, 0x3C, i2c1);
+  ssd1306_send_data(&ssd);
+
+  // Primeiro desenho
+  CHECK(ui_number_set(&ssd, &number, 25));
+  CHECK(ui_label_set(&ssd, &label, "Vent: Desl"));
+  CHECK(ui_icon_set(&ssd, &icon, &face_happy));
+  redraw_full("T: 25C*", "Vent: Desl", &face_happy);
+  check_same();
+  flush();
+
+  // Os mesmos valores não desenham nada nem enviam nada
+  CHECK(!ui_number_set(&ssd, &number, 25));
+  CHECK(!ui_label_set(&ssd, &label, "Vent: Desl"));
+  CHECK(!ui_icon_set(&ssd, &icon, &face_happy));
+  CHECK_EQ(flush(), 0);
+
+  // 25 -> 26: só o último dígito vai para o display (y = 7 cruza duas páginas: uma janela de até 8
+  // colunas por 2 páginas)
+  CHECK(ui_number_set(&ssd, &number, 26));
+  CHECK_RANGE(flush(), 2 + 6 + 2 + 1, 2 + 6 + 2 + 8 * 2);
+
+  // Texto mais curto apaga o que sobrou do anterior
+  CHECK(ui_label_set(&ssd, &label, "Vent: Baixo"));
+  CHECK(ui_label_set(&ssd, &label, "Umid"));
+  redraw_full("T: 26C*", "Umid", &face_happy);
+  check_same();
+
+  // Sem número: só o prefixo fica
+  CHECK(ui_number_clear(&ssd, &number));
+  redraw_full("T:", "Umid", &face_happy);
+  check_same();
+
+  // Sequência aleatória de valores, textos e rostinhos contra o redesenho completo
+  for (uint i = 0; i < 5000; ++i) {
+    int value = (int)(next_random() % 81) - 20; // -20..60: um, dois e três caracteres
+    const char *text = labels[next_random() % 6];
+    const sprite_t *face = faces[next_random() % 3];
+    char expected[UI_TEXT_MAX + 1];
+
+    ui_number_set(&ssd, &number, value);
+    ui_label_set(&ssd, &label, text);
+    ui_icon_set(&ssd, &icon, face);
+    char *end = fmt_int(fmt_str(expected, "T:"), value, 3);
+    *fmt_str(end, "C*") = '\0';
+    redraw_full(expected, text, face);
+    check_same();
+    if (i % 50 == 0)
+      flush();
+  }
+
+  // Invalidar força redesenhar mesmo sem mudança
+  ui_number_invalidate(&number);
+  ui_label_invalidate(&label);
+  ui_icon_invalidate(&icon);
+  CHECK(ui_number_set(&ssd, &number, number.value));
+  CHECK(ui_icon_set(&ssd, &icon, icon.sprite ? icon.sprite : &face_sad));
+  return 0;
+}
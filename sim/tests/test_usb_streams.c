@@ -0,0 +1,116 @@
+#include <string.h>
+#include "hal/sim.h"
+#include "inc/telemetry.h"
+#include "inc/trace.h"
+#include "inc/usb_cdc.h"
+#include "tests/check.h"
+
+// Telemetria e registro de eventos dividindo a FIFO da USB CDC simulada, pequena e lida devagar, como
+// as tarefas do firmware: o fluxo gravado precisa ser só blocos e quadros inteiros, um depois do
+// outro, cada um com o CRC certo, sem um fluxo cortar o outro no meio. Com o canal saturado os dois
+// perdem (e avisam), mas o que chega é inteiro
+
+#define FIELDS 12
+#define PERIOD_MS 20
+#define TICK_MS 10
+#define TICKS 500
+#define EVENTS_PER_TICK 3
+
+static const char *path = "test_usb_streams.bin";
+
+static uint32_t channel_write(const uint8_t *data, uint32_t len) {
+  return usb_cdc_write(data, len);
+}
+
+static const telemetry_config_t config = {1, FIELDS, PERIOD_MS, 5, channel_write, usb_cdc_available};
+
+typedef struct {
+  uint32_t frames, chunks, events, dropped;
+} stream_counts_t;
+
+// Percorre o arquivo: em cada posição começa um bloco ou um quadro inteiro
+static stream_counts_t walk(void) {
+  static uint8_t data[65536];
+  stream_counts_t counts = {0};
+  FILE *f = fopen(path, "rb");
+  size_t len, pos = 0;
+
+  CHECK(f);
+  len = fread(data, 1, sizeof(data), f);
+  fclose(f);
+  CHECK(len < sizeof(data));
+  while (pos < len) {
+    size_t end;
+    CHECK(pos + 5 <= len);
+    CHECK_EQ(data[pos], TRACE_MAGIC0); // O mesmo de TELEMETRY_MAGIC0
+    if (data[pos + 1] == TRACE_MAGIC1) {
+      uint8_t count = data[pos + 2];
+      CHECK(count > 0 && count <= TRACE_CHUNK_RECORDS);
+      end = pos + TRACE_HEADER_LEN + count * 6u;
+      for (size_t r = pos + TRACE_HEADER_LEN; r < end; r += 6) {
+        if (data[r + 2] == TRACE_DROPPED)
+          counts.dropped += (uint16_t)(data[r + 4] | data[r + 5] << 8);
+        else if (data[r + 2] == TRACE_SCALED)
+          ++counts.events;
+      }
+      ++counts.chunks;
+    } else {
+      CHECK_EQ(data[pos + 1], TELEMETRY_MAGIC1);
+      end = pos + 5 + data[pos + 4];
+      ++counts.frames;
+    }
+    CHECK(end + 2 <= len);
+    CHECK_EQ(telemetry_crc(&data[pos + 1], end - pos - 1), data[end] | data[end + 1] << 8);
+    pos = end + 2;
+  }
+  return counts;
+}
+
+int main(void) {
+  static telemetry_t t;
+  int16_t values[FIELDS];
+  uint32_t emitted = 0;
+
+  CHECK(sim_usb_open(path));
+  sim_usb_set_fifo_size(64);
+  sim_usb_set_rate(3); // 30 bytes por tick: menos que os dois fluxos juntos, os anéis enchem
+  trace_init();
+  telemetry_init(&t, &config, to_ms_since_boot(get_absolute_time()));
+
+  for (uint32_t k = 0; k < TICKS; ++k) {
+    sleep_ms(TICK_MS);
+    for (uint i = 0; i < EVENTS_PER_TICK; ++i)
+      trace_emit(TRACE_SCALED, 0, (int16_t)emitted++);
+    for (uint i = 0; i < FIELDS; ++i)
+      values[i] = (int16_t)(k / (i + 1));
+    telemetry_sample(&t, values, to_ms_since_boot(get_absolute_time()));
+    // As duas ordens em que as tarefas podem rodar no mesmo tick
+    if (k % 2) {
+      telemetry_flush(&t);
+      trace_drain();
+    } else {
+      trace_drain();
+      telemetry_flush(&t);
+    }
+  }
+
+  // O computador acelera: o que sobrou nos anéis sai
+  sim_usb_set_rate(640);
+  trace_emit(TRACE_SCALED, 0, (int16_t)emitted++); // Leva o aviso de perda pendente
+  for (uint i = 0; i < 100; ++i) {
+    sleep_ms(TICK_MS);
+    telemetry_flush(&t);
+    trace_drain();
+  }
+  CHECK_EQ(t.head, t.tail);
+  sim_usb_report(stdout);
+
+  stream_counts_t counts = walk();
+  CHECK_EQ(counts.frames, t.frames);
+  CHECK_EQ(counts.events + counts.dropped, emitted);
+  CHECK(counts.chunks > 0 && counts.frames > 0);
+  printf("%u quadros (%u descartados), %u blocos com %u eventos (%u perdidos)\n", counts.frames,
+         t.dropped, counts.chunks, counts.events, counts.dropped);
+  remove(path);
+  return 0;
+}
@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+# Gera um header C com os sprites do display já empacotados por páginas (1 bit por pixel).
+# Uso: gen_sprites.py <sprites.txt> <saida.h>
+#
+# Cada byte gerado é uma coluna de 8 linhas (bit 0 em cima), no mesmo formato do ram_buffer
+# do SSD1306, então o desenho é copiado para o display com uma única chamada a ssd1306_blit.
+
+import sys
+
+
+def parse(path):
+    sprites = []
+    name, rows = None, []
+    with open(path, encoding="utf-8") as f:
+        for number, raw in enumerate(f, 1):
+            line = raw.strip()
+            if not line or line.startswith("#") and name is None:
+                continue
+            if name is None:
+                keyword, _, sprite = line.partition(" ")
+                if keyword != "sprite" or not sprite.isidentifier():
+                    sys.exit(f"{path}:{number}: esperado 'sprite <nome>'")
+                name, rows = sprite, []
+            elif line == "end":
+                if not rows or any(len(r) != len(rows[0]) for r in rows):
+                    sys.exit(f"{path}:{number}: sprite '{name}' vazio ou com linhas de larguras diferentes")
+                sprites.append((name, rows))
+                name = None
+            else:
+                if set(line) - {"#", "."}:
+                    sys.exit(f"{path}:{number}: use apenas '#' e '.' no desenho")
+                rows.append(line)
+    if name is not None:
+        sys.exit(f"{path}: sprite '{name}' sem 'end'")
+    return sprites
+
+
+def pack(rows):
+    width, height = len(rows[0]), len(rows)
+    data = []
+    for page in range((height + 7) // 8):
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and rows[y][x] == "#":
+                    byte |= 1 << bit
+            data.append(byte)
+    return width, height, data
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("uso: gen_sprites.py <sprites.txt> <saida.h>")
+    sprites = parse(sys.argv[1])
+
+    out = [
+        "// Arquivo gerado por tools/gen_sprites.py a partir de sprites.txt - não edite",
+        "#pragma once",
+        "",
+        '#include "inc/sprite.h"',
+        "",
+    ]
+    for name, rows in sprites:
+        width, height, data = pack(rows)
+        out.append(f"static const uint8_t {name}_data[] = {{")
+        for i in range(0, len(data), width):
+            out.append("  " + ", ".join(f"0x{b:02x}" for b in data[i:i + width]) + ",")
+        out.append("};")
+        out.append(f"static const sprite_t {name} = {{ {width}, {height}, {name}_data }};")
+        out.append("")
+
+    with open(sys.argv[2], "w", encoding="utf-8") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+# Decodifica a telemetria binária do firmware (inc/telemetry.h) e mostra o estado de cada quadro.
+# Uso: telemetry_parse.py [--json] [arquivo]   (sem arquivo lê da entrada padrão)
+#
+# Exemplos:
+#   stty -F /dev/ttyACM0 raw && telemetry_parse.py /dev/ttyACM0
+#   mkfifo usb.fifo && telemetry_parse.py usb.fifo &
+#   build-sim/Projeto_Controle_Ambiente_sim -s sim/scenarios/demo.txt -u usb.fifo -q
+#
+# Quadro: A5 'M' schema seq len | flags time_ms(4) mask(2) valores(int16 por bit de mask) | crc(2).
+# Bytes fora dos quadros (texto, registro de eventos) e quadros com CRC errado são pulados. Os
+# quadros de diferença só trazem os campos que mudaram; o estado só é mostrado depois de um quadro
+# completo e volta a ser incompleto quando um número de sequência é pulado.
+
+import json
+import struct
+import sys
+
+MAGIC = b"\xa5M"
+HEADER_LEN = 5  # magic, schema, seq, len
+FIXED = struct.Struct("<BIH")  # flags, time_ms, mask
+FLAG_KEYFRAME = 0x01
+
+# Campos de cada versão do esquema, na ordem dos bits de mask (TM_* no firmware)
+SCHEMAS = {
+    1: ["screen", "temperature", "humidity", "y_raw", "x_raw", "fan", "humidifier", "low_water",
+        "fan_low", "fan_medium", "fan_high", "humidifier_on"],
+}
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+class Parser:
+    def __init__(self):
+        self.buffer = b""
+        self.state = None  # Campos conhecidos; None até o primeiro quadro completo
+        self.schema = None
+        self.seq = None
+        self.frames = 0
+        self.crc_errors = 0
+        self.lost = 0
+
+    def feed(self, data):
+        """Acrescenta bytes e retorna os quadros completos decodificados."""
+        self.buffer += data
+        records = []
+        while True:
+            start = self.buffer.find(MAGIC)
+            if start < 0:
+                self.buffer = self.buffer[-1:]  # Pode ser o começo de um magic cortado
+                return records
+            if start + HEADER_LEN > len(self.buffer):
+                self.buffer = self.buffer[start:]
+                return records
+            schema, seq, length = self.buffer[start + 2], self.buffer[start + 3], self.buffer[start + 4]
+            end = start + HEADER_LEN + length + 2
+            if end > len(self.buffer):
+                self.buffer = self.buffer[start:]
+                return records
+            frame = self.buffer[start:end]
+            crc = struct.unpack_from("<H", frame, len(frame) - 2)[0]
+            if length < FIXED.size or crc16(frame[1:-2]) != crc:
+                # Magic falso (bytes de outro fluxo) ou quadro corrompido: procura do byte seguinte
+                self.crc_errors += 1
+                self.buffer = self.buffer[start + 1:]
+                continue
+            self.buffer = self.buffer[end:]
+            record = self.decode(schema, seq, frame[HEADER_LEN:-2])
+            if record:
+                records.append(record)
+
+    def decode(self, schema, seq, payload):
+        fields = SCHEMAS.get(schema)
+        if fields is None:
+            sys.stderr.write(f"esquema {schema} desconhecido\n")
+            return None
+        flags, time_ms, mask = FIXED.unpack_from(payload)
+        values = {}
+        offset = FIXED.size
+        for bit, name in enumerate(fields):
+            if mask & (1 << bit):
+                if offset + 2 > len(payload):
+                    return None
+                values[name] = struct.unpack_from("<h", payload, offset)[0]
+                offset += 2
+
+        if self.seq is not None and seq != (self.seq + 1) & 0xFF:
+            self.lost += (seq - self.seq - 1) & 0xFF
+            self.state = None  # Uma diferença foi perdida: espera o próximo quadro completo
+        if schema != self.schema:
+            self.state = None
+        self.seq, self.schema = seq, schema
+        self.frames += 1
+
+        if flags & FLAG_KEYFRAME:
+            self.state = {}
+        if self.state is None:
+            return None
+        self.state.update(values)
+        return {"time_ms": time_ms, "seq": seq, "keyframe": bool(flags & FLAG_KEYFRAME),
+                "changed": sorted(values, key=fields.index), "state": dict(self.state)}
+
+
+def main():
+    args = sys.argv[1:]
+    as_json = "--json" in args
+    args = [a for a in args if a != "--json"]
+    if len(args) > 1:
+        sys.exit("uso: telemetry_parse.py [--json] [arquivo]")
+    source = open(args[0], "rb", buffering=0) if args else sys.stdin.buffer
+
+    parser = Parser()
+    # Lê aos poucos para acompanhar a porta serial enquanto o firmware roda
+    while True:
+        block = source.read(4096)
+        if not block:
+            break
+        for record in parser.feed(block):
+            if as_json:
+                print(json.dumps(record))
+            else:
+                state = " ".join(f"{k}={v}" for k, v in record["state"].items())
+                kind = "K" if record["keyframe"] else "D"
+                print(f"{record['time_ms'] / 1000:10.3f} #{record['seq']:3d} {kind} {state}")
+        sys.stdout.flush()
+    sys.stderr.write(f"{parser.frames} quadros, {parser.lost} perdidos, {parser.crc_errors} descartados pelo CRC\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+# Converte em texto o registro binário de eventos enviado pela USB (inc/trace.h).
+# Uso: trace_decode.py [arquivo]   (sem arquivo lê da entrada padrão)
+#
+# Exemplos:
+#   stty -F /dev/ttyACM0 raw && trace_decode.py /dev/ttyACM0
+#   build-sim/Projeto_Controle_Ambiente_sim -s sim/scenarios/demo.txt -u usb.bin && trace_decode.py usb.bin
+#
+# O fluxo é uma sequência de blocos "A5 'T' count base_us(4)" seguidos de count registros de 6 bytes
+# (delta_us(2) evento(1) arg(1) value(2), little-endian) e do CRC-16 da telemetria, do 'T' até o
+# último registro. Bytes fora dos blocos (texto do printf, quadros de telemetria) e blocos com CRC
+# errado são pulados, e cada bloco traz o tempo absoluto, então a leitura pode começar a qualquer
+# momento.
+
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from telemetry_parse import crc16  # noqa: E402
+
+MAGIC = b"\xa5T"
+HEADER = struct.Struct("<2sBI")
+RECORD = struct.Struct("<HBBh")
+CRC = struct.Struct("<H")
+CHUNK_RECORDS = 16  # TRACE_CHUNK_RECORDS
+
+# Mesma ordem de trace_event_t
+TIME, DROPPED, EDGE, BUTTON, SCREEN, SCALED, LEVEL, LOW_WATER, CALIBRATION = range(9)
+
+BUTTONS = ["joystick", "A", "B"]
+BUTTON_TYPES = ["press", "release", "long", "double"]
+AXES = ["temperatura", "umidade"]
+ACTUATORS = ["ventilador", "umidificador"]
+CALIBRATOR_EVENTS = ["none", "prompt", "done", "aborted", "retry"]
+
+
+def name(table, index):
+    return table[index] if 0 <= index < len(table) else str(index)
+
+
+def describe(event, arg, value):
+    if event == DROPPED:
+        return f"perdidos {value} registros (anel cheio)"
+    if event == EDGE:
+        state = "desce" if value & 1 else "sobe"
+        accepted = "aceita" if value & 2 else "descartada pelo debounce"
+        return f"borda botão {name(BUTTONS, arg)} {state} ({accepted})"
+    if event == BUTTON:
+        count = (value >> 8) & 0xFF
+        return f"botão {name(BUTTONS, arg)} {name(BUTTON_TYPES, value & 0xFF)}" + (f" x{count}" if count > 1 else "")
+    if event == SCREEN:
+        return f"tela {value}"
+    if event == SCALED:
+        return f"{name(AXES, arg)} {value}"
+    if event == LEVEL:
+        return f"{name(ACTUATORS, arg)} nível {value}"
+    if event == LOW_WATER:
+        return "pouca água " + ("ligado" if value else "desligado")
+    if event == CALIBRATION:
+        return f"calibração passo {arg} {name(CALIBRATOR_EVENTS, value)}"
+    return f"evento {event} arg {arg} valor {value}"
+
+
+class Decoder:
+    def __init__(self):
+        self.buffer = b""
+        self.chunks = 0
+        self.crc_errors = 0
+
+    def feed(self, data):
+        """Acrescenta bytes e retorna os eventos (tempo_us, evento, arg, valor) dos blocos completos."""
+        self.buffer += data
+        events = []
+        while True:
+            start = self.buffer.find(MAGIC)
+            if start < 0:
+                self.buffer = self.buffer[-1:]  # Pode ser o começo de um magic cortado
+                return events
+            if start + HEADER.size > len(self.buffer):
+                self.buffer = self.buffer[start:]
+                return events
+            _, count, now = HEADER.unpack_from(self.buffer, start)
+            end = start + HEADER.size + count * RECORD.size
+            valid = 0 < count <= CHUNK_RECORDS
+            if valid and end + CRC.size > len(self.buffer):
+                self.buffer = self.buffer[start:]  # Bloco incompleto: espera o resto
+                return events
+            if not valid or crc16(self.buffer[start + 1:end]) != CRC.unpack_from(self.buffer, end)[0]:
+                # Magic falso (bytes de outro fluxo) ou bloco corrompido: procura do byte seguinte
+                self.crc_errors += 1
+                self.buffer = self.buffer[start + 1:]
+                continue
+            for offset in range(start + HEADER.size, end, RECORD.size):
+                delta, event, arg, value = RECORD.unpack_from(self.buffer, offset)
+                if event == TIME:
+                    now += (value & 0xFFFF) << 16
+                    continue
+                now += delta
+                events.append((now, event, arg, value))
+            self.buffer = self.buffer[end + CRC.size:]
+            self.chunks += 1
+
+
+def main():
+    if len(sys.argv) > 2:
+        sys.exit("uso: trace_decode.py [arquivo]")
+    source = open(sys.argv[1], "rb", buffering=0) if len(sys.argv) == 2 else sys.stdin.buffer
+    decoder = Decoder()
+    # Lê aos poucos para acompanhar a porta serial enquanto o firmware roda
+    while True:
+        block = source.read(4096)
+        if not block:
+            break
+        for now, event, arg, value in decoder.feed(block):
+            print(f"{now / 1e6:12.6f} {describe(event, arg, value)}")
+        sys.stdout.flush()
+    sys.stderr.write(f"{decoder.chunks} blocos, {decoder.crc_errors} descartados pelo CRC\n")
+
+
+if __name__ == "__main__":
+    main()